@@ -454,6 +454,33 @@ bool CmdLineParser::ParseFromArgs(int argc, const char* const argv[])
                 AddFilesToList(12 + argv[i], _pathnames);
             }
 
+            // order in which files are checked by several jobs
+            else if (std::strncmp(argv[i], "--file-order=", 13) == 0) {
+                const std::string order(argv[i] + 13);
+                if (order == "cost")
+                    _settings->orderFilesByCost = true;
+                else if (order == "name")
+                    _settings->orderFilesByCost = false;
+                else {
+                    PrintMessage("cppcheck: unknown --file-order '" + order + "'. Valid values are 'cost' and 'name'.");
+                    return false;
+                }
+            }
+
+            // threads that check the functions of a file
+            else if (std::strncmp(argv[i], "--function-jobs=", 16) == 0) {
+                std::istringstream iss(16+argv[i]);
+                if (!(iss >> _settings->functionJobs)) {
+                    PrintMessage("cppcheck: argument to '--function-jobs=' is not a number.");
+                    return false;
+                }
+
+                if (_settings->functionJobs < 1 || _settings->functionJobs > 10000) {
+                    PrintMessage("cppcheck: argument to '--function-jobs=' must be between 1 and 10000.");
+                    return false;
+                }
+            }
+
             // Ignored paths
             else if (std::strncmp(argv[i], "-i", 2) == 0) {
                 std::string path;
@@ -631,12 +658,18 @@ bool CmdLineParser::ParseFromArgs(int argc, const char* const argv[])
                     _settings->showtime = SHOWTIME_SUMMARY;
                 else if (showtimeMode == "top5")
                     _settings->showtime = SHOWTIME_TOP5;
-                else if (showtimeMode.empty())
+                else if (showtimeMode.compare(0, 5, "json:") == 0 && showtimeMode.size() > 5) {
+                    _settings->showtime = SHOWTIME_JSON;
+                    _settings->showtimeFile = showtimeMode.substr(5);
+                } else if (showtimeMode == "json" || showtimeMode == "json:") {
+                    PrintMessage("cppcheck: error: no file name given for '--showtime=json:<file>'.");
+                    return false;
+                } else if (showtimeMode.empty())
                     _settings->showtime = SHOWTIME_NONE;
                 else {
                     std::string message("cppcheck: error: unrecognized showtime mode: \"");
                     message += showtimeMode;
-                    message += "\". Supported modes: file, summary, top5.";
+                    message += "\". Supported modes: file, summary, top5, json:<file>.";
                     PrintMessage(message);
                     return false;
                 }
@@ -734,6 +767,27 @@ bool CmdLineParser::ParseFromArgs(int argc, const char* const argv[])
                 maxconfigs = true;
             }
 
+            // Set maximum number of ValueFlow values for a token
+            else if (std::strncmp(argv[i], "--max-valueflow-values=", 23) == 0) {
+                // read a signed number, a negative number would wrap around
+                std::istringstream iss(23+argv[i]);
+                int maxValues = 0;
+                if (!(iss >> maxValues)) {
+                    PrintMessage("cppcheck: argument to '--max-valueflow-values=' is not a number.");
+                    return false;
+                }
+
+                if (maxValues < 1) {
+                    PrintMessage("cppcheck: argument to '--max-valueflow-values=' must be greater than 0.");
+                    return false;
+                }
+                _settings->valueFlowMaxValues = maxValues;
+            }
+
+            // Skip the simplified token list and the checks that use it
+            else if (std::strcmp(argv[i], "--no-simplified-checks") == 0)
+                _settings->simplifiedChecks = false;
+
             // Print help
             else if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0) {
                 _pathnames.clear();
@@ -807,6 +861,9 @@ void CmdLineParser::PrintHelp()
               "                         Analysis output directory. Useful for various data.\n"
               "                         Some possible usages are; whole program analysis,\n"
               "                         incremental analysis, distributed analysis.\n"
+              "                         Files are not analyzed again when they, the files\n"
+              "                         they include and the directories that are searched\n"
+              "                         for included files are unchanged.\n"
               "    --check-config       Check cppcheck configuration. The normal code\n"
               "                         analysis is disabled by this flag.\n"
               "    --check-library      Show information messages when library files have\n"
@@ -869,9 +926,27 @@ void CmdLineParser::PrintHelp()
               "    --file-list=<file>   Specify the files to check in a text file. Add one\n"
               "                         filename per line. When file is '-,' the file list will\n"
               "                         be read from standard input.\n"
+              "    --file-order=<order>\n"
+              "                         Order in which files are checked when several jobs are\n"
+              "                         used. The available orders are:\n"
+              "                          * cost\n"
+              "                                 Files that are expected to take the longest time\n"
+              "                                 are checked first, to avoid that a single large\n"
+              "                                 file is checked at the end. The expected time is\n"
+              "                                 taken from earlier runs when --cppcheck-build-dir\n"
+              "                                 is used and otherwise from the file size. This is\n"
+              "                                 the default.\n"
+              "                          * name\n"
+              "                                 Files are checked in alphabetical order.\n"
               "    -f, --force          Force checking of all configurations in files. If used\n"
               "                         together with '--max-configs=', the last option is the\n"
               "                         one that is effective.\n"
+              "    --function-jobs=<jobs>\n"
+              "                         Start <jobs> threads that check the functions of a file\n"
+              "                         simultaneously. This is useful when a few very large\n"
+              "                         files are checked. Only some of the checks are split\n"
+              "                         up by function. The output is the same as with one\n"
+              "                         thread.\n"
               "    -h, --help           Print this help.\n"
               "    -I <dir>             Give path to search for include files. Give several -I\n"
               "                         parameters to give several paths. First given path is\n"
@@ -902,7 +977,10 @@ void CmdLineParser::PrintHelp()
               "                         more comments, like: '// cppcheck-suppress warningId'\n"
               "                         on the lines before the warning to suppress.\n"
               "    -j <jobs>            Start <jobs> threads to do the checking simultaneously.\n"
-#ifdef THREADING_MODEL_FORK
+              "                         The threads run in the cppcheck process, so a crash\n"
+              "                         while checking one file stops the whole run. Use\n"
+              "                         --exception-handling to see which file was checked.\n"
+#ifndef _WIN32
               "    -l <load>            Specifies that no new threads should be started if\n"
               "                         there are other threads running and the load average is\n"
               "                         at least <load>.\n"
@@ -929,6 +1007,16 @@ void CmdLineParser::PrintHelp()
               "                         before skipping it. Default is '12'. If used together\n"
               "                         with '--force', the last option is the one that is\n"
               "                         effective.\n"
+              "    --max-valueflow-values=<limit>\n"
+              "                         Maximum number of ValueFlow values for a token. More\n"
+              "                         values are dropped, that is faster but can hide bugs.\n"
+              "                         Default is '10'.\n"
+              "    --no-simplified-checks\n"
+              "                         Only run the checks that use the normal token list.\n"
+              "                         The simplified token list is not created, which is\n"
+              "                         faster, but the checks that still need it are\n"
+              "                         skipped (memory leaks, buffer overruns, uninitialized\n"
+              "                         and auto variables, among others).\n"
               "    --platform=<type>, --platform=<file>\n"
               "                         Specifies platform specific types and sizes. The\n"
               "                         available builtin platforms are:\n"
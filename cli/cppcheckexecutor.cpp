@@ -287,8 +287,7 @@ static void print_stacktrace(FILE* output, bool demangling, int maxdepth, bool l
 #endif
 }
 
-static const size_t MYSTACKSIZE = 16*1024+SIGSTKSZ; // wild guess about a reasonable buffer
-static char mytstack[MYSTACKSIZE]= {0}; // alternative stack for signal handler
+static std::vector<char> mytstack; // alternative stack for signal handler, allocated in check_wrapper() since SIGSTKSZ is not a constant in all C libraries
 static bool bStackBelowHeap=false; // lame attempt to locate heap vs. stack address space. See CppCheckExecutor::check_wrapper()
 
 /*
@@ -502,6 +501,12 @@ static void CppcheckSignalHandler(int signo, siginfo_t * info, void * context)
         fputs(".\n", output);
         break;
     }
+    const char * const checkedFile = ThreadExecutor::checkedFile();
+    if (checkedFile) {
+        fputs("The signal was received while checking ", output);
+        fputs(checkedFile, output);
+        fputs(".\n", output);
+    }
     if (printCallstack) {
         print_stacktrace(output, true, -1, lowMem);
     }
@@ -769,10 +774,11 @@ int CppCheckExecutor::check_wrapper(CppCheck& cppcheck, int argc, const char* co
     free(heapVariable);
 
     // set up alternative stack for signal handler
+    mytstack.resize(16*1024+SIGSTKSZ); // wild guess about a reasonable buffer
     stack_t segv_stack;
-    segv_stack.ss_sp = mytstack;
+    segv_stack.ss_sp = mytstack.data();
     segv_stack.ss_flags = 0;
-    segv_stack.ss_size = MYSTACKSIZE;
+    segv_stack.ss_size = mytstack.size();
     sigaltstack(&segv_stack, nullptr);
 
     // install signal handler
@@ -840,6 +846,10 @@ int CppCheckExecutor::check_internal(CppCheck& cppcheck, int /*argc*/, const cha
         AnalyzerInformation::writeFilesTxt(settings.buildDir, fileNames, settings.project.fileSettings);
     }
 
+    // Share lexed headers between all checked files and worker threads
+    simplecpp::FileCache fileCache;
+    Preprocessor::fileCache = &fileCache;
+
     unsigned int returnValue = 0;
     if (settings.jobs == 1) {
         // Single process
@@ -892,6 +902,8 @@ int CppCheckExecutor::check_internal(CppCheck& cppcheck, int /*argc*/, const cha
         returnValue = executor.check();
     }
 
+    Preprocessor::fileCache = nullptr;
+
     cppcheck.analyseWholeProgram(_settings->buildDir, _files);
 
     if (settings.isEnabled(Settings::INFORMATION) || settings.checkConfiguration) {
@@ -930,6 +942,9 @@ int CppCheckExecutor::check_internal(CppCheck& cppcheck, int /*argc*/, const cha
         reportErr(ErrorLogger::ErrorMessage::getXMLFooter());
     }
 
+    if (!CppCheck::showTimerResults(settings.showtime, settings.showtimeFile))
+        std::cerr << "cppcheck: error: could not write the timer results to '" << settings.showtimeFile << "'." << std::endl;
+
     _settings = nullptr;
     if (returnValue)
         return settings.exitCode;
@@ -18,6 +18,7 @@
 
 #include "threadexecutor.h"
 
+#include "analyzerinfo.h"
 #include "config.h"
 #include "cppcheck.h"
 #include "cppcheckexecutor.h"
@@ -26,131 +27,45 @@
 #include "suppressions.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cstdlib>
-#include <cstring>
-#include <iostream>
+#include <fstream>
+#include <memory>
+#include <thread>
 #include <utility>
 
 #ifdef __SVR4  // Solaris
 #include <sys/loadavg.h>
 #endif
-#ifdef THREADING_MODEL_FORK
-#include <sys/select.h>
-#include <sys/wait.h>
-#include <errno.h>
-#include <fcntl.h>
-#include <unistd.h>
+#if !defined(_WIN32) && !defined(__CYGWIN__) && !defined(__QNX__)
+#include <stdlib.h>
+#define HAVE_GETLOADAVG
 #endif
-#ifdef THREADING_MODEL_WIN
-#include <errno.h>
-#include <process.h>
-#include <windows.h>
-#endif
-
-// required for FD_ZERO
-using std::memset;
 
 ThreadExecutor::ThreadExecutor(const std::map<std::string, std::size_t> &files, Settings &settings, ErrorLogger &errorLogger)
-    : _files(files), _settings(settings), _errorLogger(errorLogger), _fileCount(0)
-      // Not initialized _fileSync, _errorSync, _reportSync
+    : _files(files), _settings(settings), _errorLogger(errorLogger), _fileCount(0), _totalFileSize(0), _processedSize(0), _result(0), _nextJob(0), _runningJobs(0), _messages(nullptr)
 {
-#if defined(THREADING_MODEL_FORK)
-    _wpipe = 0;
-#elif defined(THREADING_MODEL_WIN)
-    _processedFiles = 0;
-    _totalFiles = 0;
-    _processedSize = 0;
-    _totalFileSize = 0;
-#endif
 }
 
 ThreadExecutor::~ThreadExecutor()
 {
-    //dtor
+    Message *message = takeMessages();
+    while (message) {
+        Message *next = message->next;
+        delete message;
+        message = next;
+    }
 }
 
-
-///////////////////////////////////////////////////////////////////////////////
-////// This code is for platforms that support fork() only ////////////////////
-///////////////////////////////////////////////////////////////////////////////
-
-#if defined(THREADING_MODEL_FORK)
-
 void ThreadExecutor::addFileContent(const std::string &path, const std::string &content)
 {
-    _fileContents[ path ] = content;
-}
-
-int ThreadExecutor::handleRead(int rpipe, unsigned int &result)
-{
-    char type = 0;
-    if (read(rpipe, &type, 1) <= 0) {
-        if (errno == EAGAIN)
-            return 0;
-
-        return -1;
-    }
-
-    if (type != REPORT_OUT && type != REPORT_ERROR && type != REPORT_INFO && type != CHILD_END) {
-        std::cerr << "#### You found a bug from cppcheck.\nThreadExecutor::handleRead error, type was:" << type << std::endl;
-        std::exit(0);
-    }
-
-    unsigned int len = 0;
-    if (read(rpipe, &len, sizeof(len)) <= 0) {
-        std::cerr << "#### You found a bug from cppcheck.\nThreadExecutor::handleRead error, type was:" << type << std::endl;
-        std::exit(0);
-    }
-
-    char *buf = new char[len];
-    if (read(rpipe, buf, len) <= 0) {
-        std::cerr << "#### You found a bug from cppcheck.\nThreadExecutor::handleRead error, type was:" << type << std::endl;
-        std::exit(0);
-    }
-
-    if (type == REPORT_OUT) {
-        _errorLogger.reportOut(buf);
-    } else if (type == REPORT_ERROR || type == REPORT_INFO) {
-        ErrorLogger::ErrorMessage msg;
-        msg.deserialize(buf);
-
-        std::string file;
-        unsigned int line(0);
-        if (!msg._callStack.empty()) {
-            file = msg._callStack.back().getfile(false);
-            line = msg._callStack.back().line;
-        }
-
-        if (!_settings.nomsg.isSuppressed(msg._id, file, line)) {
-            // Alert only about unique errors
-            std::string errmsg = msg.toString(_settings.verbose);
-            if (std::find(_errorList.begin(), _errorList.end(), errmsg) == _errorList.end()) {
-                _errorList.push_back(errmsg);
-                if (type == REPORT_ERROR)
-                    _errorLogger.reportErr(msg);
-                else
-                    _errorLogger.reportInfo(msg);
-            }
-        }
-    } else if (type == CHILD_END) {
-        std::istringstream iss(buf);
-        unsigned int fileResult = 0;
-        iss >> fileResult;
-        result += fileResult;
-        delete [] buf;
-        return -1;
-    }
-
-    delete [] buf;
-    return 1;
+    _fileContents[path] = content;
 }
 
-bool ThreadExecutor::checkLoadAverage(size_t nchildren)
+bool ThreadExecutor::checkLoadAverage(std::size_t nrunning) const
 {
-#if defined(__CYGWIN__) || defined(__QNX__)  // getloadavg() is unsupported on Cygwin, Qnx.
-    return true;
-#else
-    if (!nchildren || !_settings.loadAverage) {
+#ifdef HAVE_GETLOADAVG
+    if (!nrunning || !_settings.loadAverage) {
         return true;
     }
 
@@ -162,404 +77,276 @@ bool ThreadExecutor::checkLoadAverage(size_t nchildren)
         return true;
     }
     return false;
+#else
+    (void)nrunning;
+    return true;
 #endif
 }
 
 unsigned int ThreadExecutor::check()
 {
     _fileCount = 0;
-    unsigned int result = 0;
+    _processedSize = 0;
+    _totalFileSize = 0;
+    _result = 0;
 
-    std::size_t totalfilesize = 0;
+    _jobs.clear();
     for (std::map<std::string, std::size_t>::const_iterator i = _files.begin(); i != _files.end(); ++i) {
-        totalfilesize += i->second;
+        _totalFileSize += i->second;
+        _jobs.push_back(Job(i->first, i->second));
     }
+    for (std::list<ImportProject::FileSettings>::const_iterator fs = _settings.project.fileSettings.begin(); fs != _settings.project.fileSettings.end(); ++fs)
+        _jobs.push_back(Job(&*fs));
+    if (_settings.orderFilesByCost)
+        sortJobsByCost();
+    _nextJob = 0;
+    _runningJobs = 0;
+    _timings.clear();
+
+    // The workers only read the settings, the suppressions that are used in this thread are copied
+    _nomsg = _settings.nomsg;
+
+    const std::size_t nworkers = std::max<std::size_t>(1U, std::min<std::size_t>(_settings.jobs, _jobs.size()));
+    std::vector<std::thread> workers;
+    for (std::size_t i = 0; i < nworkers; ++i)
+        workers.push_back(std::thread(&ThreadExecutor::worker, this));
 
-    std::list<int> rpipes;
-    std::map<pid_t, std::string> childFile;
-    std::map<int, std::string> pipeFile;
-    std::size_t processedsize = 0;
-    std::map<std::string, std::size_t>::const_iterator iFile = _files.begin();
-    std::list<ImportProject::FileSettings>::const_iterator iFileSettings = _settings.project.fileSettings.begin();
     for (;;) {
-        // Start a new child
-        size_t nchildren = rpipes.size();
-        if ((iFile != _files.end() || iFileSettings != _settings.project.fileSettings.end()) && nchildren < _settings.jobs && checkLoadAverage(nchildren)) {
-            int pipes[2];
-            if (pipe(pipes) == -1) {
-                std::cerr << "pipe() failed: "<< std::strerror(errno) << std::endl;
-                std::exit(EXIT_FAILURE);
-            }
-
-            int flags = 0;
-            if ((flags = fcntl(pipes[0], F_GETFL, 0)) < 0) {
-                std::cerr << "fcntl(F_GETFL) failed: "<< std::strerror(errno) << std::endl;
-                std::exit(EXIT_FAILURE);
-            }
-
-            if (fcntl(pipes[0], F_SETFL, flags | O_NONBLOCK) < 0) {
-                std::cerr << "fcntl(F_SETFL) failed: "<< std::strerror(errno) << std::endl;
-                std::exit(EXIT_FAILURE);
-            }
-
-            pid_t pid = fork();
-            if (pid < 0) {
-                // Error
-                std::cerr << "Failed to create child process: "<< std::strerror(errno) << std::endl;
-                std::exit(EXIT_FAILURE);
-            } else if (pid == 0) {
-                close(pipes[0]);
-                _wpipe = pipes[1];
-
-                CppCheck fileChecker(*this, false);
-                fileChecker.settings() = _settings;
-                unsigned int resultOfCheck = 0;
-
-                if (iFileSettings != _settings.project.fileSettings.end()) {
-                    resultOfCheck = fileChecker.check(*iFileSettings);
-                } else if (!_fileContents.empty() && _fileContents.find(iFile->first) != _fileContents.end()) {
-                    // File content was given as a string
-                    resultOfCheck = fileChecker.check(iFile->first, _fileContents[ iFile->first ]);
-                } else {
-                    // Read file from a file
-                    resultOfCheck = fileChecker.check(iFile->first);
-                }
-
-                std::ostringstream oss;
-                oss << resultOfCheck;
-                writeToPipe(CHILD_END, oss.str());
-                std::exit(0);
-            }
-
-            close(pipes[1]);
-            rpipes.push_back(pipes[0]);
-            if (iFileSettings != _settings.project.fileSettings.end()) {
-                childFile[pid] = iFileSettings->filename + ' ' + iFileSettings->cfg;
-                pipeFile[pipes[0]] = iFileSettings->filename + ' ' + iFileSettings->cfg;
-                ++iFileSettings;
-            } else {
-                childFile[pid] = iFile->first;
-                pipeFile[pipes[0]] = iFile->first;
-                ++iFile;
-            }
-        } else if (!rpipes.empty()) {
-            fd_set rfds;
-            FD_ZERO(&rfds);
-            for (std::list<int>::const_iterator rp = rpipes.begin(); rp != rpipes.end(); ++rp)
-                FD_SET(*rp, &rfds);
-            struct timeval tv; // for every second polling of load average condition
-            tv.tv_sec = 1;
-            tv.tv_usec = 0;
-            int r = select(*std::max_element(rpipes.begin(), rpipes.end()) + 1, &rfds, nullptr, nullptr, &tv);
-
-            if (r > 0) {
-                std::list<int>::iterator rp = rpipes.begin();
-                while (rp != rpipes.end()) {
-                    if (FD_ISSET(*rp, &rfds)) {
-                        int readRes = handleRead(*rp, result);
-                        if (readRes == -1) {
-                            std::size_t size = 0;
-                            std::map<int, std::string>::iterator p = pipeFile.find(*rp);
-                            if (p != pipeFile.end()) {
-                                std::string name = p->second;
-                                pipeFile.erase(p);
-                                std::map<std::string, std::size_t>::const_iterator fs = _files.find(name);
-                                if (fs != _files.end()) {
-                                    size = fs->second;
-                                }
-                            }
-
-                            _fileCount++;
-                            processedsize += size;
-                            if (!_settings.quiet)
-                                CppCheckExecutor::reportStatus(_fileCount, _files.size() + _settings.project.fileSettings.size(), processedsize, totalfilesize);
-
-                            close(*rp);
-                            rp = rpipes.erase(rp);
-                        } else
-                            ++rp;
-                    } else
-                        ++rp;
-                }
-            }
-
-            int stat = 0;
-            pid_t child = waitpid(0, &stat, WNOHANG);
-            if (child > 0) {
-                std::string childname;
-                std::map<pid_t, std::string>::iterator c = childFile.find(child);
-                if (c != childFile.end()) {
-                    childname = c->second;
-                    childFile.erase(c);
-                }
-
-                if (WIFSIGNALED(stat)) {
-                    std::ostringstream oss;
-                    oss << "Internal error: Child process crashed with signal " << WTERMSIG(stat);
-
-                    std::list<ErrorLogger::ErrorMessage::FileLocation> locations;
-                    locations.push_back(ErrorLogger::ErrorMessage::FileLocation(childname, 0));
-                    const ErrorLogger::ErrorMessage errmsg(locations,
-                                                           emptyString,
-                                                           Severity::error,
-                                                           oss.str(),
-                                                           "cppcheckError",
-                                                           false);
-
-                    if (!_settings.nomsg.isSuppressed(errmsg._id, childname, 0))
-                        _errorLogger.reportErr(errmsg);
-                }
-            }
-        } else {
-            // All done
-            break;
+        // Read the status before taking the messages so no message from a finished worker is lost
+        const bool done = (_fileCount == _jobs.size() || _settings.terminated()) && _runningJobs == 0;
+
+        Message *message = takeMessages();
+        if (!message) {
+            if (done)
+                break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            continue;
+        }
+        while (message) {
+            handleMessage(*message);
+            Message *next = message->next;
+            delete message;
+            message = next;
         }
     }
 
-
-    return result;
-}
-
-void ThreadExecutor::writeToPipe(PipeSignal type, const std::string &data)
-{
-    unsigned int len = static_cast<unsigned int>(data.length() + 1);
-    char *out = new char[ len + 1 + sizeof(len)];
-    out[0] = static_cast<char>(type);
-    std::memcpy(&(out[1]), &len, sizeof(len));
-    std::memcpy(&(out[1+sizeof(len)]), data.c_str(), len);
-    if (write(_wpipe, out, len + 1 + sizeof(len)) <= 0) {
-        delete [] out;
-        out = 0;
-        std::cerr << "#### ThreadExecutor::writeToPipe, Failed to write to pipe" << std::endl;
-        std::exit(0);
+    for (std::vector<std::thread>::iterator worker = workers.begin(); worker != workers.end(); ++worker)
+        worker->join();
+    _settings.nomsg = _nomsg;
+
+    // Messages that were posted after the last check
+    Message *message = takeMessages();
+    while (message) {
+        handleMessage(*message);
+        Message *next = message->next;
+        delete message;
+        message = next;
     }
 
-    delete [] out;
-}
+    if (!_settings.buildDir.empty())
+        AnalyzerInformation::writeTimings(_settings.buildDir, _timings);
 
-void ThreadExecutor::reportOut(const std::string &outmsg)
-{
-    writeToPipe(REPORT_OUT, outmsg);
+    return _result;
 }
 
-void ThreadExecutor::reportErr(const ErrorLogger::ErrorMessage &msg)
+bool ThreadExecutor::moreExpensive(const Job &job1, const Job &job2)
 {
-    writeToPipe(REPORT_ERROR, msg.serialize());
+    return job1.cost > job2.cost;
 }
 
-void ThreadExecutor::reportInfo(const ErrorLogger::ErrorMessage &msg)
+static std::size_t getFileSize(const std::string &filename)
 {
-    writeToPipe(REPORT_INFO, msg.serialize());
+    std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary | std::ios::ate);
+    const std::streamoff size = fin.is_open() ? static_cast<std::streamoff>(fin.tellg()) : 0;
+    return size > 0 ? static_cast<std::size_t>(size) : 0U;
 }
 
-#elif defined(THREADING_MODEL_WIN)
-
-void ThreadExecutor::addFileContent(const std::string &path, const std::string &content)
+void ThreadExecutor::sortJobsByCost()
 {
-    _fileContents[path] = content;
-}
-
-unsigned int ThreadExecutor::check()
-{
-    HANDLE *threadHandles = new HANDLE[_settings.jobs];
-
-    _itNextFile = _files.begin();
-    _itNextFileSettings = _settings.project.fileSettings.begin();
-
-    _processedFiles = 0;
-    _processedSize = 0;
-    _totalFiles = _files.size() + _settings.project.fileSettings.size();
-    _totalFileSize = 0;
-    for (std::map<std::string, std::size_t>::const_iterator i = _files.begin(); i != _files.end(); ++i) {
-        _totalFileSize += i->second;
-    }
-
-    InitializeCriticalSection(&_fileSync);
-    InitializeCriticalSection(&_errorSync);
-    InitializeCriticalSection(&_reportSync);
-
-    for (unsigned int i = 0; i < _settings.jobs; ++i) {
-        threadHandles[i] = (HANDLE)_beginthreadex(nullptr, 0, threadProc, this, 0, nullptr);
-        if (!threadHandles[i]) {
-            std::cerr << "#### .\nThreadExecutor::check error, errno :" << errno << std::endl;
-            exit(EXIT_FAILURE);
-        }
-    }
-
-    DWORD waitResult = WaitForMultipleObjects(_settings.jobs, threadHandles, TRUE, INFINITE);
-    if (waitResult != WAIT_OBJECT_0) {
-        if (waitResult == WAIT_FAILED) {
-            std::cerr << "#### .\nThreadExecutor::check wait failed, result: " << waitResult << " error: " << GetLastError() << std::endl;
-            exit(EXIT_FAILURE);
+    std::map<std::string, double> timings;
+    if (!_settings.buildDir.empty())
+        timings = AnalyzerInformation::readTimings(_settings.buildDir);
+
+    // Relation between check time and file size for the files that have timings.
+    // It is used to estimate the check time of the other files.
+    double knownSeconds = 0;
+    double knownBytes = 0;
+    std::vector<std::size_t> bytes(_jobs.size());
+    for (std::size_t i = 0; i < _jobs.size(); ++i) {
+        Job &job = _jobs[i];
+        bytes[i] = job.fileSettings ? getFileSize(job.filename) : job.fileSize;
+        const std::map<std::string, double>::const_iterator timing = timings.find(job.timingKey());
+        if (timing != timings.end()) {
+            job.cost = timing->second;
+            knownSeconds += timing->second;
+            knownBytes += static_cast<double>(bytes[i]);
         } else {
-            std::cerr << "#### .\nThreadExecutor::check wait failed, result: " << waitResult << std::endl;
-            exit(EXIT_FAILURE);
+            job.cost = -1;
         }
     }
 
-    unsigned int result = 0;
-    for (unsigned int i = 0; i < _settings.jobs; ++i) {
-        DWORD exitCode;
-
-        if (!GetExitCodeThread(threadHandles[i], &exitCode)) {
-            std::cerr << "#### .\nThreadExecutor::check get exit code failed, error:" << GetLastError() << std::endl;
-            exit(EXIT_FAILURE);
-        }
-
-        result += exitCode;
-
-        if (!CloseHandle(threadHandles[i])) {
-            std::cerr << "#### .\nThreadExecutor::check close handle failed, error:" << GetLastError() << std::endl;
-            exit(EXIT_FAILURE);
-        }
+    const double secondsPerByte = (knownSeconds > 0 && knownBytes > 0) ? (knownSeconds / knownBytes) : 1.0;
+    for (std::size_t i = 0; i < _jobs.size(); ++i) {
+        if (_jobs[i].cost < 0)
+            _jobs[i].cost = static_cast<double>(bytes[i]) * secondsPerByte;
     }
 
-    DeleteCriticalSection(&_fileSync);
-    DeleteCriticalSection(&_errorSync);
-    DeleteCriticalSection(&_reportSync);
+    std::stable_sort(_jobs.begin(), _jobs.end(), moreExpensive);
+}
 
-    delete[] threadHandles;
+/** File that is checked by the current thread, see ThreadExecutor::checkedFile() */
+static thread_local const char *checkedFileName = nullptr;
 
-    return result;
+const char *ThreadExecutor::checkedFile()
+{
+    return checkedFileName;
 }
 
-unsigned int __stdcall ThreadExecutor::threadProc(void *args)
+unsigned int ThreadExecutor::checkJob(CppCheck &fileChecker, const Job &job) const
 {
-    unsigned int result = 0;
+    if (job.fileSettings)
+        return fileChecker.check(*job.fileSettings);
+
+    const std::map<std::string, std::string>::const_iterator fileContent = _fileContents.find(job.filename);
+    if (fileContent != _fileContents.end()) {
+        // File content was given as a string
+        return fileChecker.check(job.filename, fileContent->second);
+    }
 
-    ThreadExecutor *threadExecutor = static_cast<ThreadExecutor*>(args);
-    std::map<std::string, std::size_t>::const_iterator &itFile = threadExecutor->_itNextFile;
-    std::list<ImportProject::FileSettings>::const_iterator &itFileSettings = threadExecutor->_itNextFileSettings;
+    // Read file from a file
+    return fileChecker.check(job.filename);
+}
 
-    // guard static members of CppCheck against concurrent access
-    EnterCriticalSection(&threadExecutor->_fileSync);
+void ThreadExecutor::reportException(const Job &job, const std::string &what)
+{
+    std::list<ErrorLogger::ErrorMessage::FileLocation> locations;
+    locations.push_back(ErrorLogger::ErrorMessage::FileLocation(job.filename, 0));
+    const ErrorLogger::ErrorMessage errmsg(locations,
+                                           emptyString,
+                                           Severity::error,
+                                           "Internal error: Exception thrown while checking the file: " + what,
+                                           "cppcheckError",
+                                           false);
+    reportErr(errmsg);
+}
 
-    CppCheck fileChecker(*threadExecutor, false);
-    fileChecker.settings() = threadExecutor->_settings;
+void ThreadExecutor::worker()
+{
+    std::unique_ptr<CppCheck> fileChecker(new CppCheck(*this, false, _settings));
 
     for (;;) {
-        if (itFile == threadExecutor->_files.end() && itFileSettings == threadExecutor->_settings.project.fileSettings.end()) {
-            LeaveCriticalSection(&threadExecutor->_fileSync);
+        if (_settings.terminated())
             break;
-        }
 
-        std::size_t fileSize = 0;
-        if (itFile != threadExecutor->_files.end()) {
-            const std::string &file = itFile->first;
-            fileSize = itFile->second;
-            ++itFile;
-
-            LeaveCriticalSection(&threadExecutor->_fileSync);
-
-            std::map<std::string, std::string>::const_iterator fileContent = threadExecutor->_fileContents.find(file);
-            if (fileContent != threadExecutor->_fileContents.end()) {
-                // File content was given as a string
-                result += fileChecker.check(file, fileContent->second);
-            } else {
-                // Read file from a file
-                result += fileChecker.check(file);
-            }
-        } else { // file settings..
-            const ImportProject::FileSettings &fs = *itFileSettings;
-            ++itFileSettings;
-            LeaveCriticalSection(&threadExecutor->_fileSync);
-            result += fileChecker.check(fs);
-        }
+        while (!checkLoadAverage(_runningJobs))
+            std::this_thread::sleep_for(std::chrono::seconds(1));
 
-        EnterCriticalSection(&threadExecutor->_fileSync);
+        ++_runningJobs;
+        const std::size_t index = _nextJob++;
+        if (index >= _jobs.size()) {
+            --_runningJobs;
+            break;
+        }
 
-        threadExecutor->_processedSize += fileSize;
-        threadExecutor->_processedFiles++;
-        if (!threadExecutor->_settings.quiet) {
-            EnterCriticalSection(&threadExecutor->_reportSync);
-            CppCheckExecutor::reportStatus(threadExecutor->_processedFiles, threadExecutor->_totalFiles, threadExecutor->_processedSize, threadExecutor->_totalFileSize);
-            LeaveCriticalSection(&threadExecutor->_reportSync);
+        const Job &job = _jobs[index];
+        Message *done = new Message(FILE_DONE);
+        done->job = &job;
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        checkedFileName = job.filename.c_str();
+        // An exception that is not handled by CppCheck stops checking of this
+        // file only. The state of the interrupted CppCheck instance is unknown,
+        // so a new one is used for the next file.
+        try {
+            done->result = checkJob(*fileChecker, job);
+        } catch (const std::exception &e) {
+            reportException(job, e.what());
+            done->result = 1;
+            fileChecker.reset(new CppCheck(*this, false, _settings));
+        } catch (...) {
+            reportException(job, "unknown exception");
+            done->result = 1;
+            fileChecker.reset(new CppCheck(*this, false, _settings));
         }
+        checkedFileName = nullptr;
+        done->seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        postMessage(done);
+        --_runningJobs;
     }
-    return result;
 }
 
-void ThreadExecutor::reportOut(const std::string &outmsg)
-{
-    EnterCriticalSection(&_reportSync);
-
-    _errorLogger.reportOut(outmsg);
-
-    LeaveCriticalSection(&_reportSync);
-}
-void ThreadExecutor::reportErr(const ErrorLogger::ErrorMessage &msg)
+void ThreadExecutor::postMessage(Message *message)
 {
-    report(msg, REPORT_ERROR);
+    message->next = _messages.load();
+    while (!_messages.compare_exchange_weak(message->next, message))
+        ;
 }
 
-void ThreadExecutor::reportInfo(const ErrorLogger::ErrorMessage &msg)
+ThreadExecutor::Message *ThreadExecutor::takeMessages()
 {
-    report(msg, REPORT_INFO);
+    // The queue is a stack, reverse it to get the messages in the order they were posted
+    Message *message = _messages.exchange(nullptr);
+    Message *ret = nullptr;
+    while (message) {
+        Message *next = message->next;
+        message->next = ret;
+        ret = message;
+        message = next;
+    }
+    return ret;
 }
 
-void ThreadExecutor::report(const ErrorLogger::ErrorMessage &msg, MessageType msgType)
+void ThreadExecutor::handleMessage(const Message &message)
 {
-    std::string file;
-    unsigned int line(0);
-    if (!msg._callStack.empty()) {
-        file = msg._callStack.back().getfile(false);
-        line = msg._callStack.back().line;
-    }
+    if (message.type == REPORT_OUT) {
+        _errorLogger.reportOut(message.outmsg);
+    } else if (message.type == REPORT_ERROR || message.type == REPORT_INFO) {
+        const ErrorLogger::ErrorMessage &msg = message.msg;
 
-    if (_settings.nomsg.isSuppressed(msg._id, file, line))
-        return;
-
-    // Alert only about unique errors
-    bool reportError = false;
-    std::string errmsg = msg.toString(_settings.verbose);
+        std::string file;
+        unsigned int line(0);
+        if (!msg._callStack.empty()) {
+            file = msg._callStack.back().getfile(false);
+            line = msg._callStack.back().line;
+        }
 
-    EnterCriticalSection(&_errorSync);
-    if (std::find(_errorList.begin(), _errorList.end(), errmsg) == _errorList.end()) {
-        _errorList.push_back(errmsg);
-        reportError = true;
-    }
-    LeaveCriticalSection(&_errorSync);
+        if (_nomsg.isSuppressed(msg._id, file, line))
+            return;
 
-    if (reportError) {
-        EnterCriticalSection(&_reportSync);
+        // Alert only about unique errors
+        if (!_errorList.insert(msg, _settings.verbose))
+            return;
 
-        switch (msgType) {
-        case REPORT_ERROR:
+        if (message.type == REPORT_ERROR)
             _errorLogger.reportErr(msg);
-            break;
-        case REPORT_INFO:
+        else
             _errorLogger.reportInfo(msg);
-            break;
-        }
-
-        LeaveCriticalSection(&_reportSync);
+    } else if (message.type == FILE_DONE) {
+        _result += message.result;
+        _processedSize += message.job->fileSize;
+        _timings[message.job->timingKey()] = message.seconds;
+        _fileCount++;
+        if (!_settings.quiet)
+            CppCheckExecutor::reportStatus(_fileCount, _jobs.size(), _processedSize, _totalFileSize);
     }
 }
 
-#else
-
-void ThreadExecutor::addFileContent(const std::string &/*path*/, const std::string &/*content*/)
-{
-
-}
-
-unsigned int ThreadExecutor::check()
+void ThreadExecutor::reportOut(const std::string &outmsg)
 {
-    return 0;
+    Message *message = new Message(REPORT_OUT);
+    message->outmsg = outmsg;
+    postMessage(message);
 }
 
-void ThreadExecutor::reportOut(const std::string &/*outmsg*/)
-{
-
-}
-void ThreadExecutor::reportErr(const ErrorLogger::ErrorMessage &/*msg*/)
+void ThreadExecutor::reportErr(const ErrorLogger::ErrorMessage &msg)
 {
-
+    Message *message = new Message(REPORT_ERROR);
+    message->msg = msg;
+    postMessage(message);
 }
 
-void ThreadExecutor::reportInfo(const ErrorLogger::ErrorMessage &/*msg*/)
+void ThreadExecutor::reportInfo(const ErrorLogger::ErrorMessage &msg)
 {
-
+    Message *message = new Message(REPORT_INFO);
+    message->msg = msg;
+    postMessage(message);
 }
-
-#endif
@@ -21,19 +21,16 @@
 
 #include "errorlogger.h"
 #include "importproject.h"
+#include "suppressions.h"
 
+#include <atomic>
 #include <cstddef>
 #include <list>
 #include <map>
 #include <string>
+#include <vector>
 
-#if (defined(__GNUC__) || defined(__sun)) && !defined(__MINGW32__)
-#define THREADING_MODEL_FORK
-#elif defined(_WIN32)
-#define THREADING_MODEL_WIN
-#include <windows.h>
-#endif
-
+class CppCheck;
 class Settings;
 
 /// @addtogroup CLI
@@ -41,7 +38,16 @@ class Settings;
 
 /**
  * This class will take a list of filenames and settings and check then
- * all files using threads.
+ * all files using a pool of worker threads. Each worker owns a long-lived
+ * CppCheck instance and takes files from a shared work queue. The settings,
+ * including the library, are shared read-only by the workers. Results are
+ * passed to the main thread through a lock-free queue.
+ *
+ * An exception while a file is checked is reported as an internal error
+ * for that file, and the other files are checked. A fatal signal, e.g. a
+ * segmentation fault, stops the whole process since the files are checked
+ * in this process. The signal handler of --exception-handling reports the
+ * file that was checked, see checkedFile().
  */
 class ThreadExecutor : public ErrorLogger {
 public:
@@ -62,90 +68,110 @@ public:
      */
     void addFileContent(const std::string &path, const std::string &content);
 
-private:
-    const std::map<std::string, std::size_t> &_files;
-    Settings &_settings;
-    ErrorLogger &_errorLogger;
-    unsigned int _fileCount;
+    /**
+     * @return true if support for threads exist.
+     */
+    static bool isEnabled() {
+        return true;
+    }
 
-#if defined(THREADING_MODEL_FORK)
+    /** @return file that is checked by the current thread, nullptr if the thread is not a worker */
+    static const char *checkedFile();
 
-    /** @brief Key is file name, and value is the content of the file */
-    std::map<std::string, std::string> _fileContents;
 private:
-    enum PipeSignal {REPORT_OUT='1',REPORT_ERROR='2', REPORT_INFO='3', CHILD_END='4'};
+    enum MessageType {REPORT_OUT, REPORT_ERROR, REPORT_INFO, FILE_DONE};
+
+    /** A file to check */
+    struct Job {
+        Job(const std::string &f, std::size_t size) : filename(f), fileSize(size), fileSettings(nullptr), cost(0) {}
+        explicit Job(const ImportProject::FileSettings *fs) : filename(fs->filename), fileSize(0), fileSettings(fs), cost(0) {}
+        /** key for timings, see AnalyzerInformation::readTimings() */
+        std::string timingKey() const {
+            return (fileSettings ? fileSettings->cfg : std::string()) + ':' + filename;
+        }
+        std::string filename;
+        std::size_t fileSize;
+        const ImportProject::FileSettings *fileSettings;
+        /** expected cost of checking the file */
+        double cost;
+    };
+
+    /** A message from a worker thread to the main thread */
+    struct Message {
+        explicit Message(MessageType t) : type(t), result(0), job(nullptr), seconds(0), next(nullptr) {}
+        MessageType type;
+        std::string outmsg;
+        ErrorLogger::ErrorMessage msg;
+        unsigned int result;
+        const Job *job;
+        double seconds;
+        Message *next;
+    };
 
     /**
-     * Read from the pipe, parse and handle what ever is in there.
-     *@return -1 in case of error
-     *         0 if there is nothing in the pipe to be read
-     *         1 if we did read something
-     */
-    int handleRead(int rpipe, unsigned int &result);
-    void writeToPipe(PipeSignal type, const std::string &data);
-    /**
-     * Write end of status pipe, different for each child.
-     * Not used in master process.
+     * Sort the jobs so the most expensive files are checked first. The
+     * cost is the check time from earlier runs when that is available in
+     * the build dir, otherwise it is estimated from the file size.
      */
-    std::list<std::string> _errorList;
-    int _wpipe;
+    void sortJobsByCost();
+    static bool moreExpensive(const Job &job1, const Job &job2);
+
+    /** Worker thread: check jobs until the work queue is empty */
+    void worker();
+
+    /** Check the file of a job */
+    unsigned int checkJob(CppCheck &fileChecker, const Job &job) const;
+
+    /** Report an exception that stopped the checking of a job */
+    void reportException(const Job &job, const std::string &what);
+
+    /** Push message to the lock-free message queue */
+    void postMessage(Message *message);
+
+    /** Take all messages from the message queue, oldest first */
+    Message *takeMessages();
+
+    /** Handle message in main thread */
+    void handleMessage(const Message &message);
 
     /**
      * @brief Check load average condition
-     * @param nchildren - count of currently runned children
-     * @return true - if new process can be started
+     * @param nrunning - count of currently running jobs
+     * @return true - if new job can be started
      */
-    bool checkLoadAverage(size_t nchildren);
+    bool checkLoadAverage(std::size_t nrunning) const;
 
-public:
-    /**
-     * @return true if support for threads exist.
-     */
-    static bool isEnabled() {
-        return true;
-    }
+    const std::map<std::string, std::size_t> &_files;
 
-#elif defined(THREADING_MODEL_WIN)
+    /** Settings, shared read-only by the workers while files are checked */
+    Settings &_settings;
 
-private:
-    enum MessageType {REPORT_ERROR, REPORT_INFO};
+    /** Suppressions used in the main thread while files are checked, copied back to the settings afterwards */
+    Suppressions _nomsg;
 
-    std::map<std::string, std::string> _fileContents;
-    std::map<std::string, std::size_t>::const_iterator _itNextFile;
-    std::list<ImportProject::FileSettings>::const_iterator _itNextFileSettings;
-    std::size_t _processedFiles;
-    std::size_t _totalFiles;
-    std::size_t _processedSize;
+    ErrorLogger &_errorLogger;
+    unsigned int _fileCount;
     std::size_t _totalFileSize;
-    CRITICAL_SECTION _fileSync;
+    std::size_t _processedSize;
+    unsigned int _result;
 
-    std::list<std::string> _errorList;
-    CRITICAL_SECTION _errorSync;
+    /** @brief Key is file name, and value is the content of the file */
+    std::map<std::string, std::string> _fileContents;
 
-    CRITICAL_SECTION _reportSync;
+    /** Work queue, workers take the job at index _nextJob */
+    std::vector<Job> _jobs;
+    std::atomic<std::size_t> _nextJob;
+    std::atomic<std::size_t> _runningJobs;
 
-    void report(const ErrorLogger::ErrorMessage &msg, MessageType msgType);
+    /** Lock-free message queue, newest message first */
+    std::atomic<Message *> _messages;
 
-    static unsigned __stdcall threadProc(void*);
+    /** Check time in seconds of each job, see AnalyzerInformation::readTimings() */
+    std::map<std::string, double> _timings;
 
-public:
-    /**
-     * @return true if support for threads exist.
-     */
-    static bool isEnabled() {
-        return true;
-    }
-#else
-public:
-    /**
-     * @return true if support for threads exist.
-     */
-    static bool isEnabled() {
-        return false;
-    }
-#endif
+    /** Errors that have been reported, used to report each error only once */
+    ErrorMessageSet _errorList;
 
-private:
     /** disabled copy constructor */
     ThreadExecutor(const ThreadExecutor &);
 
@@ -1,6 +1,7 @@
 set(GUI_QT_COMPONENTS Core Gui Widgets PrintSupport)
 find_package(Qt5 COMPONENTS ${GUI_QT_COMPONENTS})
 find_package(Qt5LinguistTools)
+find_package(Threads REQUIRED)
 if (HAVE_RULES)
     find_library(PCRE pcre)
     if (NOT PCRE)
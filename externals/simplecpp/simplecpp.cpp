@@ -27,12 +27,15 @@
 #include <exception>
 #include <fstream>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <sstream>
 #include <stack>
 #include <stdexcept>
 #include <utility>
 
+#include <sys/stat.h>
+
 #if defined(_WIN32) || defined(__CYGWIN__) || defined(__MINGW32__)
 #include <windows.h>
 #undef ERROR
@@ -212,6 +215,25 @@ void simplecpp::TokenList::operator=(const TokenList &other)
     sizeOfType = other.sizeOfType;
 }
 
+void simplecpp::TokenList::append(const TokenList &other)
+{
+    // translate file indexes of other to file indexes of this list
+    std::vector<unsigned int> fileIndexes;
+    for (const Token *tok = other.cfront(); tok; tok = tok->next) {
+        const unsigned int index = tok->location.fileIndex;
+        if (index >= fileIndexes.size())
+            fileIndexes.resize(index + 1U, ~0U);
+        if (fileIndexes[index] == ~0U)
+            fileIndexes[index] = fileIndex(tok->location.file());
+        Location location(files);
+        location = tok->location;
+        location.fileIndex = fileIndexes[index];
+        Token *newtok = new Token(tok->str, location);
+        newtok->macro = tok->macro;
+        push_back(newtok);
+    }
+}
+
 void simplecpp::TokenList::clear()
 {
     backToken = NULL;
@@ -1129,6 +1151,11 @@ namespace simplecpp {
             return usageList;
         }
 
+        /** restore the usage, copying a macro does not copy it */
+        void setUsage(const std::list<Location> &locations) const {
+            usageList = locations;
+        }
+
         /** is this a function like macro */
         bool functionLike() const {
             return nameTokDef->next &&
@@ -2002,7 +2029,190 @@ static bool hasFile(const std::map<std::string, simplecpp::TokenList *> &filedat
     return !getFileName(filedata, sourcefile, header, dui, systemheader).empty();
 }
 
-std::map<std::string, simplecpp::TokenList*> simplecpp::load(const simplecpp::TokenList &rawtokens, std::vector<std::string> &fileNumbers, const simplecpp::DUI &dui, simplecpp::OutputList *outputList)
+struct simplecpp::MacroSnapshots::Snapshot {
+    explicit Snapshot(std::vector<std::string> &files) : rawtok(NULL), output(files) {}
+    /** where the top sourcefile continues */
+    const Token *rawtok;
+    /** names in the code that was preprocessed since the previous snapshot */
+    std::set<TokenString> names;
+    std::map<TokenString, Macro> macros;
+    std::set<std::string> pragmaOnce;
+    /** output since the previous snapshot */
+    TokenList output;
+    OutputList outputs;
+};
+
+simplecpp::MacroSnapshots::MacroSnapshots() : rawtokens(NULL), files(NULL) {}
+
+simplecpp::MacroSnapshots::~MacroSnapshots()
+{
+    clear();
+}
+
+void simplecpp::MacroSnapshots::clear()
+{
+    for (std::vector<Snapshot *>::iterator it = snapshots.begin(); it != snapshots.end(); ++it)
+        delete *it;
+    snapshots.clear();
+    rawtokens = NULL;
+    files = NULL;
+}
+
+static void copyMacros(const std::map<simplecpp::TokenString, simplecpp::Macro> &from, std::map<simplecpp::TokenString, simplecpp::Macro> &to)
+{
+    to.clear();
+    for (std::map<simplecpp::TokenString, simplecpp::Macro>::const_iterator it = from.begin(); it != from.end(); ++it)
+        to.insert(to.end(), *it)->second.setUsage(it->second.usage());
+}
+
+static void addNames(const simplecpp::Token *tok, const simplecpp::Token *end, std::set<simplecpp::TokenString> &names)
+{
+    for (; tok != end; tok = tok->next) {
+        if (tok->name)
+            names.insert(tok->str);
+    }
+}
+
+/** The macros that the defines in dui give, before the preprocessing starts */
+static std::map<std::string, std::string> getDefines(const simplecpp::DUI &dui)
+{
+    std::map<std::string, std::string> defines;
+    for (std::list<std::string>::const_iterator it = dui.defines.begin(); it != dui.defines.end(); ++it) {
+        const std::string::size_type eq = it->find('=');
+        const std::string macroname = it->substr(0, std::min(eq, it->find('(')));
+        if (dui.undefined.find(macroname) == dui.undefined.end())
+            defines.insert(std::make_pair(macroname, *it));
+    }
+    return defines;
+}
+
+/**
+ * Get the names of the macros that are defined differently by dui1 and dui2.
+ * Returns false if the preprocessing with dui2 can not continue from a
+ * snapshot that was taken with dui1.
+ */
+static bool getChangedMacros(const simplecpp::DUI &dui1, const simplecpp::DUI &dui2, std::set<std::string> *changed)
+{
+    if (dui1.includePaths != dui2.includePaths || dui1.includes != dui2.includes)
+        return false;
+
+    const std::map<std::string, std::string> defines1 = getDefines(dui1);
+    const std::map<std::string, std::string> defines2 = getDefines(dui2);
+    for (std::map<std::string, std::string>::const_iterator it = defines1.begin(); it != defines1.end(); ++it) {
+        const std::map<std::string, std::string>::const_iterator it2 = defines2.find(it->first);
+        if (it2 == defines2.end() || it2->second != it->second)
+            changed->insert(it->first);
+    }
+    for (std::map<std::string, std::string>::const_iterator it = defines2.begin(); it != defines2.end(); ++it) {
+        if (defines1.find(it->first) == defines1.end())
+            changed->insert(it->first);
+    }
+    for (std::set<std::string>::const_iterator it = dui1.undefined.begin(); it != dui1.undefined.end(); ++it) {
+        if (dui2.undefined.find(*it) == dui2.undefined.end())
+            changed->insert(*it);
+    }
+    for (std::set<std::string>::const_iterator it = dui2.undefined.begin(); it != dui2.undefined.end(); ++it) {
+        if (dui1.undefined.find(*it) == dui1.undefined.end())
+            changed->insert(*it);
+    }
+
+    // The names in the defined values are not in the preprocessed code, bail out if they can be changed macros
+    const std::map<std::string, std::string> *defines[] = { &defines1, &defines2 };
+    for (int i = 0; i < 2; ++i) {
+        for (std::map<std::string, std::string>::const_iterator it = defines[i]->begin(); it != defines[i]->end(); ++it) {
+            const std::string::size_type eq = it->second.find('=');
+            if (eq == std::string::npos)
+                continue;
+            for (std::set<std::string>::const_iterator name = changed->begin(); name != changed->end(); ++name) {
+                if (it->second.find(*name, eq) != std::string::npos)
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool containsAny(const std::set<simplecpp::TokenString> &names, const std::set<std::string> &changed)
+{
+    for (std::set<std::string>::const_iterator it = changed.begin(); it != changed.end(); ++it) {
+        if (names.find(*it) != names.end())
+            return true;
+    }
+    return false;
+}
+
+struct simplecpp::FileCache::Entry {
+    Entry(std::vector<std::string> &files, long long s, long long t) : size(s), mtime(t), tokens(files) {}
+    long long size;
+    long long mtime;
+    TokenList tokens;
+};
+
+static bool getFileStatus(const std::string &filename, long long *size, long long *mtime)
+{
+    struct stat statbuf;
+    if (stat(filename.c_str(), &statbuf) != 0)
+        return false;
+    *size = statbuf.st_size;
+    *mtime = statbuf.st_mtime;
+    return true;
+}
+
+simplecpp::FileCache::FileCache() {}
+
+simplecpp::FileCache::~FileCache()
+{
+    clear();
+}
+
+bool simplecpp::FileCache::get(const std::string &filename, TokenList *output) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    const std::map<std::string, Entry *>::const_iterator it = entries.find(filename);
+    if (it == entries.end())
+        return false;
+    long long size, mtime;
+    if (!getFileStatus(filename, &size, &mtime) || size != it->second->size || mtime != it->second->mtime)
+        return false;
+    output->append(it->second->tokens);
+    return true;
+}
+
+void simplecpp::FileCache::insert(const std::string &filename, const TokenList &tokens)
+{
+    long long size, mtime;
+    if (!getFileStatus(filename, &size, &mtime))
+        return;
+    std::lock_guard<std::mutex> lock(mutex);
+    Entry *&entry = entries[filename];
+    delete entry;
+    entry = new Entry(files, size, mtime);
+    entry->tokens.append(tokens);
+}
+
+void simplecpp::FileCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (std::map<std::string, Entry *>::iterator it = entries.begin(); it != entries.end(); ++it)
+        delete it->second;
+    entries.clear();
+    files.clear();
+}
+
+static simplecpp::TokenList *loadFile(std::ifstream &f, std::vector<std::string> &fileNumbers, const std::string &filename, simplecpp::OutputList *outputList, simplecpp::FileCache *cache)
+{
+    simplecpp::TokenList *tokens = new simplecpp::TokenList(fileNumbers);
+    if (cache && cache->get(filename, tokens))
+        return tokens;
+    const std::size_t outputSize = outputList ? outputList->size() : 0U;
+    tokens->readfile(f, filename, outputList);
+    // Files with diagnostics are not cached so the diagnostics are reported for every translation unit
+    if (cache && (!outputList || outputList->size() == outputSize))
+        cache->insert(filename, *tokens);
+    return tokens;
+}
+
+std::map<std::string, simplecpp::TokenList*> simplecpp::load(const simplecpp::TokenList &rawtokens, std::vector<std::string> &fileNumbers, const simplecpp::DUI &dui, simplecpp::OutputList *outputList, FileCache *cache)
 {
     std::map<std::string, simplecpp::TokenList*> ret;
 
@@ -2019,7 +2229,7 @@ std::map<std::string, simplecpp::TokenList*> simplecpp::load(const simplecpp::To
         if (!fin.is_open())
             continue;
 
-        TokenList *tokenlist = new TokenList(fin, fileNumbers, filename, outputList);
+        TokenList *tokenlist = loadFile(fin, fileNumbers, filename, outputList, cache);
         if (!tokenlist->front()) {
             delete tokenlist;
             continue;
@@ -2059,7 +2269,7 @@ std::map<std::string, simplecpp::TokenList*> simplecpp::load(const simplecpp::To
         if (!f.is_open())
             continue;
 
-        TokenList *tokens = new TokenList(f, fileNumbers, header2, outputList);
+        TokenList *tokens = loadFile(f, fileNumbers, header2, outputList, cache);
         ret[header2] = tokens;
         if (tokens->front())
             filelist.push_back(tokens->front());
@@ -2095,7 +2305,7 @@ static bool preprocessToken(simplecpp::TokenList &output, const simplecpp::Token
     return true;
 }
 
-void simplecpp::preprocess(simplecpp::TokenList &output, const simplecpp::TokenList &rawtokens, std::vector<std::string> &files, std::map<std::string, simplecpp::TokenList *> &filedata, const simplecpp::DUI &dui, simplecpp::OutputList *outputList, std::list<simplecpp::MacroUsage> *macroUsage)
+void simplecpp::preprocess(simplecpp::TokenList &output, const simplecpp::TokenList &rawtokens, std::vector<std::string> &files, std::map<std::string, simplecpp::TokenList *> &filedata, const simplecpp::DUI &dui, simplecpp::OutputList *outputList, std::list<simplecpp::MacroUsage> *macroUsage, simplecpp::MacroSnapshots *snapshots)
 {
     std::map<std::string, std::size_t> sizeOfType(rawtokens.sizeOfType);
     sizeOfType.insert(std::pair<std::string, std::size_t>(std::string("char"), sizeof(char)));
@@ -2155,10 +2365,79 @@ void simplecpp::preprocess(simplecpp::TokenList &output, const simplecpp::TokenL
             includetokenstack.push(f->second->cfront());
     }
 
+    // The first call records snapshots, later calls continue from the last snapshot that is not affected by the changed macros
+    bool recordSnapshots = false;
+    std::set<TokenString> snapshotNames;
+    std::set<const Token *> snapshotFiles;
+    const Token *snapshotRawtok = rawtokens.cfront();
+    const Token *snapshotOutput = output.cback();
+    std::size_t snapshotOutputs = outputList ? outputList->size() : 0U;
+    if (snapshots && outputList) {
+        if (!snapshots->rawtokens) {
+            recordSnapshots = true;
+            snapshots->rawtokens = &rawtokens;
+            snapshots->files = &files;
+            snapshots->dui = dui;
+        } else if (snapshots->rawtokens == &rawtokens && snapshots->files == &files) {
+            std::set<std::string> changed;
+            std::size_t count = 0;
+            if (getChangedMacros(snapshots->dui, dui, &changed)) {
+                while (count < snapshots->snapshots.size() && !containsAny(snapshots->snapshots[count]->names, changed))
+                    ++count;
+            }
+            if (count > 0) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    const MacroSnapshots::Snapshot *snapshot = snapshots->snapshots[i];
+                    for (const Token *tok = snapshot->output.cfront(); tok; tok = tok->next)
+                        output.push_back(new Token(*tok));
+                    outputList->insert(outputList->end(), snapshot->outputs.begin(), snapshot->outputs.end());
+                }
+                const MacroSnapshots::Snapshot *snapshot = snapshots->snapshots[count - 1];
+                std::map<TokenString, Macro> defines;
+                defines.swap(macros);
+                copyMacros(snapshot->macros, macros);
+                for (std::set<std::string>::const_iterator it = changed.begin(); it != changed.end(); ++it) {
+                    macros.erase(*it);
+                    const std::map<TokenString, Macro>::const_iterator define = defines.find(*it);
+                    if (define != defines.end())
+                        macros.insert(*define);
+                }
+                pragmaOnce = snapshot->pragmaOnce;
+                includetokenstack = std::stack<const Token *>();
+                includetokenstack.push(snapshot->rawtok);
+            }
+        }
+    }
+
     for (const Token *rawtok = NULL; rawtok || !includetokenstack.empty();) {
         if (rawtok == NULL) {
             rawtok = includetokenstack.top();
             includetokenstack.pop();
+            if (recordSnapshots && rawtok) {
+                // start of a file in dui.includes
+                if (!rawtok->previous && rawtok != rawtokens.cfront() && snapshotFiles.insert(rawtok).second)
+                    addNames(rawtok, NULL, snapshotNames);
+
+                // back in the top sourcefile after the last of consecutive #includes
+                const bool includeDirective = rawtok->op == '#' && !sameline(rawtok->previous, rawtok) && sameline(rawtok, rawtok->next) && rawtok->next->str == INCLUDE;
+                if (includetokenstack.empty() && ifstates.size() == 1U && !includeDirective && (rawtok != rawtokens.cfront() || !snapshotFiles.empty())) {
+                    MacroSnapshots::Snapshot *snapshot = new MacroSnapshots::Snapshot(files);
+                    snapshot->rawtok = rawtok;
+                    addNames(snapshotRawtok, rawtok, snapshotNames);
+                    snapshot->names.swap(snapshotNames);
+                    copyMacros(macros, snapshot->macros);
+                    snapshot->pragmaOnce = pragmaOnce;
+                    for (const Token *tok = snapshotOutput ? snapshotOutput->next : output.cfront(); tok; tok = tok->next)
+                        snapshot->output.push_back(new Token(*tok));
+                    OutputList::iterator out = outputList->begin();
+                    std::advance(out, snapshotOutputs);
+                    snapshot->outputs.insert(snapshot->outputs.end(), out, outputList->end());
+                    snapshots->snapshots.push_back(snapshot);
+                    snapshotRawtok = rawtok;
+                    snapshotOutput = output.cback();
+                    snapshotOutputs = outputList->size();
+                }
+            }
             continue;
         }
 
@@ -2287,6 +2566,8 @@ void simplecpp::preprocess(simplecpp::TokenList &output, const simplecpp::TokenL
                     includetokenstack.push(gotoNextLine(rawtok));
                     const TokenList *includetokens = filedata.find(header2)->second;
                     rawtok = includetokens ? includetokens->cfront() : 0;
+                    if (recordSnapshots && rawtok && snapshotFiles.insert(rawtok).second)
+                        addNames(rawtok, NULL, snapshotNames);
                     continue;
                 }
             } else if (rawtok->str == IF || rawtok->str == IFDEF || rawtok->str == IFNDEF || rawtok->str == ELIF) {
@@ -2421,6 +2702,9 @@ void simplecpp::preprocess(simplecpp::TokenList &output, const simplecpp::TokenL
         }
 
         if (hash || hashhash) {
+            // a snapshot does not see that its last output token is changed
+            if (hashhash)
+                recordSnapshots = false;
             std::string s;
             for (const Token *hashtok = tokens.cfront(); hashtok; hashtok = hashtok->next)
                 s += hashtok->str;
@@ -24,6 +24,7 @@
 #include <istream>
 #include <list>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -189,6 +190,9 @@ namespace simplecpp {
 
         void removeComments();
 
+        /** Append copies of the tokens in other. The file indexes are translated to the filenames of this list. */
+        void append(const TokenList &other);
+
         Token *front() {
             return frontToken;
         }
@@ -275,7 +279,86 @@ namespace simplecpp {
         std::list<std::string> includes;
     };
 
-    SIMPLECPP_LIB std::map<std::string, TokenList*> load(const TokenList &rawtokens, std::vector<std::string> &filenames, const DUI &dui, OutputList *outputList = 0);
+    /**
+     * Cache of lexed files that can be shared by several load() calls.
+     * A file is identified by its path, size and modification time. The
+     * cached tokens are copied into the caller's TokenList so the cache
+     * itself is never modified by the preprocessing. The cache can be
+     * shared between threads.
+     */
+    class SIMPLECPP_LIB FileCache {
+    public:
+        FileCache();
+        ~FileCache();
+
+        /** Copy the cached tokens of a file into output. Returns false if the file is not cached or has been modified since. */
+        bool get(const std::string &filename, TokenList *output) const;
+
+        /** Store the tokens of a lexed file */
+        void insert(const std::string &filename, const TokenList &tokens);
+
+        void clear();
+
+        std::size_t size() const {
+            std::lock_guard<std::mutex> lock(mutex);
+            return entries.size();
+        }
+
+    private:
+        struct Entry;
+
+        /** disabled copy constructor */
+        FileCache(const FileCache &);
+        /** disabled assignment operator */
+        void operator=(const FileCache &);
+
+        std::map<std::string, Entry *> entries;
+        std::vector<std::string> files;
+        mutable std::mutex mutex;
+    };
+
+    /**
+     * Snapshots of the preprocessor state, taken by preprocess() each time
+     * the top sourcefile continues after one or more #includes. When the same rawtokens
+     * are preprocessed again with other defines, preprocess() continues from
+     * the last snapshot that the changed defines can not affect, instead of
+     * preprocessing the headers before it again. The rawtokens, filedata and
+     * files must not be changed while the snapshots are used.
+     */
+    class SIMPLECPP_LIB MacroSnapshots {
+    public:
+        MacroSnapshots();
+        ~MacroSnapshots();
+
+        void clear();
+
+        std::size_t size() const {
+            return snapshots.size();
+        }
+
+        /** internal data of simplecpp, used by preprocess() */
+        struct Snapshot;
+        const TokenList *rawtokens;
+        const std::vector<std::string> *files;
+        DUI dui;
+        std::vector<Snapshot *> snapshots;
+
+    private:
+        /** disabled copy constructor */
+        MacroSnapshots(const MacroSnapshots &);
+        /** disabled assignment operator */
+        void operator=(const MacroSnapshots &);
+    };
+
+    /**
+     * Load all files that are included by rawtokens
+     * @param rawtokens Raw tokenlist for top sourcefile
+     * @param filenames internal data of simplecpp
+     * @param dui defines, undefs, and include paths
+     * @param outputList output: list that will receive output messages
+     * @param cache optional cache of lexed files, that is read and updated
+     */
+    SIMPLECPP_LIB std::map<std::string, TokenList*> load(const TokenList &rawtokens, std::vector<std::string> &filenames, const DUI &dui, OutputList *outputList = 0, FileCache *cache = 0);
 
     /**
      * Preprocess
@@ -287,8 +370,9 @@ namespace simplecpp {
      * @param dui defines, undefs, and include paths
      * @param outputList output: list that will receive output messages
      * @param macroUsage output: macro usage
+     * @param snapshots optional snapshots, that are recorded by the first call and used by later calls. Only used when there is an outputList.
      */
-    SIMPLECPP_LIB void preprocess(TokenList &output, const TokenList &rawtokens, std::vector<std::string> &files, std::map<std::string, TokenList*> &filedata, const DUI &dui, OutputList *outputList = 0, std::list<MacroUsage> *macroUsage = 0);
+    SIMPLECPP_LIB void preprocess(TokenList &output, const TokenList &rawtokens, std::vector<std::string> &files, std::map<std::string, TokenList*> &filedata, const DUI &dui, OutputList *outputList = 0, std::list<MacroUsage> *macroUsage = 0, MacroSnapshots *snapshots = 0);
 
     /**
      * Deallocate data
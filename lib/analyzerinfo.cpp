@@ -22,9 +22,282 @@
 #include "utils.h"
 
 #include <tinyxml2.h>
+#include <cstdio>
 #include <cstring>
-#include <map>
+#include <ctime>
+#include <fstream>
+#include <memory>
+#include <set>
 #include <sstream>
+#include <sys/stat.h>
+
+static const char DatabaseMagic[] = "CPPCHKAI";
+static const unsigned int DatabaseVersion = 3;
+
+static std::string getDatabaseFile(const std::string &buildDir)
+{
+    return buildDir + "/analyzerinfo.bin";
+}
+
+namespace {
+    /** Write binary data */
+    class BinaryWriter {
+    public:
+        explicit BinaryWriter(std::ostream &ostr) : _ostr(ostr) {}
+        void writeInt(unsigned long long value, unsigned int bytes) {
+            for (unsigned int i = 0; i < bytes; ++i)
+                _ostr.put(static_cast<char>((value >> (8 * i)) & 0xff));
+        }
+        void writeString(const std::string &str) {
+            writeInt(str.size(), 4);
+            _ostr.write(str.data(), str.size());
+        }
+    private:
+        std::ostream &_ostr;
+    };
+
+    /** Read binary data from a buffer */
+    class BinaryReader {
+    public:
+        BinaryReader(const std::string &data) : _data(data), _pos(0), _error(false) {}
+        unsigned long long readInt(unsigned int bytes) {
+            if (_pos + bytes > _data.size()) {
+                _error = true;
+                return 0;
+            }
+            unsigned long long value = 0;
+            for (unsigned int i = 0; i < bytes; ++i)
+                value |= static_cast<unsigned long long>(static_cast<unsigned char>(_data[_pos + i])) << (8 * i);
+            _pos += bytes;
+            return value;
+        }
+        std::string readString() {
+            const std::size_t len = static_cast<std::size_t>(readInt(4));
+            if (_error || _pos + len > _data.size()) {
+                _error = true;
+                return std::string();
+            }
+            const std::string ret(_data, _pos, len);
+            _pos += len;
+            return ret;
+        }
+        bool error() const {
+            return _error;
+        }
+    private:
+        const std::string &_data;
+        std::size_t _pos;
+        bool _error;
+    };
+}
+
+AnalyzerDatabase::AnalyzerDatabase(const std::string &buildDir) : _buildDir(buildDir), _modified(false), _saveInterval(10), _lastSave(std::chrono::steady_clock::now())
+{
+}
+
+AnalyzerDatabase &AnalyzerDatabase::instance(const std::string &buildDir)
+{
+    static std::mutex sync;
+    static std::map<std::string, std::unique_ptr<AnalyzerDatabase> > databases;
+    std::lock_guard<std::mutex> lock(sync);
+    std::unique_ptr<AnalyzerDatabase> &database = databases[buildDir];
+    if (!database) {
+        database.reset(new AnalyzerDatabase(buildDir));
+        database->load();
+    }
+    return *database;
+}
+
+bool AnalyzerDatabase::find(const std::string &sourcefile, const std::string &cfg, FileData *data) const
+{
+    std::lock_guard<std::mutex> lock(_sync);
+    const std::unordered_map<std::string, FileData>::const_iterator it = _data.find(key(sourcefile, cfg));
+    if (it == _data.end())
+        return false;
+    *data = it->second;
+    return true;
+}
+
+void AnalyzerDatabase::insert(const FileData &data)
+{
+    std::lock_guard<std::mutex> lock(_sync);
+    _data[key(data.sourcefile, data.cfg)] = data;
+    _modified = true;
+    if (std::chrono::duration<double>(std::chrono::steady_clock::now() - _lastSave).count() >= _saveInterval)
+        saveLocked();
+}
+
+std::size_t AnalyzerDatabase::size() const
+{
+    std::lock_guard<std::mutex> lock(_sync);
+    return _data.size();
+}
+
+bool AnalyzerDatabase::load()
+{
+    std::string buf;
+    {
+        std::ifstream fin(getDatabaseFile(_buildDir).c_str(), std::ios::in | std::ios::binary);
+        if (!fin.is_open())
+            return convertXml();
+        std::ostringstream ostr;
+        ostr << fin.rdbuf();
+        buf = ostr.str();
+    }
+
+    BinaryReader reader(buf);
+    for (unsigned int i = 0; i < 8U; ++i) {
+        if (static_cast<char>(reader.readInt(1)) != DatabaseMagic[i])
+            return false;
+    }
+    if (reader.readInt(4) != DatabaseVersion)
+        return false;
+
+    std::unordered_map<std::string, FileData> data;
+    const unsigned int count = static_cast<unsigned int>(reader.readInt(4));
+    for (unsigned int i = 0; i < count && !reader.error(); ++i) {
+        FileData fileData;
+        fileData.cfg = reader.readString();
+        fileData.sourcefile = reader.readString();
+        fileData.checksum = reader.readInt(8);
+        const unsigned int errors = static_cast<unsigned int>(reader.readInt(4));
+        for (unsigned int e = 0; e < errors && !reader.error(); ++e)
+            fileData.errors.push_back(reader.readString());
+        const unsigned int fileInfos = static_cast<unsigned int>(reader.readInt(4));
+        for (unsigned int f = 0; f < fileInfos && !reader.error(); ++f) {
+            const std::string check = reader.readString();
+            fileData.fileInfo.push_back(std::make_pair(check, reader.readString()));
+        }
+        fileData.settingsChecksum = reader.readInt(8);
+        const unsigned int dependencies = static_cast<unsigned int>(reader.readInt(4));
+        for (unsigned int d = 0; d < dependencies && !reader.error(); ++d) {
+            Dependency dependency;
+            dependency.filename = reader.readString();
+            dependency.size = static_cast<long long>(reader.readInt(8));
+            dependency.mtime = static_cast<long long>(reader.readInt(8));
+            dependency.hash = reader.readInt(8);
+            fileData.dependencies.push_back(dependency);
+        }
+        data[key(fileData.sourcefile, fileData.cfg)] = fileData;
+    }
+    if (reader.error())
+        return false;
+
+    std::lock_guard<std::mutex> lock(_sync);
+    _data.swap(data);
+    _modified = false;
+    return true;
+}
+
+bool AnalyzerDatabase::save()
+{
+    std::lock_guard<std::mutex> lock(_sync);
+    return saveLocked();
+}
+
+bool AnalyzerDatabase::saveLocked()
+{
+    _lastSave = std::chrono::steady_clock::now();
+    if (!_modified)
+        return true;
+
+    const std::string filename(getDatabaseFile(_buildDir));
+    const std::string tempfile(filename + ".tmp");
+    {
+        std::ofstream fout(tempfile.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!fout.is_open())
+            return false;
+        BinaryWriter writer(fout);
+        fout.write(DatabaseMagic, 8);
+        writer.writeInt(DatabaseVersion, 4);
+        writer.writeInt(_data.size(), 4);
+        for (std::unordered_map<std::string, FileData>::const_iterator it = _data.begin(); it != _data.end(); ++it) {
+            const FileData &fileData = it->second;
+            writer.writeString(fileData.cfg);
+            writer.writeString(fileData.sourcefile);
+            writer.writeInt(fileData.checksum, 8);
+            writer.writeInt(fileData.errors.size(), 4);
+            for (std::list<std::string>::const_iterator e = fileData.errors.begin(); e != fileData.errors.end(); ++e)
+                writer.writeString(*e);
+            writer.writeInt(fileData.fileInfo.size(), 4);
+            for (std::list<std::pair<std::string, std::string> >::const_iterator f = fileData.fileInfo.begin(); f != fileData.fileInfo.end(); ++f) {
+                writer.writeString(f->first);
+                writer.writeString(f->second);
+            }
+            writer.writeInt(fileData.settingsChecksum, 8);
+            writer.writeInt(fileData.dependencies.size(), 4);
+            for (std::vector<Dependency>::const_iterator d = fileData.dependencies.begin(); d != fileData.dependencies.end(); ++d) {
+                writer.writeString(d->filename);
+                writer.writeInt(static_cast<unsigned long long>(d->size), 8);
+                writer.writeInt(static_cast<unsigned long long>(d->mtime), 8);
+                writer.writeInt(d->hash, 8);
+            }
+        }
+        if (!fout.good())
+            return false;
+    }
+
+    // Replace the old file. On Windows rename fails if the target exists.
+    if (std::rename(tempfile.c_str(), filename.c_str()) != 0) {
+        std::remove(filename.c_str());
+        if (std::rename(tempfile.c_str(), filename.c_str()) != 0)
+            return false;
+    }
+    _modified = false;
+    return true;
+}
+
+bool AnalyzerDatabase::convertXml()
+{
+    const std::map<std::string, std::string> filesTxt(AnalyzerInformation::readFilesTxt(_buildDir));
+    std::unordered_map<std::string, FileData> data;
+    for (std::map<std::string, std::string>::const_iterator it = filesTxt.begin(); it != filesTxt.end(); ++it) {
+        const std::string xmlfile = _buildDir + '/' + it->second;
+        tinyxml2::XMLDocument doc;
+        if (doc.LoadFile(xmlfile.c_str()) != tinyxml2::XML_SUCCESS)
+            continue;
+        const tinyxml2::XMLElement * const rootNode = doc.FirstChildElement();
+        if (rootNode == nullptr)
+            continue;
+        const char *checksum = rootNode->Attribute("checksum");
+        if (!checksum)
+            continue;
+
+        FileData fileData;
+        const std::string::size_type colon = it->first.find(':');
+        fileData.cfg = it->first.substr(0, colon);
+        fileData.sourcefile = it->first.substr(colon + 1);
+        std::istringstream istr(checksum);
+        istr >> fileData.checksum;
+
+        for (const tinyxml2::XMLElement *e = rootNode->FirstChildElement(); e; e = e->NextSiblingElement()) {
+            if (std::strcmp(e->Name(), "error") == 0)
+                fileData.errors.push_back(ErrorLogger::ErrorMessage(e).serialize());
+            else if (std::strcmp(e->Name(), "FileInfo") == 0 && e->Attribute("check")) {
+                tinyxml2::XMLPrinter printer;
+                for (const tinyxml2::XMLElement *child = e->FirstChildElement(); child; child = child->NextSiblingElement())
+                    child->Accept(&printer);
+                fileData.fileInfo.push_back(std::make_pair(std::string(e->Attribute("check")), std::string(printer.CStr())));
+            }
+        }
+        data[it->first] = fileData;
+    }
+
+    std::lock_guard<std::mutex> lock(_sync);
+    _data.swap(data);
+    _modified = !_data.empty();
+    return true;
+}
+
+bool AnalyzerDatabase::parseFileInfo(const std::pair<std::string, std::string> &fileInfo, tinyxml2::XMLDocument *doc)
+{
+    const std::string xml("<FileInfo check=\"" + ErrorLogger::toxml(fileInfo.first) + "\">\n" + fileInfo.second + "</FileInfo>\n");
+    return doc->Parse(xml.c_str(), xml.size()) == tinyxml2::XML_SUCCESS && doc->FirstChildElement() != nullptr;
+}
+
+AnalyzerInformation::AnalyzerInformation() : database(nullptr)
+{
+}
 
 AnalyzerInformation::~AnalyzerInformation()
 {
@@ -43,10 +316,19 @@ static std::string getFilename(const std::string &fullpath)
     return fullpath.substr(pos1,pos2);
 }
 
+/** files.txt of each build dir, so it is not read again for each file */
+static std::mutex filesTxtSync;
+static std::map<std::string, std::map<std::string, std::string> > filesTxtCache;
+
 void AnalyzerInformation::writeFilesTxt(const std::string &buildDir, const std::list<std::string> &sourcefiles, const std::list<ImportProject::FileSettings> &fileSettings)
 {
     std::map<std::string, unsigned int> fileCount;
 
+    {
+        std::lock_guard<std::mutex> lock(filesTxtSync);
+        filesTxtCache.erase(buildDir);
+    }
+
     const std::string filesTxt(buildDir + "/files.txt");
     std::ofstream fout(filesTxt.c_str());
     for (std::list<std::string>::const_iterator f = sourcefiles.begin(); f != sourcefiles.end(); ++f) {
@@ -64,55 +346,76 @@ void AnalyzerInformation::writeFilesTxt(const std::string &buildDir, const std::
     }
 }
 
-void AnalyzerInformation::close()
+std::map<std::string, std::string> AnalyzerInformation::readFilesTxt(const std::string &buildDir)
 {
-    analyzerInfoFile.clear();
-    if (fout.is_open()) {
-        fout << "</analyzerinfo>\n";
-        fout.close();
+    std::lock_guard<std::mutex> lock(filesTxtSync);
+    const std::map<std::string, std::map<std::string, std::string> >::const_iterator cached = filesTxtCache.find(buildDir);
+    if (cached != filesTxtCache.end())
+        return cached->second;
+
+    std::map<std::string, std::string> ret;
+    const std::string files(buildDir + "/files.txt");
+    std::ifstream fin(files.c_str());
+    std::string line;
+    while (std::getline(fin, line)) {
+        const std::string::size_type firstColon = line.find(':');
+        if (firstColon == std::string::npos || firstColon == 0)
+            continue;
+        const std::string::size_type secondColon = line.find(':', firstColon + 1);
+        if (secondColon == std::string::npos)
+            continue;
+        // key is "cfg:sourcefile"
+        ret[line.substr(firstColon + 1)] = line.substr(0, firstColon);
     }
+    filesTxtCache[buildDir] = ret;
+    return ret;
 }
 
-static bool skipAnalysis(const std::string &analyzerInfoFile, unsigned long long checksum, std::list<ErrorLogger::ErrorMessage> *errors)
+std::map<std::string, double> AnalyzerInformation::readTimings(const std::string &buildDir)
 {
-    tinyxml2::XMLDocument doc;
-    tinyxml2::XMLError error = doc.LoadFile(analyzerInfoFile.c_str());
-    if (error != tinyxml2::XML_SUCCESS)
-        return false;
+    std::map<std::string, double> timings;
+    const std::string timingsTxt(buildDir + "/timings.txt");
+    std::ifstream fin(timingsTxt.c_str());
+    std::string line;
+    while (std::getline(fin, line)) {
+        const std::string::size_type pos = line.find(' ');
+        if (pos == std::string::npos)
+            continue;
+        std::istringstream istr(line.substr(0, pos));
+        double seconds = 0;
+        if (istr >> seconds)
+            timings[line.substr(pos + 1)] = seconds;
+    }
+    return timings;
+}
 
-    const tinyxml2::XMLElement * const rootNode = doc.FirstChildElement();
-    if (rootNode == nullptr)
-        return false;
+void AnalyzerInformation::writeTimings(const std::string &buildDir, const std::map<std::string, double> &timings)
+{
+    std::map<std::string, double> allTimings(readTimings(buildDir));
+    for (std::map<std::string, double>::const_iterator it = timings.begin(); it != timings.end(); ++it)
+        allTimings[it->first] = it->second;
 
-    const char *attr = rootNode->Attribute("checksum");
-    if (!attr || attr != std::to_string(checksum))
-        return false;
+    const std::string timingsTxt(buildDir + "/timings.txt");
+    std::ofstream fout(timingsTxt.c_str());
+    for (std::map<std::string, double>::const_iterator it = allTimings.begin(); it != allTimings.end(); ++it)
+        fout << it->second << ' ' << it->first << '\n';
+}
 
-    for (const tinyxml2::XMLElement *e = rootNode->FirstChildElement(); e; e = e->NextSiblingElement()) {
-        if (std::strcmp(e->Name(), "error") == 0)
-            errors->push_back(ErrorLogger::ErrorMessage(e));
+void AnalyzerInformation::close()
+{
+    if (database) {
+        database->insert(fileData);
+        database = nullptr;
     }
-
-    return true;
+    fileData = AnalyzerDatabase::FileData();
 }
 
 std::string AnalyzerInformation::getAnalyzerInfoFile(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg)
 {
-    const std::string files(buildDir + "/files.txt");
-    std::ifstream fin(files.c_str());
-    if (fin.is_open()) {
-        std::string line;
-        const std::string endsWith(':' + cfg + ':' + sourcefile);
-        while (std::getline(fin,line)) {
-            if (line.size() <= endsWith.size() + 2U)
-                continue;
-            if (line.compare(line.size()-endsWith.size(), endsWith.size(), endsWith) != 0)
-                continue;
-            std::ostringstream ostr;
-            ostr << buildDir << '/' << line.substr(0,line.find(':'));
-            return ostr.str();
-        }
-    }
+    const std::map<std::string, std::string> filesTxt(readFilesTxt(buildDir));
+    const std::map<std::string, std::string>::const_iterator it = filesTxt.find(cfg + ':' + sourcefile);
+    if (it != filesTxt.end())
+        return buildDir + '/' + it->second;
 
     std::string filename = Path::fromNativeSeparators(buildDir);
     if (!endsWith(filename, '/'))
@@ -126,36 +429,218 @@ std::string AnalyzerInformation::getAnalyzerInfoFile(const std::string &buildDir
     return filename;
 }
 
-bool AnalyzerInformation::analyzeFile(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg, unsigned long long checksum, std::list<ErrorLogger::ErrorMessage> *errors)
+unsigned long long AnalyzerInformation::settingsChecksum(const std::string &settings)
+{
+    return fnv1a(settings);
+}
+
+static bool getFileStatus(const std::string &filename, long long *size, long long *mtime)
+{
+    struct stat statbuf;
+    if (stat(filename.c_str(), &statbuf) != 0)
+        return false;
+    *size = statbuf.st_size;
+    *mtime = statbuf.st_mtime;
+    return true;
+}
+
+static bool getFileHash(const std::string &filename, unsigned long long *hash)
+{
+    std::ifstream fin(filename.c_str(), std::ios::in | std::ios::binary);
+    if (!fin.is_open())
+        return false;
+    std::ostringstream ostr;
+    ostr << fin.rdbuf();
+    *hash = fnv1a(ostr.str());
+    return true;
+}
+
+/** Directories that a TU depends on are stored with a trailing '/' */
+static bool isDirectory(const std::string &filename)
+{
+    return !filename.empty() && filename[filename.size() - 1] == '/';
+}
+
+/** A directory that does not exist has size and modification time -1, it may be created later */
+static void getDirectoryStatus(const std::string &dirname, long long *size, long long *mtime)
+{
+    // stat() does not accept a trailing separator on all platforms
+    const std::string name(dirname.size() > 1 ? dirname.substr(0, dirname.size() - 1) : dirname);
+    if (!getFileStatus(name, size, mtime)) {
+        *size = -1;
+        *mtime = -1;
+    }
+}
+
+/**
+ * A file could be modified again within the resolution of the modification
+ * time without changing the size. The modification time of recently modified
+ * files is therefore not trusted, and their content is compared next time.
+ */
+static long long trustedModificationTime(long long mtime)
+{
+    return (mtime >= static_cast<long long>(std::time(nullptr)) - 2) ? 0 : mtime;
+}
+
+bool AnalyzerInformation::getDependency(const std::string &filename, AnalyzerDatabase::Dependency *dependency, const AnalyzerDatabase::Dependency *previous)
+{
+    dependency->filename = filename;
+    if (isDirectory(filename)) {
+        // The modification time changes when a file is added or removed, the content is not compared
+        getDirectoryStatus(filename, &dependency->size, &dependency->mtime);
+        dependency->mtime = trustedModificationTime(dependency->mtime);
+        dependency->hash = 0;
+        return true;
+    }
+    if (!getFileStatus(filename, &dependency->size, &dependency->mtime))
+        return false;
+    dependency->mtime = trustedModificationTime(dependency->mtime);
+    if (previous && previous->filename == filename && previous->mtime != 0 &&
+        previous->size == dependency->size && previous->mtime == dependency->mtime) {
+        // Same size and modification time, the content has not been changed
+        dependency->hash = previous->hash;
+        return true;
+    }
+    return getFileHash(filename, &dependency->hash);
+}
+
+bool AnalyzerInformation::isUnchanged(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg, unsigned long long settingsChecksum, std::list<ErrorLogger::ErrorMessage> *errors)
+{
+    if (buildDir.empty() || sourcefile.empty())
+        return false;
+
+    AnalyzerDatabase &db = AnalyzerDatabase::instance(buildDir);
+    AnalyzerDatabase::FileData fileData;
+    if (!db.find(sourcefile, cfg, &fileData) || fileData.settingsChecksum != settingsChecksum || fileData.dependencies.empty())
+        return false;
+
+    bool touched = false;
+    for (std::vector<AnalyzerDatabase::Dependency>::iterator dep = fileData.dependencies.begin(); dep != fileData.dependencies.end(); ++dep) {
+        long long size, mtime;
+        if (isDirectory(dep->filename)) {
+            getDirectoryStatus(dep->filename, &size, &mtime);
+            if (size != dep->size || mtime != dep->mtime)
+                return false;
+            continue;
+        }
+        if (!getFileStatus(dep->filename, &size, &mtime) || size != dep->size)
+            return false;
+        if (mtime == dep->mtime)
+            continue;
+        // The file has been touched, compare the content
+        unsigned long long hash;
+        if (!getFileHash(dep->filename, &hash) || hash != dep->hash)
+            return false;
+        if (dep->mtime != trustedModificationTime(mtime)) {
+            dep->mtime = trustedModificationTime(mtime);
+            touched = true;
+        }
+    }
+
+    // Remember the new modification times so the content is not read again
+    if (touched)
+        db.insert(fileData);
+
+    for (std::list<std::string>::const_iterator it = fileData.errors.begin(); it != fileData.errors.end(); ++it) {
+        ErrorLogger::ErrorMessage msg;
+        msg.deserialize(*it);
+        errors->push_back(msg);
+    }
+    return true;
+}
+
+static bool sameDependencies(const std::vector<AnalyzerDatabase::Dependency> &deps1, const std::vector<AnalyzerDatabase::Dependency> &deps2)
+{
+    if (deps1.size() != deps2.size())
+        return false;
+    for (std::size_t i = 0; i < deps1.size(); ++i) {
+        if (deps1[i].filename != deps2[i].filename ||
+            deps1[i].size != deps2[i].size ||
+            deps1[i].mtime != deps2[i].mtime ||
+            deps1[i].hash != deps2[i].hash)
+            return false;
+    }
+    return true;
+}
+
+bool AnalyzerInformation::analyzeFile(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg, unsigned long long checksum, unsigned long long settingsChecksum, const std::vector<std::string> &files, const std::list<std::string> &includePaths, std::list<ErrorLogger::ErrorMessage> *errors)
 {
     if (buildDir.empty() || sourcefile.empty())
         return true;
     close();
 
-    analyzerInfoFile = AnalyzerInformation::getAnalyzerInfoFile(buildDir,sourcefile,cfg);
+    AnalyzerDatabase &db = AnalyzerDatabase::instance(buildDir);
+    const bool found = db.find(sourcefile, cfg, &fileData);
 
-    if (skipAnalysis(analyzerInfoFile, checksum, errors))
-        return false;
+    // The hashes of files that are unchanged since the last analysis are reused
+    std::map<std::string, const AnalyzerDatabase::Dependency *> previous;
+    for (std::vector<AnalyzerDatabase::Dependency>::const_iterator dep = fileData.dependencies.begin(); dep != fileData.dependencies.end(); ++dep)
+        previous[dep->filename] = &*dep;
 
-    fout.open(analyzerInfoFile);
-    if (fout.is_open()) {
-        fout << "<?xml version=\"1.0\"?>\n";
-        fout << "<analyzerinfo checksum=\"" << checksum << "\">\n";
-    } else {
-        analyzerInfoFile.clear();
+    std::vector<AnalyzerDatabase::Dependency> dependencies(files.size());
+    for (std::size_t i = 0; i < files.size(); ++i) {
+        const std::map<std::string, const AnalyzerDatabase::Dependency *>::const_iterator it = previous.find(files[i]);
+        if (!getDependency(files[i], &dependencies[i], it == previous.end() ? nullptr : it->second)) {
+            // The TU can't be skipped without preprocessing it
+            dependencies.clear();
+            break;
+        }
+    }
+
+    // The directories that are searched for included files. A file that is
+    // added to one of them changes the result of an #include when it is a
+    // header that was missing, or when it shadows the header that was found.
+    if (!dependencies.empty()) {
+        std::set<std::string> directories;
+        for (std::size_t i = 0; i < files.size(); ++i) {
+            const std::string dir(Path::getPathFromFilename(files[i]));
+            directories.insert(dir.empty() ? std::string("./") : dir);
+        }
+        for (std::list<std::string>::const_iterator it = includePaths.begin(); it != includePaths.end(); ++it) {
+            if (!it->empty())
+                directories.insert(isDirectory(*it) ? *it : (*it + '/'));
+        }
+        for (std::set<std::string>::const_iterator dir = directories.begin(); dir != directories.end(); ++dir) {
+            const std::map<std::string, const AnalyzerDatabase::Dependency *>::const_iterator it = previous.find(*dir);
+            dependencies.push_back(AnalyzerDatabase::Dependency());
+            getDependency(*dir, &dependencies.back(), it == previous.end() ? nullptr : it->second);
+        }
+    }
+
+    if (found && fileData.checksum == checksum) {
+        for (std::list<std::string>::const_iterator it = fileData.errors.begin(); it != fileData.errors.end(); ++it) {
+            ErrorLogger::ErrorMessage msg;
+            msg.deserialize(*it);
+            errors->push_back(msg);
+        }
+        // Remember the dependencies so the next analysis can be skipped without preprocessing
+        if (fileData.settingsChecksum != settingsChecksum || !sameDependencies(fileData.dependencies, dependencies)) {
+            fileData.settingsChecksum = settingsChecksum;
+            fileData.dependencies.swap(dependencies);
+            db.insert(fileData);
+        }
+        fileData = AnalyzerDatabase::FileData();
+        return false;
     }
 
+    database = &db;
+    fileData = AnalyzerDatabase::FileData();
+    fileData.sourcefile = sourcefile;
+    fileData.cfg = cfg;
+    fileData.checksum = checksum;
+    fileData.settingsChecksum = settingsChecksum;
+    fileData.dependencies.swap(dependencies);
     return true;
 }
 
 void AnalyzerInformation::reportErr(const ErrorLogger::ErrorMessage &msg, bool /*verbose*/)
 {
-    if (fout.is_open())
-        fout << msg.toXML() << '\n';
+    if (database)
+        fileData.errors.push_back(msg.serialize());
 }
 
 void AnalyzerInformation::setFileInfo(const std::string &check, const std::string &fileInfo)
 {
-    if (fout.is_open() && !fileInfo.empty())
-        fout << "  <FileInfo check=\"" << check << "\">\n" << fileInfo << "  </FileInfo>\n";
+    if (database && !fileInfo.empty())
+        fileData.fileInfo.push_back(std::make_pair(check, fileInfo));
 }
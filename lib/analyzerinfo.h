@@ -25,13 +25,129 @@
 #include "errorlogger.h"
 #include "importproject.h"
 
-#include <fstream>
+#include <chrono>
 #include <list>
+#include <map>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace tinyxml2 {
+    class XMLDocument;
+}
 
 /// @addtogroup Core
 /// @{
 
+/**
+* @brief Analyzer information of all files in a build dir.
+*
+* All data is stored in a single binary file "analyzerinfo.bin" in the
+* build dir. It is read once and kept in memory, lookups are done with a
+* hash table. The file is written atomically by writing a temporary
+* file that replaces the old one. The file is also written while files are
+* checked, at most every saveInterval seconds, so the results are kept if
+* the run is interrupted.
+*
+* If there is no binary file then the data is converted from the older
+* layout with one XML .analyzerinfo file per TU/cfg.
+*
+* The files that a TU depends on are stored with size, modification time
+* and a hash of the content. If none of them has changed then the TU can
+* be skipped without reading and preprocessing it. The directories that are
+* searched for included files are stored with their modification time,
+* with a trailing '/' in the name. A header that is added later, because it
+* was missing or because it shadows a header that was found, changes it.
+*
+* Binary format, integers are little endian and strings are a 32 bit
+* length followed by the characters:
+* - magic "CPPCHKAI", 32 bit version, 32 bit number of entries
+* - for each entry: cfg, sourcefile, 64 bit checksum,
+*   32 bit number of errors followed by serialized error messages,
+*   32 bit number of FileInfo followed by check name and FileInfo xml,
+*   64 bit settings checksum, 32 bit number of dependencies followed by
+*   filename, 64 bit size, 64 bit modification time and 64 bit hash
+*/
+class CPPCHECKLIB AnalyzerDatabase {
+public:
+    /** A file that a TU depends on */
+    struct Dependency {
+        Dependency() : size(0), mtime(0), hash(0) {}
+        std::string filename;
+        long long size;
+        long long mtime;
+        /** hash of the file content, see AnalyzerInformation::getDependency() */
+        unsigned long long hash;
+    };
+
+    struct FileData {
+        FileData() : checksum(0), settingsChecksum(0) {}
+        std::string sourcefile;
+        std::string cfg;
+        unsigned long long checksum;
+        /** error messages, see ErrorLogger::ErrorMessage::serialize() */
+        std::list<std::string> errors;
+        /** check name and FileInfo xml, see Check::FileInfo::toString() */
+        std::list<std::pair<std::string, std::string> > fileInfo;
+        /** checksum of the settings that were used, see AnalyzerInformation::settingsChecksum() */
+        unsigned long long settingsChecksum;
+        /** source file and all included files */
+        std::vector<Dependency> dependencies;
+    };
+
+    explicit AnalyzerDatabase(const std::string &buildDir);
+
+    /** Get the database of a build dir. It is loaded when it is used the first time. */
+    static AnalyzerDatabase &instance(const std::string &buildDir);
+
+    /** Lookup data for a TU/cfg. Returns false if there is no data. */
+    bool find(const std::string &sourcefile, const std::string &cfg, FileData *data) const;
+
+    /** Add or replace the data for a TU/cfg. The binary file is written if it was last written saveInterval seconds ago. */
+    void insert(const FileData &data);
+
+    /** Set the minimum time in seconds between two writes of the binary file by insert() */
+    void setSaveInterval(double seconds) {
+        _saveInterval = seconds;
+    }
+
+    /** Load the binary file, or convert the XML files if there is no binary file */
+    bool load();
+
+    /** Write the binary file if the data has been modified */
+    bool save();
+
+    /** Read data from the .analyzerinfo XML files listed in files.txt */
+    bool convertXml();
+
+    /** Parse FileInfo xml, the returned document has a root element FileInfo */
+    static bool parseFileInfo(const std::pair<std::string, std::string> &fileInfo, tinyxml2::XMLDocument *doc);
+
+    std::size_t size() const;
+
+private:
+    static std::string key(const std::string &sourcefile, const std::string &cfg) {
+        return cfg + ':' + sourcefile;
+    }
+
+    /** Write the binary file, _sync must be locked */
+    bool saveLocked();
+
+    const std::string _buildDir;
+    std::unordered_map<std::string, FileData> _data;
+    bool _modified;
+    double _saveInterval;
+    std::chrono::steady_clock::time_point _lastSave;
+    mutable std::mutex _sync;
+
+    /** disabled copy constructor */
+    AnalyzerDatabase(const AnalyzerDatabase &);
+    /** disabled assignment operator */
+    void operator=(const AnalyzerDatabase &);
+};
+
 /**
 * @brief Analyzer information
 *
@@ -47,19 +163,65 @@
 */
 class CPPCHECKLIB AnalyzerInformation {
 public:
+    AnalyzerInformation();
     ~AnalyzerInformation();
 
     static void writeFilesTxt(const std::string &buildDir, const std::list<std::string> &sourcefiles, const std::list<ImportProject::FileSettings> &fileSettings);
 
-    /** Close current TU.analyzerinfo file */
+    /** Read files.txt, the key is "cfg:sourcefile" and the value is the name of the analyzer info file without path */
+    static std::map<std::string, std::string> readFilesTxt(const std::string &buildDir);
+
+    /** Close current TU and store its data in the database */
     void close();
-    bool analyzeFile(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg, unsigned long long checksum, std::list<ErrorLogger::ErrorMessage> *errors);
+
+    /**
+     * Check if a TU and all the files it includes are unchanged since the
+     * last analysis. This only needs to stat the files, the content is only
+     * read when the modification time has changed but not the size.
+     * @param buildDir build dir
+     * @param sourcefile source file
+     * @param cfg cfg name
+     * @param settingsChecksum see settingsChecksum()
+     * @param errors the errors of the last analysis are added here if the TU is unchanged
+     * @return true if the TU is unchanged and does not need to be analyzed
+     */
+    static bool isUnchanged(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg, unsigned long long settingsChecksum, std::list<ErrorLogger::ErrorMessage> *errors);
+
+    /**
+     * Start the analysis of a TU.
+     * @param buildDir build dir
+     * @param sourcefile source file
+     * @param cfg cfg name
+     * @param checksum checksum of the preprocessor tokens
+     * @param settingsChecksum see settingsChecksum()
+     * @param files source file and included files, the files vector of simplecpp::load()
+     * @param includePaths include paths that are searched for included files
+     * @param errors the errors of the last analysis are added here if the checksum is unchanged
+     * @return false if the checksum is unchanged and the TU does not need to be analyzed
+     */
+    bool analyzeFile(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg, unsigned long long checksum, unsigned long long settingsChecksum, const std::vector<std::string> &files, const std::list<std::string> &includePaths, std::list<ErrorLogger::ErrorMessage> *errors);
     void reportErr(const ErrorLogger::ErrorMessage &msg, bool verbose);
     void setFileInfo(const std::string &check, const std::string &fileInfo);
     static std::string getAnalyzerInfoFile(const std::string &buildDir, const std::string &sourcefile, const std::string &cfg);
+
+    /** Checksum of settings that change which files are included or how they are analyzed */
+    static unsigned long long settingsChecksum(const std::string &settings);
+
+    /**
+     * Get size, modification time and content hash of a file. Returns false if the file can't be read.
+     * @param filename file name
+     * @param dependency the file data is written here
+     * @param previous optional data from the last analysis, its hash is reused if size and modification time are the same
+     */
+    static bool getDependency(const std::string &filename, AnalyzerDatabase::Dependency *dependency, const AnalyzerDatabase::Dependency *previous = nullptr);
+
+    /** Read the check time in seconds of each file from the last runs, key is "cfg:sourcefile" */
+    static std::map<std::string, double> readTimings(const std::string &buildDir);
+    /** Write check times, timings of files that are not in the given map are kept */
+    static void writeTimings(const std::string &buildDir, const std::map<std::string, double> &timings);
 private:
-    std::ofstream fout;
-    std::string analyzerInfoFile;
+    AnalyzerDatabase *database;
+    AnalyzerDatabase::FileData fileData;
 };
 
 /// @}
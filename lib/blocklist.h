@@ -0,0 +1,241 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2016 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef blocklistH
+#define blocklistH
+//---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <utility>
+#include <vector>
+
+/// @addtogroup Core
+/// @{
+
+/**
+ * @brief Sequence container that stores its elements in blocks.
+ *
+ * Block sizes double, starting at 4 elements. Elements never move, so
+ * pointers to them stay valid until they are removed. Iterators stay valid
+ * when elements are added, like std::list iterators.
+ */
+template<class T>
+class BlockList {
+    enum { FIRST_BLOCK_SIZE = 4 };
+
+    template<class Value, class List>
+    class Iterator {
+    public:
+        typedef std::bidirectional_iterator_tag iterator_category;
+        typedef T value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef Value *pointer;
+        typedef Value &reference;
+
+        Iterator() : _list(nullptr), _block(0), _offset(0) {
+        }
+        Iterator(List *list, std::size_t block, std::size_t offset) : _list(list), _block(block), _offset(offset) {
+        }
+        /** iterator to const_iterator */
+        template<class Value2, class List2>
+        Iterator(const Iterator<Value2, List2> &it) : _list(it._list), _block(it._block), _offset(it._offset) {
+        }
+
+        reference operator*() const {
+            return _list->_blocks[_block][_offset];
+        }
+        pointer operator->() const {
+            return &_list->_blocks[_block][_offset];
+        }
+
+        Iterator &operator++() {
+            if (++_offset == blockSize(_block)) {
+                ++_block;
+                _offset = 0;
+            }
+            return *this;
+        }
+        Iterator operator++(int) {
+            Iterator it(*this);
+            ++*this;
+            return it;
+        }
+        Iterator &operator--() {
+            if (_offset == 0) {
+                --_block;
+                _offset = blockSize(_block);
+            }
+            --_offset;
+            return *this;
+        }
+        Iterator operator--(int) {
+            Iterator it(*this);
+            --*this;
+            return it;
+        }
+
+        bool operator==(const Iterator &it) const {
+            return _offset == it._offset && _block == it._block;
+        }
+        bool operator!=(const Iterator &it) const {
+            return !(*this == it);
+        }
+
+    private:
+        template<class Value2, class List2> friend class Iterator;
+
+        List *_list;
+        std::size_t _block;
+        std::size_t _offset;
+    };
+
+public:
+    typedef T value_type;
+    typedef T &reference;
+    typedef const T &const_reference;
+    typedef std::size_t size_type;
+    typedef Iterator<T, BlockList> iterator;
+    typedef Iterator<const T, const BlockList> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    BlockList() : _size(0), _endBlock(0), _endOffset(0) {
+    }
+
+    BlockList(const BlockList &other) : _size(0), _endBlock(0), _endOffset(0) {
+        for (const_iterator it = other.begin(); it != other.end(); ++it)
+            push_back(*it);
+    }
+
+    BlockList(BlockList &&other) : _size(0), _endBlock(0), _endOffset(0) {
+        swap(other);
+    }
+
+    ~BlockList() {
+        clear();
+        for (std::size_t i = 0; i < _blocks.size(); ++i)
+            ::operator delete(_blocks[i]);
+    }
+
+    BlockList &operator=(BlockList other) {
+        swap(other);
+        return *this;
+    }
+
+    void swap(BlockList &other) {
+        _blocks.swap(other._blocks);
+        std::swap(_size, other._size);
+        std::swap(_endBlock, other._endBlock);
+        std::swap(_endOffset, other._endOffset);
+    }
+
+    iterator begin() {
+        return iterator(this, 0, 0);
+    }
+    const_iterator begin() const {
+        return const_iterator(this, 0, 0);
+    }
+    iterator end() {
+        return iterator(this, _endBlock, _endOffset);
+    }
+    const_iterator end() const {
+        return const_iterator(this, _endBlock, _endOffset);
+    }
+    const_iterator cbegin() const {
+        return begin();
+    }
+    const_iterator cend() const {
+        return end();
+    }
+    reverse_iterator rbegin() {
+        return reverse_iterator(end());
+    }
+    const_reverse_iterator rbegin() const {
+        return const_reverse_iterator(end());
+    }
+    reverse_iterator rend() {
+        return reverse_iterator(begin());
+    }
+    const_reverse_iterator rend() const {
+        return const_reverse_iterator(begin());
+    }
+
+    size_type size() const {
+        return _size;
+    }
+    bool empty() const {
+        return _size == 0;
+    }
+
+    T &front() {
+        return _blocks[0][0];
+    }
+    const T &front() const {
+        return _blocks[0][0];
+    }
+    T &back() {
+        return *--end();
+    }
+    const T &back() const {
+        return *--end();
+    }
+
+    void push_back(const T &value) {
+        if (_endBlock == _blocks.size())
+            _blocks.push_back(static_cast<T *>(::operator new(blockSize(_endBlock) * sizeof(T))));
+        new (_blocks[_endBlock] + _endOffset) T(value);
+        ++_size;
+        if (++_endOffset == blockSize(_endBlock)) {
+            ++_endBlock;
+            _endOffset = 0;
+        }
+    }
+
+    void pop_back() {
+        if (_endOffset == 0) {
+            --_endBlock;
+            _endOffset = blockSize(_endBlock);
+        }
+        --_endOffset;
+        --_size;
+        _blocks[_endBlock][_endOffset].~T();
+    }
+
+    /** Remove all elements, the blocks are kept for reuse */
+    void clear() {
+        while (_size > 0)
+            pop_back();
+    }
+
+private:
+    static std::size_t blockSize(std::size_t block) {
+        return std::size_t(FIRST_BLOCK_SIZE) << block;
+    }
+
+    std::vector<T *> _blocks;
+    std::size_t _size;
+    std::size_t _endBlock;
+    std::size_t _endOffset;
+};
+
+/// @}
+//---------------------------------------------------------------------------
+#endif // blocklistH
@@ -19,8 +19,13 @@
 //---------------------------------------------------------------------------
 
 #include "check.h"
+#include "symboldatabase.h"
+#include "threadpool.h"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <mutex>
 
 //---------------------------------------------------------------------------
 
@@ -41,6 +46,115 @@ void Check::reportError(const ErrorLogger::ErrorMessage &errmsg)
     std::cout << errmsg.toXML() << std::endl;
 }
 
+namespace {
+    /**
+     * Collects the errors of a part that is checked by a worker thread.
+     * Progress is forwarded to the error logger of the check, one thread at a time.
+     */
+    class PartErrorLogger : public ErrorLogger {
+    public:
+        PartErrorLogger(std::list<ErrorLogger::ErrorMessage> *errors, ErrorLogger *progressLogger, std::mutex *progressSync)
+            : _errors(errors), _progressLogger(progressLogger), _progressSync(progressSync) {
+        }
+
+        void reportOut(const std::string &outmsg) {
+            (void)outmsg;
+        }
+
+        void reportErr(const ErrorLogger::ErrorMessage &msg) {
+            _errors->push_back(msg);
+        }
+
+        void reportProgress(const std::string &filename, const char stage[], const std::size_t value) {
+            std::lock_guard<std::mutex> lock(*_progressSync);
+            _progressLogger->reportProgress(filename, stage, value);
+        }
+
+    private:
+        std::list<ErrorLogger::ErrorMessage> * const _errors;
+        ErrorLogger * const _progressLogger;
+        std::mutex * const _progressSync;
+    };
+}
+
+std::vector<Check::TokenRange> Check::functionParts() const
+{
+    std::vector<TokenRange> parts;
+    if (_settings->functionJobs <= 1) {
+        parts.push_back(TokenRange(_tokenizer->tokens(), nullptr));
+        return parts;
+    }
+
+    const std::vector<const Scope *> &functionScopes = _tokenizer->getSymbolDatabase()->functionScopes;
+    const Token *tok = _tokenizer->tokens();
+    for (std::size_t i = 0; i < functionScopes.size(); ++i) {
+        const Scope *scope = functionScopes[i];
+        bool nested = false;
+        for (const Scope *s = scope->nestedIn; s && !nested; s = s->nestedIn)
+            nested = (s->type == Scope::eFunction);
+        if (nested || !scope->classStart || !scope->classEnd)
+            continue;
+
+        const Token * const start = tok;
+        while (tok && tok != scope->classStart)
+            tok = tok->next();
+        if (!tok) {
+            // Not in token order, check all code at once
+            parts.clear();
+            parts.push_back(TokenRange(_tokenizer->tokens(), nullptr));
+            return parts;
+        }
+        if (start != tok)
+            parts.push_back(TokenRange(start, tok));
+        tok = scope->classEnd->next();
+        parts.push_back(TokenRange(scope->classStart, tok));
+    }
+    if (tok)
+        parts.push_back(TokenRange(tok, nullptr));
+    return parts;
+}
+
+void Check::checkParts(std::size_t parts, PartChecker &checker)
+{
+    const std::size_t nthreads = std::min<std::size_t>(_settings->functionJobs, parts);
+    if (nthreads <= 1) {
+        for (std::size_t i = 0; i < parts; ++i)
+            checker.check(i, _errorLogger);
+        return;
+    }
+
+    // Each thread checks the next part that has not been taken, until all parts are taken
+    class PartsTask : public ThreadPool::Task {
+    public:
+        PartsTask(PartChecker *checker, std::vector<std::list<ErrorLogger::ErrorMessage> > *errors, ErrorLogger *progressLogger)
+            : _checker(checker), _errors(errors), _progressLogger(progressLogger), _nextPart(0) {
+        }
+
+        void run() {
+            for (std::size_t i = _nextPart++; i < _errors->size(); i = _nextPart++) {
+                PartErrorLogger errorLogger(&(*_errors)[i], _progressLogger, &_progressSync);
+                _checker->check(i, &errorLogger);
+            }
+        }
+
+    private:
+        PartChecker * const _checker;
+        std::vector<std::list<ErrorLogger::ErrorMessage> > * const _errors;
+        ErrorLogger * const _progressLogger;
+        std::atomic<std::size_t> _nextPart;
+        std::mutex _progressSync;
+    };
+
+    std::vector<std::list<ErrorLogger::ErrorMessage> > errors(parts);
+    PartsTask task(&checker, &errors, _errorLogger);
+    _settings->functionJobThreads->run(task, nthreads);
+
+    for (std::size_t i = 0; i < parts; ++i) {
+        for (std::list<ErrorLogger::ErrorMessage>::const_iterator it = errors[i].begin(); it != errors[i].end(); ++it)
+            _errorLogger->reportErr(*it);
+    }
+}
+
 bool Check::wrongData(const Token *tok, bool condition, const char *str)
 {
 #if defined(DACA2) || defined(UNSTABLE)
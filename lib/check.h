@@ -30,6 +30,8 @@
 
 #include <list>
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace tinyxml2 {
     class XMLElement;
@@ -166,7 +168,8 @@ protected:
         if (!value) {
             errorPath.push_back(ErrorPathItem(errtok,bug));
         } else if (_settings->verbose || _settings->xml || _settings->outputFormat == "daca2") {
-            errorPath = value->errorPath;
+            for (ValueFlow::Value::ErrorPath::const_iterator it = value->errorPath.begin(); it != value->errorPath.end(); ++it)
+                errorPath.push_back(ErrorPathItem(it->tok, it->str()));
             errorPath.push_back(ErrorPathItem(errtok,bug));
         } else {
             if (value->condition)
@@ -183,6 +186,84 @@ protected:
      * will call this method
      */
     bool wrongData(const Token *tok, bool condition, const char *str);
+
+    /** Tokens from first until, but not including, second. second is nullptr at the end of the token list. */
+    typedef std::pair<const Token *, const Token *> TokenRange;
+
+    /**
+     * Split the token list into the bodies of the functions and the code
+     * between them, in token order. Functions in local classes stay in the
+     * body of the function that contains them. If functions are only
+     * checked with one thread the whole token list is returned as one part.
+     */
+    std::vector<TokenRange> functionParts() const;
+
+    /** Checks one of the parts given to checkParts() */
+    class PartChecker {
+    public:
+        virtual ~PartChecker() {}
+
+        /** Check part number i and report the errors to errorLogger */
+        virtual void check(std::size_t i, ErrorLogger *errorLogger) = 0;
+    };
+
+    /**
+     * Check the parts 0..parts-1. If Settings::functionJobs is larger than 1
+     * the parts are checked by this thread and threads of
+     * Settings::functionJobThreads. The errors of each part are then
+     * collected and reported when all parts are checked, in the order of
+     * the parts. The output is the same as when the parts are checked one
+     * after another. Progress is reported right away, by one thread at a time.
+     * An exception from a part is rethrown when all threads have stopped.
+     */
+    void checkParts(std::size_t parts, PartChecker &checker);
+
+    /**
+     * Call f(check, part) for all parts, see checkParts(). A part that is
+     * checked by another thread gets its own instance of CheckClass.
+     */
+    template<class CheckClass, class Part, class F>
+    void checkParts(const std::vector<Part> &parts, const F &f) {
+        class Checker : public PartChecker {
+        public:
+            Checker(CheckClass *owner, const std::vector<Part> &parts, const F &f) : _owner(owner), _parts(parts), _f(f) {
+            }
+            void check(std::size_t i, ErrorLogger *errorLogger) {
+                if (errorLogger == _owner->_errorLogger) {
+                    _f(*_owner, _parts[i]);
+                } else {
+                    CheckClass check(_owner->_tokenizer, _owner->_settings, errorLogger);
+                    _f(check, _parts[i]);
+                }
+            }
+        private:
+            CheckClass * const _owner;
+            const std::vector<Part> &_parts;
+            const F &_f;
+        };
+
+        Checker checker(static_cast<CheckClass *>(this), parts, f);
+        checkParts(parts.size(), checker);
+    }
+
+    /** Calls a member function of CheckClass for a part, see checkParts() */
+    template<class CheckClass, class Part>
+    class MemberFunctionCall {
+    public:
+        explicit MemberFunctionCall(void (CheckClass::*f)(Part)) : _f(f) {
+        }
+        void operator()(CheckClass &check, const Part &part) const {
+            (check.*_f)(part);
+        }
+    private:
+        void (CheckClass::*_f)(Part);
+    };
+
+    /** Call (check.*f)(part) for all parts, see checkParts() */
+    template<class CheckClass, class Part>
+    void checkParts(const std::vector<Part> &parts, void (CheckClass::*f)(Part)) {
+        checkParts<CheckClass>(parts, MemberFunctionCall<CheckClass, Part>(f));
+    }
 private:
     const std::string _name;
 
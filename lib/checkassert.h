@@ -49,11 +49,19 @@ public:
         : Check(myName(), tokenizer, settings, errorLogger) {
     }
 
-    virtual void runSimplifiedChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) {
+    /** @brief Run checks against the normal token list */
+    virtual void runChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) {
         CheckAssert check(tokenizer, settings, errorLogger);
         check.assertWithSideEffects();
     }
 
+    /** @brief Run checks against the simplified token list */
+    virtual void runSimplifiedChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) {
+        (void)tokenizer;
+        (void)settings;
+        (void)errorLogger;
+    }
+
     void assertWithSideEffects();
 
 protected:
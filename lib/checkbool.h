@@ -58,6 +58,10 @@ public:
         checkBool.checkComparisonOfBoolWithInt();
         checkBool.checkAssignBoolToFloat();
         checkBool.pointerArithBool();
+        checkBool.checkComparisonOfFuncReturningBool();
+        checkBool.checkComparisonOfBoolWithBool();
+        checkBool.checkIncrementBoolean();
+        checkBool.checkBitwiseOnBoolean();
     }
 
     /** @brief Run checks against the simplified token list */
@@ -65,11 +69,7 @@ public:
         CheckBool checkBool(tokenizer, settings, errorLogger);
 
         // Checks
-        checkBool.checkComparisonOfFuncReturningBool();
-        checkBool.checkComparisonOfBoolWithBool();
-        checkBool.checkIncrementBoolean();
         checkBool.checkAssignBoolToPointer();
-        checkBool.checkBitwiseOnBoolean();
     }
 
     /** @brief %Check for comparison of function returning bool*/
@@ -1143,6 +1143,37 @@ bool CheckBufferOverrun::isArrayOfStruct(const Token* tok, int &position)
 // Checking local variables in a scope
 //---------------------------------------------------------------------------
 
+void CheckBufferOverrun::checkScopeArrays(const Scope *scope)
+{
+    std::map<unsigned int, ArrayInfo> arrayInfos;
+    for (BlockList<Variable>::const_iterator var = scope->varlist.cbegin(); var != scope->varlist.cend(); ++var) {
+        if (!var->isArray() || var->dimension(0) <= 0)
+            continue;
+        _errorLogger->reportProgress(_tokenizer->list.getSourceFilePath(),
+                                     "Check (BufferOverrun::checkGlobalAndLocalVariable 1)",
+                                     var->nameToken()->progressValue());
+
+        if (_tokenizer->isMaxTime())
+            return;
+
+        const Token *tok = var->nameToken();
+        do {
+            if (tok->str() == "{") {
+                if (Token::simpleMatch(tok->previous(), "= {"))
+                    tok = tok->link();
+                else
+                    break;
+            }
+            tok = tok->next();
+        } while (tok && tok->str() != ";");
+        if (!tok)
+            break;
+        arrayInfos[var->declarationId()] = ArrayInfo(&*var, symbolDatabase, var->declarationId());
+    }
+    if (!arrayInfos.empty())
+        checkScope(scope->classStart ? scope->classStart : _tokenizer->tokens(), arrayInfos);
+}
+
 void CheckBufferOverrun::checkGlobalAndLocalVariable()
 {
     // check string literals
@@ -1159,7 +1190,7 @@ void CheckBufferOverrun::checkGlobalAndLocalVariable()
             if (!value)
                 continue;
 
-            for (std::list<ValueFlow::Value>::const_iterator it = tok->values().begin(); it != tok->values().end(); ++it) {
+            for (ValueFlow::TokenValues::const_iterator it = tok->values().begin(); it != tok->values().end(); ++it) {
                 if (!it->isTokValue() || !it->tokvalue)
                     continue;
                 const Variable *var = it->tokvalue->variable();
@@ -1195,35 +1226,13 @@ void CheckBufferOverrun::checkGlobalAndLocalVariable()
     }
 
     // check all known fixed size arrays first by just looking them up
-    for (std::list<Scope>::const_iterator scope = symbolDatabase->scopeList.cbegin(); scope != symbolDatabase->scopeList.cend(); ++scope) {
-        std::map<unsigned int, ArrayInfo> arrayInfos;
-        for (std::list<Variable>::const_iterator var = scope->varlist.cbegin(); var != scope->varlist.cend(); ++var) {
-            if (!var->isArray() || var->dimension(0) <= 0)
-                continue;
-            _errorLogger->reportProgress(_tokenizer->list.getSourceFilePath(),
-                                         "Check (BufferOverrun::checkGlobalAndLocalVariable 1)",
-                                         var->nameToken()->progressValue());
-
-            if (_tokenizer->isMaxTime())
-                return;
+    std::vector<const Scope *> scopes;
+    for (BlockList<Scope>::const_iterator scope = symbolDatabase->scopeList.cbegin(); scope != symbolDatabase->scopeList.cend(); ++scope)
+        scopes.push_back(&*scope);
+    checkParts(scopes, &CheckBufferOverrun::checkScopeArrays);
 
-            const Token *tok = var->nameToken();
-            do {
-                if (tok->str() == "{") {
-                    if (Token::simpleMatch(tok->previous(), "= {"))
-                        tok = tok->link();
-                    else
-                        break;
-                }
-                tok = tok->next();
-            } while (tok && tok->str() != ";");
-            if (!tok)
-                break;
-            arrayInfos[var->declarationId()] = ArrayInfo(&*var, symbolDatabase, var->declarationId());
-        }
-        if (!arrayInfos.empty())
-            checkScope(scope->classStart ? scope->classStart : _tokenizer->tokens(), arrayInfos);
-    }
+    if (_tokenizer->isMaxTime())
+        return;
 
     const std::vector<const std::string*> v;
 
@@ -1326,7 +1335,7 @@ void CheckBufferOverrun::checkStructVariable()
         const Scope * scope = symbolDatabase->classAndStructScopes[i];
 
         // check all variables to see if they are arrays
-        std::list<Variable>::const_iterator var;
+        BlockList<Variable>::const_iterator var;
         for (var = scope->varlist.begin(); var != scope->varlist.end(); ++var) {
             if (var->isArray()) {
                 // create ArrayInfo from the array variable
@@ -1980,8 +1989,8 @@ Check::FileInfo* CheckBufferOverrun::getFileInfo(const Tokenizer *tokenizer, con
     }
 
     // Arrays..
-    const std::list<Variable> &varlist = symbolDB->scopeList.front().varlist;
-    for (std::list<Variable>::const_iterator it = varlist.begin(); it != varlist.end(); ++it) {
+    const BlockList<Variable> &varlist = symbolDB->scopeList.front().varlist;
+    for (BlockList<Variable>::const_iterator it = varlist.begin(); it != varlist.end(); ++it) {
         const Variable &var = *it;
         if (!var.isStatic() && var.isArray() && var.dimensions().size() == 1U && var.dimension(0U) > 0U)
             fileInfo->arraySize[var.name()] = var.dimension(0U);
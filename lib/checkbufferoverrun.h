@@ -34,6 +34,7 @@
 #include <string>
 #include <vector>
 
+class Scope;
 class Settings;
 class SymbolDatabase;
 class Token;
@@ -115,6 +116,9 @@ public:
     /** Check for buffer overruns - locate global variables and local function variables and check them with the checkScope function */
     void checkGlobalAndLocalVariable();
 
+    /** Check the fixed size arrays that are declared in a scope, part of checkGlobalAndLocalVariable() */
+    void checkScopeArrays(const Scope *scope);
+
     /** Check for buffer overruns due to allocating strlen(src) bytes instead of (strlen(src)+1) bytes before copying a string */
     void checkBufferAllocatedWithStrlen();
 
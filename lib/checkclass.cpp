@@ -30,6 +30,7 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <set>
 #include <stack>
 #include <utility>
 //---------------------------------------------------------------------------
@@ -90,27 +91,29 @@ void CheckClass::constructors()
         return;
 
     const bool printInconclusive = _settings->inconclusive;
+
+    // Classes that are the type of a union member
+    std::set<const Scope *> unionMemberClasses;
+    for (BlockList<Scope>::const_iterator it = symbolDatabase->scopeList.begin(); it != symbolDatabase->scopeList.end(); ++it) {
+        if (it->type != Scope::eUnion)
+            continue;
+        const Scope &unionScope = *it;
+        for (BlockList<Variable>::const_iterator var = unionScope.varlist.begin(); var != unionScope.varlist.end(); ++var) {
+            if (var->type() && var->type()->classScope)
+                unionMemberClasses.insert(var->type()->classScope);
+        }
+    }
+
     const std::size_t classes = symbolDatabase->classAndStructScopes.size();
     for (std::size_t i = 0; i < classes; ++i) {
         const Scope * scope = symbolDatabase->classAndStructScopes[i];
 
-        bool usedInUnion = false;
-        for (std::list<Scope>::const_iterator it = symbolDatabase->scopeList.begin(); it != symbolDatabase->scopeList.end(); ++it) {
-            if (it->type != Scope::eUnion)
-                continue;
-            const Scope &unionScope = *it;
-            for (std::list<Variable>::const_iterator var = unionScope.varlist.begin(); var != unionScope.varlist.end(); ++var) {
-                if (var->type() && var->type()->classScope == scope) {
-                    usedInUnion = true;
-                    break;
-                }
-            }
-        }
+        const bool usedInUnion = unionMemberClasses.find(scope) != unionMemberClasses.end();
 
         // There are no constructors.
         if (scope->numConstructors == 0 && printStyle && !usedInUnion) {
             // If there is a private variable, there should be a constructor..
-            std::list<Variable>::const_iterator var;
+            BlockList<Variable>::const_iterator var;
             for (var = scope->varlist.begin(); var != scope->varlist.end(); ++var) {
                 if (var->isPrivate() && !var->isStatic() && !Token::Match(var->nameToken(), "%varid% ; %varid% =", var->declarationId()) &&
                     (!var->isClass() || (var->type() && var->type()->needInitialization == Type::True))) {
@@ -139,7 +142,7 @@ void CheckClass::constructors()
         }
 
 
-        std::list<Function>::const_iterator func;
+        BlockList<Function>::const_iterator func;
         std::vector<Usage> usage(scope->varlist.size());
 
         for (func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
@@ -154,7 +157,7 @@ void CheckClass::constructors()
             initializeVarList(*func, callstack, scope, usage);
 
             // Check if any variables are uninitialized
-            std::list<Variable>::const_iterator var;
+            BlockList<Variable>::const_iterator var;
             unsigned int count = 0;
             for (var = scope->varlist.begin(); var != scope->varlist.end(); ++var, ++count) {
                 // check for C++11 initializer
@@ -256,7 +259,7 @@ void CheckClass::checkExplicitConstructors()
         // Is class abstract? Maybe this test is over-simplification, but it will suffice for simple cases,
         // and it will avoid false positives.
         bool isAbstractClass = false;
-        for (std::list<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
+        for (BlockList<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
             if (func->isPure()) {
                 isAbstractClass = true;
                 break;
@@ -268,7 +271,7 @@ void CheckClass::checkExplicitConstructors()
         if (isAbstractClass && _settings->standards.cpp != Standards::CPP11)
             continue;
 
-        for (std::list<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
+        for (BlockList<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
 
             // We are looking for constructors, which are meeting following criteria:
             //  1) Constructor is declared with a single parameter
@@ -298,7 +301,7 @@ void CheckClass::copyconstructors()
         const Scope * scope = symbolDatabase->classAndStructScopes[i];
         std::map<unsigned int, const Token*> allocatedVars;
 
-        for (std::list<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
+        for (BlockList<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
             if (func->type == Function::eConstructor && func->functionScope) {
                 const Token* tok = func->functionScope->classDef->linkAt(1);
                 for (const Token* const end = func->functionScope->classStart; tok != end; tok = tok->next()) {
@@ -320,7 +323,7 @@ void CheckClass::copyconstructors()
 
         std::set<const Token*> copiedVars;
         const Token* copyCtor = nullptr;
-        for (std::list<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
+        for (BlockList<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
             if (func->type == Function::eCopyConstructor) {
                 copyCtor = func->tokenDef;
                 if (func->functionScope) {
@@ -394,7 +397,7 @@ void CheckClass::noCopyConstructorError(const Token *tok, const std::string &cla
 
 bool CheckClass::canNotCopy(const Scope *scope)
 {
-    std::list<Function>::const_iterator func;
+    BlockList<Function>::const_iterator func;
     bool constructor = false;
     bool publicAssign = false;
     bool publicCopy = false;
@@ -414,7 +417,7 @@ bool CheckClass::canNotCopy(const Scope *scope)
 
 bool CheckClass::canNotMove(const Scope *scope)
 {
-    std::list<Function>::const_iterator func;
+    BlockList<Function>::const_iterator func;
     bool constructor = false;
     bool publicAssign = false;
     bool publicCopy = false;
@@ -438,7 +441,7 @@ bool CheckClass::canNotMove(const Scope *scope)
 
 void CheckClass::assignVar(unsigned int varid, const Scope *scope, std::vector<Usage> &usage)
 {
-    std::list<Variable>::const_iterator var;
+    BlockList<Variable>::const_iterator var;
     unsigned int count = 0;
 
     for (var = scope->varlist.begin(); var != scope->varlist.end(); ++var, ++count) {
@@ -451,7 +454,7 @@ void CheckClass::assignVar(unsigned int varid, const Scope *scope, std::vector<U
 
 void CheckClass::initVar(unsigned int varid, const Scope *scope, std::vector<Usage> &usage)
 {
-    std::list<Variable>::const_iterator var;
+    BlockList<Variable>::const_iterator var;
     unsigned int count = 0;
 
     for (var = scope->varlist.begin(); var != scope->varlist.end(); ++var, ++count) {
@@ -484,8 +487,8 @@ bool CheckClass::isBaseClassFunc(const Token *tok, const Scope *scope)
 
         // Check if base class exists in database
         if (derivedFrom && derivedFrom->classScope) {
-            const std::list<Function>& functionList = derivedFrom->classScope->functionList;
-            std::list<Function>::const_iterator func;
+            const BlockList<Function>& functionList = derivedFrom->classScope->functionList;
+            BlockList<Function>::const_iterator func;
 
             for (func = functionList.begin(); func != functionList.end(); ++func) {
                 if (func->tokenDef->str() == tok->str())
@@ -591,7 +594,7 @@ void CheckClass::initializeVarList(const Function &func, std::list<const Functio
 
         // Calling member variable function?
         if (Token::Match(ftok->next(), "%var% . %name% (")) {
-            std::list<Variable>::const_iterator var;
+            BlockList<Variable>::const_iterator var;
             for (var = scope->varlist.begin(); var != scope->varlist.end(); ++var) {
                 if (var->declarationId() == ftok->next()->varId()) {
                     /** @todo false negative: we assume function changes variable state */
@@ -911,7 +914,7 @@ static bool checkFunctionUsage(const Function *privfunc, const Scope* scope)
     if (!scope)
         return true; // Assume it is used, if scope is not seen
 
-    for (std::list<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
+    for (BlockList<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
         if (func->functionScope) {
             if (Token::Match(func->tokenDef, "%name% (")) {
                 for (const Token *ftok = func->tokenDef->tokAt(2); ftok && ftok->str() != ")"; ftok = ftok->next()) {
@@ -939,7 +942,7 @@ static bool checkFunctionUsage(const Function *privfunc, const Scope* scope)
             return true;
     }
 
-    for (std::list<Variable>::const_iterator i = scope->varlist.begin(); i != scope->varlist.end(); ++i) {
+    for (BlockList<Variable>::const_iterator i = scope->varlist.begin(); i != scope->varlist.end(); ++i) {
         if (i->isStatic()) {
             const Token* tok = Token::findmatch(scope->classEnd, "%varid% =|(|{", i->declarationId());
             if (tok)
@@ -969,7 +972,7 @@ void CheckClass::privateFunctions()
             continue;
 
         std::list<const Function*> privateFuncs;
-        for (std::list<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
+        for (BlockList<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
             // Get private functions..
             if (func->type == Function::eFunction && func->access == Private && !func->isOperator()) // TODO: There are smarter ways to check private operator usage
                 privateFuncs.push_back(&*func);
@@ -1124,7 +1127,7 @@ void CheckClass::checkMemsetType(const Scope *start, const Token *tok, const Sco
     }
 
     // Warn if type is a class that contains any virtual functions
-    std::list<Function>::const_iterator func;
+    BlockList<Function>::const_iterator func;
 
     for (func = type->functionList.begin(); func != type->functionList.end(); ++func) {
         if (func->isVirtual()) {
@@ -1136,7 +1139,7 @@ void CheckClass::checkMemsetType(const Scope *start, const Token *tok, const Sco
     }
 
     // Warn if type is a class or struct that contains any std::* variables
-    std::list<Variable>::const_iterator var;
+    BlockList<Variable>::const_iterator var;
 
     for (var = type->varlist.begin(); var != type->varlist.end(); ++var) {
         if (var->isReference() && !var->isStatic()) {
@@ -1224,7 +1227,7 @@ void CheckClass::operatorEq()
     const std::size_t classes = symbolDatabase->classAndStructScopes.size();
     for (std::size_t i = 0; i < classes; ++i) {
         const Scope * scope = symbolDatabase->classAndStructScopes[i];
-        std::list<Function>::const_iterator func;
+        BlockList<Function>::const_iterator func;
 
         for (func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
             if (func->type == Function::eOperatorEqual && func->access == Public) {
@@ -1278,7 +1281,7 @@ void CheckClass::operatorEqRetRefThis()
     const std::size_t classes = symbolDatabase->classAndStructScopes.size();
     for (std::size_t i = 0; i < classes; ++i) {
         const Scope * scope = symbolDatabase->classAndStructScopes[i];
-        std::list<Function>::const_iterator func;
+        BlockList<Function>::const_iterator func;
 
         for (func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
             if (func->type == Function::eOperatorEqual && func->hasBody()) {
@@ -1316,7 +1319,7 @@ void CheckClass::checkReturnPtrThis(const Scope *scope, const Function *func, co
         // check if a function is called
         if (tok->strAt(2) == "(" &&
             tok->linkAt(2)->next()->str() == ";") {
-            std::list<Function>::const_iterator it;
+            BlockList<Function>::const_iterator it;
 
             // check if it is a member function
             for (it = scope->functionList.begin(); it != scope->functionList.end(); ++it) {
@@ -1419,7 +1422,7 @@ void CheckClass::operatorEqToSelf()
         if (scope->definedType->derivedFrom.size() > 1)
             continue;
 
-        std::list<Function>::const_iterator func;
+        BlockList<Function>::const_iterator func;
         for (func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
             if (func->type == Function::eOperatorEqual && func->hasBody()) {
                 // make sure that the operator takes an object of the same type as *this, otherwise we can't detect self-assignment checks
@@ -1548,7 +1551,7 @@ void CheckClass::virtualDestructor()
             if (printInconclusive) {
                 const Function *destructor = scope->getDestructor();
                 if (destructor && !destructor->isVirtual()) {
-                    std::list<Function>::const_iterator func;
+                    BlockList<Function>::const_iterator func;
                     for (func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
                         if (func->isVirtual()) {
                             inconclusiveErrors.push_back(destructor);
@@ -1719,7 +1722,7 @@ void CheckClass::checkConst()
     const std::size_t classes = symbolDatabase->classAndStructScopes.size();
     for (std::size_t i = 0; i < classes; ++i) {
         const Scope * scope = symbolDatabase->classAndStructScopes[i];
-        std::list<Function>::const_iterator func;
+        BlockList<Function>::const_iterator func;
 
         for (func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
             // does the function have a body?
@@ -1819,7 +1822,7 @@ bool CheckClass::isMemberVar(const Scope *scope, const Token *tok) const
         }
     } while (again);
 
-    std::list<Variable>::const_iterator var;
+    BlockList<Variable>::const_iterator var;
     for (var = scope->varlist.begin(); var != scope->varlist.end(); ++var) {
         if (var->name() == tok->str()) {
             if (tok->varId() == 0)
@@ -1850,7 +1853,7 @@ bool CheckClass::isMemberVar(const Scope *scope, const Token *tok) const
 bool CheckClass::isMemberFunc(const Scope *scope, const Token *tok) const
 {
     if (!tok->function()) {
-        for (std::list<Function>::const_iterator i = scope->functionList.cbegin(); i != scope->functionList.cend(); ++i) {
+        for (BlockList<Function>::const_iterator i = scope->functionList.cbegin(); i != scope->functionList.cend(); ++i) {
             if (i->name() == tok->str()) {
                 const Token* tok2 = tok->tokAt(2);
                 size_t argsPassed = tok2->str() == ")" ? 0 : 1;
@@ -2105,7 +2108,7 @@ void CheckClass::initializerListOrder()
     const std::size_t classes = symbolDatabase->classAndStructScopes.size();
     for (std::size_t i = 0; i < classes; ++i) {
         const Scope * scope = symbolDatabase->classAndStructScopes[i];
-        std::list<Function>::const_iterator func;
+        BlockList<Function>::const_iterator func;
 
         // iterate through all member functions looking for constructors
         for (func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
@@ -2326,7 +2329,7 @@ void CheckClass::checkDuplInheritedMembers()
         return;
 
     // Iterate over all classes
-    for (std::list<Type>::const_iterator classIt = symbolDatabase->typeList.begin();
+    for (BlockList<Type>::const_iterator classIt = symbolDatabase->typeList.begin();
          classIt != symbolDatabase->typeList.end();
          ++classIt) {
         // Iterate over the parent classes
@@ -2337,10 +2340,10 @@ void CheckClass::checkDuplInheritedMembers()
             if (!parentClassIt->type || !parentClassIt->type->classScope)
                 continue;
             // Check if they have a member variable in common
-            for (std::list<Variable>::const_iterator classVarIt = classIt->classScope->varlist.begin();
+            for (BlockList<Variable>::const_iterator classVarIt = classIt->classScope->varlist.begin();
                  classVarIt != classIt->classScope->varlist.end();
                  ++classVarIt) {
-                for (std::list<Variable>::const_iterator parentClassVarIt = parentClassIt->type->classScope->varlist.begin();
+                for (BlockList<Variable>::const_iterator parentClassVarIt = parentClassIt->type->classScope->varlist.begin();
                      parentClassVarIt != parentClassIt->type->classScope->varlist.end();
                      ++parentClassVarIt) {
                     if (classVarIt->name() == parentClassVarIt->name() && !parentClassVarIt->isPrivate()) { // Check if the class and its parent have a common variable
@@ -2385,7 +2388,7 @@ void CheckClass::checkCopyCtorAndEqOperator()
 
         // count the number of non-static variables
         int vars = 0;
-        for (std::list<Variable>::const_iterator var = scope->varlist.begin(); var != scope->varlist.end(); ++var) {
+        for (BlockList<Variable>::const_iterator var = scope->varlist.begin(); var != scope->varlist.end(); ++var) {
             if (!var->isStatic())
                 vars++;
         }
@@ -2395,7 +2398,7 @@ void CheckClass::checkCopyCtorAndEqOperator()
         int hasCopyCtor = 0;
         int hasAssignmentOperator = 0;
 
-        std::list<Function>::const_iterator func;
+        BlockList<Function>::const_iterator func;
         for (func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
             if (!hasCopyCtor && func->type == Function::eCopyConstructor) {
                 hasCopyCtor = func->hasBody() ? 2 : 1;
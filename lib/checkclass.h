@@ -61,20 +61,11 @@ public:
 
         // can't be a simplified check .. the 'sizeof' is used.
         checkClass.checkMemset();
-    }
-
-    /** @brief Run checks on the simplified token list */
-    void runSimplifiedChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) {
-        if (tokenizer->isC())
-            return;
-
-        CheckClass checkClass(tokenizer, settings, errorLogger);
 
         // Coding style checks
         checkClass.constructors();
         checkClass.operatorEq();
         checkClass.privateFunctions();
-        checkClass.operatorEqRetRefThis();
         checkClass.thisSubtraction();
         checkClass.operatorEqToSelf();
         checkClass.initializerListOrder();
@@ -83,7 +74,6 @@ public:
 
         checkClass.virtualDestructor();
         checkClass.checkConst();
-        checkClass.copyconstructors();
         checkClass.checkPureVirtualFunctionCall();
 
         checkClass.checkDuplInheritedMembers();
@@ -91,6 +81,18 @@ public:
         checkClass.checkCopyCtorAndEqOperator();
     }
 
+    /** @brief Run checks on the simplified token list */
+    void runSimplifiedChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) {
+        if (tokenizer->isC())
+            return;
+
+        CheckClass checkClass(tokenizer, settings, errorLogger);
+
+        // Coding style checks
+        checkClass.operatorEqRetRefThis();
+        checkClass.copyconstructors();
+    }
+
 
     /** @brief %Check that all class constructors are ok */
     void constructors();
@@ -59,15 +59,15 @@ public:
         checkCondition.checkIncorrectLogicOperator();
         checkCondition.checkInvalidTestForOverflow();
         checkCondition.alwaysTrueFalse();
+        checkCondition.checkBadBitmaskCheck();
+        checkCondition.comparison();
+        checkCondition.checkModuloAlwaysTrueFalse();
     }
 
     /** @brief Run checks against the simplified token list */
     void runSimplifiedChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) {
         CheckCondition checkCondition(tokenizer, settings, errorLogger);
         checkCondition.assignIf();
-        checkCondition.checkBadBitmaskCheck();
-        checkCondition.comparison();
-        checkCondition.checkModuloAlwaysTrueFalse();
     }
 
     /** mismatching assignment / comparison */
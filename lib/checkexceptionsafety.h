@@ -61,8 +61,8 @@ public:
         : Check(myName(), tokenizer, settings, errorLogger) {
     }
 
-    /** Checks that uses the simplified token list */
-    void runSimplifiedChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) {
+    /** @brief Run checks against the normal token list */
+    void runChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) {
         if (tokenizer->isC())
             return;
 
@@ -75,6 +75,13 @@ public:
         checkExceptionSafety.unhandledExceptionSpecification();
     }
 
+    /** @brief Run checks against the simplified token list */
+    void runSimplifiedChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) {
+        (void)tokenizer;
+        (void)settings;
+        (void)errorLogger;
+    }
+
     /** Don't throw exceptions in destructors */
     void destructors();
 
@@ -64,19 +64,21 @@ public:
         // Checks
         checkFunctions.checkIgnoredReturnValue();
 
+        checkFunctions.checkProhibitedFunctions();
+        checkFunctions.invalidFunctionUsage();
+        checkFunctions.checkMathFunctions();
+        checkFunctions.memsetZeroBytes();
+        checkFunctions.memsetInvalid2ndParam();
+
         // --check-library : functions with nonmatching configuration
         checkFunctions.checkLibraryMatchFunctions();
     }
 
     /** @brief Run checks against the simplified token list */
     void runSimplifiedChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) {
-        CheckFunctions checkFunctions(tokenizer, settings, errorLogger);
-
-        checkFunctions.checkProhibitedFunctions();
-        checkFunctions.invalidFunctionUsage();
-        checkFunctions.checkMathFunctions();
-        checkFunctions.memsetZeroBytes();
-        checkFunctions.memsetInvalid2ndParam();
+        (void)tokenizer;
+        (void)settings;
+        (void)errorLogger;
     }
 
     /** Check for functions that should not be used */
@@ -1668,7 +1668,7 @@ bool CheckIO::ArgumentInfo::isStdVectorOrString()
     } else if (variableInfo->type()) {
         const Scope * classScope = variableInfo->type()->classScope;
         if (classScope) {
-            std::list<Function>::const_iterator functions;
+            BlockList<Function>::const_iterator functions;
             for (functions = classScope->functionList.begin();
                  functions != classScope->functionList.end(); ++functions) {
                 if (functions->name() == "operator[]") {
@@ -54,15 +54,15 @@ public:
         CheckIO checkIO(tokenizer, settings, errorLogger);
 
         checkIO.checkWrongPrintfScanfArguments();
+        checkIO.checkCoutCerrMisusage();
+        checkIO.invalidScanf();
     }
 
     /** @brief Run checks on the simplified token list */
     void runSimplifiedChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) {
         CheckIO checkIO(tokenizer, settings, errorLogger);
 
-        checkIO.checkCoutCerrMisusage();
         checkIO.checkFileUsage();
-        checkIO.invalidScanf();
     }
 
     /** @brief %Check for missusage of std::cout */
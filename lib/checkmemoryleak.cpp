@@ -415,7 +415,7 @@ const char *CheckMemoryLeak::functionArgAlloc(const Function *func, unsigned int
     if (!Token::simpleMatch(func->retDef, "void"))
         return "";
 
-    std::list<Variable>::const_iterator arg = func->argumentList.begin();
+    BlockList<Variable>::const_iterator arg = func->argumentList.begin();
     for (; arg != func->argumentList.end(); ++arg) {
         if (arg->index() == targetpar-1)
             break;
@@ -2254,7 +2254,7 @@ void CheckMemoryLeakInClass::check()
     const std::size_t classes = symbolDatabase->classAndStructScopes.size();
     for (std::size_t i = 0; i < classes; ++i) {
         const Scope * scope = symbolDatabase->classAndStructScopes[i];
-        std::list<Variable>::const_iterator var;
+        BlockList<Variable>::const_iterator var;
         for (var = scope->varlist.begin(); var != scope->varlist.end(); ++var) {
             if (!var->isStatic() && var->isPointer()) {
                 // allocation but no deallocation of private variables in public function..
@@ -2286,7 +2286,7 @@ void CheckMemoryLeakInClass::variable(const Scope *scope, const Token *tokVarnam
     bool deallocInDestructor = false;
 
     // Inspect member functions
-    std::list<Function>::const_iterator func;
+    BlockList<Function>::const_iterator func;
     for (func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
         const bool constructor = func->isConstructor();
         const bool destructor = func->isDestructor();
@@ -2405,7 +2405,7 @@ void CheckMemoryLeakInClass::checkPublicFunctions(const Scope *scope, const Toke
 
     // Parse public functions..
     // If they allocate member variables, they should also deallocate
-    std::list<Function>::const_iterator func;
+    BlockList<Function>::const_iterator func;
 
     for (func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
         if ((func->type == Function::eFunction || func->type == Function::eOperatorEqual) &&
@@ -261,7 +261,7 @@ void CheckNullPointer::nullPointerLinkedList()
     //        if (tok->str() == "hello")
     //            tok = tok->next;   // <- tok might become a null pointer!
     //    }
-    for (std::list<Scope>::const_iterator i = symbolDatabase->scopeList.begin(); i != symbolDatabase->scopeList.end(); ++i) {
+    for (BlockList<Scope>::const_iterator i = symbolDatabase->scopeList.begin(); i != symbolDatabase->scopeList.end(); ++i) {
         const Token* const tok1 = i->classDef;
         // search for a "for" scope..
         if (i->type != Scope::eFor || !tok1)
@@ -316,10 +316,15 @@ void CheckNullPointer::nullPointerLinkedList()
 }
 
 void CheckNullPointer::nullPointerByDeRefAndChec()
+{
+    checkParts<CheckNullPointer, TokenRange>(functionParts(), &CheckNullPointer::nullPointerByDeRefAndChec);
+}
+
+void CheckNullPointer::nullPointerByDeRefAndChec(TokenRange range)
 {
     const bool printInconclusive = (_settings->inconclusive);
 
-    for (const Token *tok = _tokenizer->tokens(); tok; tok = tok->next()) {
+    for (const Token *tok = range.first; tok && tok != range.second; tok = tok->next()) {
         if (Token::Match(tok, "sizeof|decltype|typeid|typeof (")) {
             tok = tok->next()->link();
             continue;
@@ -131,6 +131,7 @@ private:
      * Dereferencing a pointer and then checking if it's NULL..
      */
     void nullPointerByDeRefAndChec();
+    void nullPointerByDeRefAndChec(TokenRange range);
 
     /** undefined null pointer arithmetic */
     void arithmetic();
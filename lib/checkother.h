@@ -81,29 +81,27 @@ public:
         checkOther.checkUnusedLabel();
         checkOther.checkEvaluationOrder();
         checkOther.checkFuncArgNamesDifferent();
-    }
-
-    /** @brief Run checks against the simplified token list */
-    void runSimplifiedChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) {
-        CheckOther checkOther(tokenizer, settings, errorLogger);
-
-        // Checks
         checkOther.clarifyCalculation();
         checkOther.clarifyStatement();
         checkOther.checkPassByReference();
         checkOther.checkIncompleteStatement();
         checkOther.checkCastIntToCharAndBack();
-
         checkOther.checkMisusedScopedObject();
         checkOther.checkPipeParameterSize();
-
-        checkOther.checkInvalidFree();
         checkOther.checkRedundantCopy();
         checkOther.checkSuspiciousEqualityComparison();
         checkOther.checkComparisonFunctionIsAlwaysTrueOrFalse();
         checkOther.checkAccessOfMovedVariable();
     }
 
+    /** @brief Run checks against the simplified token list */
+    void runSimplifiedChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) {
+        CheckOther checkOther(tokenizer, settings, errorLogger);
+
+        // Checks
+        checkOther.checkInvalidFree();
+    }
+
     /** @brief Clarify calculation for ".. a * b ? .." */
     void clarifyCalculation();
 
@@ -373,7 +373,7 @@ void CheckStl::stlOutOfBounds()
     const SymbolDatabase* const symbolDatabase = _tokenizer->getSymbolDatabase();
 
     // Scan through all scopes..
-    for (std::list<Scope>::const_iterator i = symbolDatabase->scopeList.begin(); i != symbolDatabase->scopeList.end(); ++i) {
+    for (BlockList<Scope>::const_iterator i = symbolDatabase->scopeList.begin(); i != symbolDatabase->scopeList.end(); ++i) {
         const Token* tok = i->classDef;
         // only interested in conditions
         if ((i->type != Scope::eFor && i->type != Scope::eWhile && i->type != Scope::eIf && i->type != Scope::eDo) || !tok)
@@ -441,7 +441,7 @@ void CheckStl::erase()
 {
     const SymbolDatabase* const symbolDatabase = _tokenizer->getSymbolDatabase();
 
-    for (std::list<Scope>::const_iterator i = symbolDatabase->scopeList.begin(); i != symbolDatabase->scopeList.end(); ++i) {
+    for (BlockList<Scope>::const_iterator i = symbolDatabase->scopeList.begin(); i != symbolDatabase->scopeList.end(); ++i) {
         if (i->type == Scope::eFor && Token::simpleMatch(i->classDef, "for (")) {
             const Token *tok = i->classDef->linkAt(1);
             if (!Token::Match(tok->tokAt(-3), "; ++| %var% ++| ) {"))
@@ -705,7 +705,7 @@ void CheckStl::if_find()
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
 
-    for (std::list<Scope>::const_iterator i = symbolDatabase->scopeList.begin(); i != symbolDatabase->scopeList.end(); ++i) {
+    for (BlockList<Scope>::const_iterator i = symbolDatabase->scopeList.begin(); i != symbolDatabase->scopeList.end(); ++i) {
         if ((i->type != Scope::eIf && i->type != Scope::eWhile) || !i->classDef)
             continue;
 
@@ -857,7 +857,7 @@ void CheckStl::redundantCondition()
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
 
-    for (std::list<Scope>::const_iterator i = symbolDatabase->scopeList.begin(); i != symbolDatabase->scopeList.end(); ++i) {
+    for (BlockList<Scope>::const_iterator i = symbolDatabase->scopeList.begin(); i != symbolDatabase->scopeList.end(); ++i) {
         if (i->type != Scope::eIf)
             continue;
 
@@ -896,7 +896,7 @@ void CheckStl::missingComparison()
 
     const SymbolDatabase* const symbolDatabase = _tokenizer->getSymbolDatabase();
 
-    for (std::list<Scope>::const_iterator i = symbolDatabase->scopeList.begin(); i != symbolDatabase->scopeList.end(); ++i) {
+    for (BlockList<Scope>::const_iterator i = symbolDatabase->scopeList.begin(); i != symbolDatabase->scopeList.end(); ++i) {
         if (i->type != Scope::eFor || !i->classDef)
             continue;
 
@@ -991,8 +991,8 @@ void CheckStl::string_c_str()
     // Find all functions that take std::string as argument
     std::multimap<std::string, unsigned int> c_strFuncParam;
     if (printPerformance) {
-        for (std::list<Scope>::const_iterator scope = symbolDatabase->scopeList.begin(); scope != symbolDatabase->scopeList.end(); ++scope) {
-            for (std::list<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
+        for (BlockList<Scope>::const_iterator scope = symbolDatabase->scopeList.begin(); scope != symbolDatabase->scopeList.end(); ++scope) {
+            for (BlockList<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
                 if (c_strFuncParam.erase(func->tokenDef->str()) != 0) { // Check if function with this name was already found
                     c_strFuncParam.insert(std::make_pair(func->tokenDef->str(), 0)); // Disable, because there are overloads. TODO: Handle overloads
                     continue;
@@ -1000,7 +1000,7 @@ void CheckStl::string_c_str()
 
                 unsigned int numpar = 0;
                 c_strFuncParam.insert(std::make_pair(func->tokenDef->str(), numpar)); // Insert function as dummy, to indicate that there is at least one function with that name
-                for (std::list<Variable>::const_iterator var = func->argumentList.cbegin(); var != func->argumentList.cend(); ++var) {
+                for (BlockList<Variable>::const_iterator var = func->argumentList.cbegin(); var != func->argumentList.cend(); ++var) {
                     numpar++;
                     if (var->isStlStringType() && (!var->isReference() || var->isConst()))
                         c_strFuncParam.insert(std::make_pair(func->tokenDef->str(), numpar));
@@ -1010,7 +1010,7 @@ void CheckStl::string_c_str()
     }
 
     // Try to detect common problems when using string::c_str()
-    for (std::list<Scope>::const_iterator scope = symbolDatabase->scopeList.begin(); scope != symbolDatabase->scopeList.end(); ++scope) {
+    for (BlockList<Scope>::const_iterator scope = symbolDatabase->scopeList.begin(); scope != symbolDatabase->scopeList.end(); ++scope) {
         if (scope->type != Scope::eFunction || !scope->function)
             continue;
 
@@ -1198,7 +1198,7 @@ void CheckStl::checkAutoPointer()
 {
     std::set<unsigned int> autoPtrVarId;
     std::map<unsigned int, const std::string> mallocVarId; // variables allocated by the malloc-like function
-    const char STL_CONTAINER_LIST[] = "array|bitset|deque|list|forward_list|map|multimap|multiset|priority_queue|queue|set|stack|vector|hash_map|hash_multimap|hash_set|unordered_map|unordered_multimap|unordered_set|unordered_multiset|basic_string";
+    static const char STL_CONTAINER_LIST[] = "array|bitset|deque|list|forward_list|map|multimap|multiset|priority_queue|queue|set|stack|vector|hash_map|hash_multimap|hash_set|unordered_map|unordered_multimap|unordered_set|unordered_multiset|basic_string";
     const int malloc = _settings->library.allocId("malloc"); // allocation function, which are not compatible with auto_ptr
     const bool printStyle = _settings->isEnabled(Settings::STYLE);
 
@@ -1414,8 +1414,8 @@ void CheckStl::checkDereferenceInvalidIterator()
 
     // Iterate over "if", "while", and "for" conditions where there may
     // be an iterator that is dereferenced before being checked for validity.
-    const std::list<Scope>& scopeList = _tokenizer->getSymbolDatabase()->scopeList;
-    for (std::list<Scope>::const_iterator i = scopeList.begin(); i != scopeList.end(); ++i) {
+    const BlockList<Scope>& scopeList = _tokenizer->getSymbolDatabase()->scopeList;
+    for (BlockList<Scope>::const_iterator i = scopeList.begin(); i != scopeList.end(); ++i) {
         if (!(i->type == Scope::eIf || i->type == Scope::eDo || i->type == Scope::eWhile || i->type == Scope::eFor))
             continue;
 
@@ -1529,9 +1529,9 @@ void CheckStl::readingEmptyStlContainer()
 
     std::map<unsigned int, const Library::Container*> emptyContainer;
 
-    const std::list<Scope>& scopeList = _tokenizer->getSymbolDatabase()->scopeList;
+    const BlockList<Scope>& scopeList = _tokenizer->getSymbolDatabase()->scopeList;
 
-    for (std::list<Scope>::const_iterator i = scopeList.begin(); i != scopeList.end(); ++i) {
+    for (BlockList<Scope>::const_iterator i = scopeList.begin(); i != scopeList.end(); ++i) {
         if (i->type != Scope::eFunction)
             continue;
 
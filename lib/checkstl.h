@@ -53,8 +53,8 @@ public:
         : Check(myName(), tokenizer, settings, errorLogger) {
     }
 
-    /** Simplified checks. The token list is simplified. */
-    void runSimplifiedChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) {
+    /** Checks that uses the normal token list */
+    void runChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) {
         if (!tokenizer->isCPP())
             return;
 
@@ -68,7 +68,6 @@ public:
         checkStl.stlBoundaries();
         checkStl.if_find();
         checkStl.string_c_str();
-        checkStl.checkAutoPointer();
         checkStl.uselessCalls();
         checkStl.checkDereferenceInvalidIterator();
 
@@ -79,6 +78,15 @@ public:
         checkStl.readingEmptyStlContainer();
     }
 
+    /** Simplified checks. The token list is simplified. */
+    void runSimplifiedChecks(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger) {
+        if (!tokenizer->isCPP())
+            return;
+
+        CheckStl checkStl(tokenizer, settings, errorLogger);
+        checkStl.checkAutoPointer();
+    }
+
 
     /**
      * Finds errors like this:
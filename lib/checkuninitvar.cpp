@@ -37,6 +37,7 @@
 #include <map>
 #include <stack>
 #include <utility>
+#include <vector>
 //---------------------------------------------------------------------------
 
 // Register this check class (by creating a static instance of it)
@@ -46,6 +47,22 @@ namespace {
 
 //---------------------------------------------------------------------------
 
+namespace {
+    /** Calls CheckUninitVar::checkScope() for the scopes given to Check::checkParts() */
+    class ScopeChecker {
+    public:
+        explicit ScopeChecker(const std::set<std::string> &arrayTypeDefs) : _arrayTypeDefs(arrayTypeDefs) {
+        }
+        void operator()(CheckUninitVar &check, const Scope *scope) const {
+            check.checkScope(scope, _arrayTypeDefs);
+        }
+    private:
+        const std::set<std::string> &_arrayTypeDefs;
+    };
+}
+
+//---------------------------------------------------------------------------
+
 // CWE ids used:
 static const struct CWE CWE676(676U);
 static const struct CWE CWE908(908U);
@@ -55,7 +72,7 @@ static const struct CWE CWE825(825U);
 void CheckUninitVar::check()
 {
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
-    std::list<Scope>::const_iterator scope;
+    BlockList<Scope>::const_iterator scope;
 
     std::set<std::string> arrayTypeDefs;
     for (const Token *tok = _tokenizer->tokens(); tok; tok = tok->next()) {
@@ -64,16 +81,17 @@ void CheckUninitVar::check()
     }
 
     // check every executable scope
+    std::vector<const Scope *> scopes;
     for (scope = symbolDatabase->scopeList.begin(); scope != symbolDatabase->scopeList.end(); ++scope) {
-        if (scope->isExecutable()) {
-            checkScope(&*scope, arrayTypeDefs);
-        }
+        if (scope->isExecutable())
+            scopes.push_back(&*scope);
     }
+    checkParts<CheckUninitVar>(scopes, ScopeChecker(arrayTypeDefs));
 }
 
 void CheckUninitVar::checkScope(const Scope* scope, const std::set<std::string> &arrayTypeDefs)
 {
-    for (std::list<Variable>::const_iterator i = scope->varlist.begin(); i != scope->varlist.end(); ++i) {
+    for (BlockList<Variable>::const_iterator i = scope->varlist.begin(); i != scope->varlist.end(); ++i) {
         if ((_tokenizer->isCPP() && i->type() && !i->isPointer() && i->type()->needInitialization != Type::True) ||
             i->isStatic() || i->isExtern() || i->isReference())
             continue;
@@ -163,7 +181,7 @@ void CheckUninitVar::checkStruct(const Token *tok, const Variable &structvar)
     for (std::size_t j = 0U; j < symbolDatabase->classAndStructScopes.size(); ++j) {
         const Scope *scope2 = symbolDatabase->classAndStructScopes[j];
         if (scope2->className == typeToken->str() && scope2->numConstructors == 0U) {
-            for (std::list<Variable>::const_iterator it = scope2->varlist.begin(); it != scope2->varlist.end(); ++it) {
+            for (BlockList<Variable>::const_iterator it = scope2->varlist.begin(); it != scope2->varlist.end(); ++it) {
                 const Variable &var = *it;
 
                 if (var.hasDefault() || var.isArray() || (!_tokenizer->isC() && var.isClass() && (!var.type() || var.type()->needInitialization != Type::True)))
@@ -171,7 +189,7 @@ void CheckUninitVar::checkStruct(const Token *tok, const Variable &structvar)
 
                 // is the variable declared in a inner union?
                 bool innerunion = false;
-                for (std::list<Scope>::const_iterator it2 = symbolDatabase->scopeList.begin(); it2 != symbolDatabase->scopeList.end(); ++it2) {
+                for (BlockList<Scope>::const_iterator it2 = symbolDatabase->scopeList.begin(); it2 != symbolDatabase->scopeList.end(); ++it2) {
                     const Scope &innerScope = *it2;
                     if (innerScope.type == Scope::eUnion && innerScope.nestedIn == scope2) {
                         if (var.typeStartToken()->linenr() >= innerScope.classStart->linenr() &&
@@ -1233,7 +1251,7 @@ void CheckUninitVar::valueFlowUninit()
         return;
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
-    std::list<Scope>::const_iterator scope;
+    BlockList<Scope>::const_iterator scope;
 
     // check every executable scope
     for (scope = symbolDatabase->scopeList.begin(); scope != symbolDatabase->scopeList.end(); ++scope) {
@@ -1255,7 +1273,7 @@ void CheckUninitVar::valueFlowUninit()
 void CheckUninitVar::deadPointer()
 {
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
-    std::list<Scope>::const_iterator scope;
+    BlockList<Scope>::const_iterator scope;
 
     // check every executable scope
     for (scope = symbolDatabase->scopeList.begin(); scope != symbolDatabase->scopeList.end(); ++scope) {
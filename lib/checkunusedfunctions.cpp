@@ -20,6 +20,7 @@
 //---------------------------------------------------------------------------
 #include "checkunusedfunctions.h"
 
+#include "analyzerinfo.h"
 #include "errorlogger.h"
 #include "library.h"
 #include "settings.h"
@@ -330,41 +331,28 @@ void CheckUnusedFunctions::analyseWholeProgram(ErrorLogger * const errorLogger,
     std::map<std::string, Location> decls;
     std::set<std::string> calls;
 
-    const std::string filesTxt(buildDir + "/files.txt");
-    std::ifstream fin(filesTxt.c_str());
-    std::string filesTxtLine;
-    while (std::getline(fin, filesTxtLine)) {
-        const std::string::size_type firstColon = filesTxtLine.find(':');
-        if (firstColon == std::string::npos)
-            continue;
-        const std::string::size_type lastColon = filesTxtLine.rfind(':');
-        if (firstColon == lastColon)
-            continue;
-        const std::string xmlfile = buildDir + '/' + filesTxtLine.substr(0,firstColon);
-        const std::string sourcefile = filesTxtLine.substr(lastColon+1);
-
-        tinyxml2::XMLDocument doc;
-        tinyxml2::XMLError error = doc.LoadFile(xmlfile.c_str());
-        if (error != tinyxml2::XML_SUCCESS)
-            continue;
-
-        const tinyxml2::XMLElement * const rootNode = doc.FirstChildElement();
-        if (rootNode == nullptr)
+    const AnalyzerDatabase &database = AnalyzerDatabase::instance(buildDir);
+    const std::map<std::string, std::string> filesTxt(AnalyzerInformation::readFilesTxt(buildDir));
+    for (std::map<std::string, std::string>::const_iterator f = filesTxt.begin(); f != filesTxt.end(); ++f) {
+        const std::string::size_type colon = f->first.find(':');
+        const std::string sourcefile = f->first.substr(colon + 1);
+        AnalyzerDatabase::FileData fileData;
+        if (!database.find(sourcefile, f->first.substr(0, colon), &fileData))
             continue;
 
-        for (const tinyxml2::XMLElement *e = rootNode->FirstChildElement(); e; e = e->NextSiblingElement()) {
-            if (std::strcmp(e->Name(), "FileInfo") == 0) {
-                const char *checkattr = e->Attribute("check");
-                if (checkattr && std::strcmp(checkattr,"CheckUnusedFunctions")==0) {
-                    for (const tinyxml2::XMLElement *e2 = e->FirstChildElement(); e2; e2 = e2->NextSiblingElement()) {
-                        if (!e2->Attribute("functionName"))
-                            continue;
-                        if (std::strcmp(e2->Name(),"functiondecl")==0 && e2->Attribute("lineNumber")) {
-                            decls[e2->Attribute("functionName")] = Location(sourcefile, std::atoi(e2->Attribute("lineNumber")));
-                        } else if (std::strcmp(e2->Name(),"functioncall")==0) {
-                            calls.insert(e2->Attribute("functionName"));
-                        }
-                    }
+        for (std::list<std::pair<std::string, std::string> >::const_iterator fi = fileData.fileInfo.begin(); fi != fileData.fileInfo.end(); ++fi) {
+            if (fi->first != "CheckUnusedFunctions")
+                continue;
+            tinyxml2::XMLDocument doc;
+            if (!AnalyzerDatabase::parseFileInfo(*fi, &doc))
+                continue;
+            for (const tinyxml2::XMLElement *e2 = doc.FirstChildElement()->FirstChildElement(); e2; e2 = e2->NextSiblingElement()) {
+                if (!e2->Attribute("functionName"))
+                    continue;
+                if (std::strcmp(e2->Name(),"functiondecl")==0 && e2->Attribute("lineNumber")) {
+                    decls[e2->Attribute("functionName")] = Location(sourcefile, std::atoi(e2->Attribute("lineNumber")));
+                } else if (std::strcmp(e2->Name(),"functioncall")==0) {
+                    calls.insert(e2->Attribute("functionName"));
                 }
             }
         }
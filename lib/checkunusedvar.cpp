@@ -719,7 +719,7 @@ void CheckUnusedVar::checkFunctionVariableUsage_iterateScopes(const Scope* const
     // Find declarations if the scope is executable..
     if (scope->isExecutable()) {
         // Find declarations
-        for (std::list<Variable>::const_iterator i = scope->varlist.begin(); i != scope->varlist.end(); ++i) {
+        for (BlockList<Variable>::const_iterator i = scope->varlist.begin(); i != scope->varlist.end(); ++i) {
             if (i->isThrow() || i->isExtern())
                 continue;
             Variables::VariableType type = Variables::none;
@@ -1310,7 +1310,7 @@ void CheckUnusedVar::checkStructMemberUsage()
 
     const SymbolDatabase *symbolDatabase = _tokenizer->getSymbolDatabase();
 
-    for (std::list<Scope>::const_iterator scope = symbolDatabase->scopeList.cbegin(); scope != symbolDatabase->scopeList.cend(); ++scope) {
+    for (BlockList<Scope>::const_iterator scope = symbolDatabase->scopeList.cbegin(); scope != symbolDatabase->scopeList.cend(); ++scope) {
         if (scope->type != Scope::eStruct && scope->type != Scope::eUnion)
             continue;
 
@@ -1327,7 +1327,7 @@ void CheckUnusedVar::checkStructMemberUsage()
 
         // bail out if struct is inherited
         bool bailout = false;
-        for (std::list<Scope>::const_iterator i = symbolDatabase->scopeList.cbegin(); i != symbolDatabase->scopeList.cend(); ++i) {
+        for (BlockList<Scope>::const_iterator i = symbolDatabase->scopeList.cbegin(); i != symbolDatabase->scopeList.cend(); ++i) {
             if (i->definedType) {
                 for (size_t j = 0; j < i->definedType->derivedFrom.size(); j++) {
                     if (i->definedType->derivedFrom[j].type == scope->definedType) {
@@ -1371,7 +1371,7 @@ void CheckUnusedVar::checkStructMemberUsage()
         if (Token::findmatch(scope->classEnd, (scope->className + " %type%| *").c_str()))
             continue;
 
-        for (std::list<Variable>::const_iterator var = scope->varlist.cbegin(); var != scope->varlist.cend(); ++var) {
+        for (BlockList<Variable>::const_iterator var = scope->varlist.cbegin(); var != scope->varlist.cend(); ++var) {
             // declaring a POD member variable?
             if (!var->typeStartToken()->isStandardType() && !var->isPointer())
                 continue;
@@ -43,6 +43,7 @@
 #ifdef HAVE_RULES
 #define PCRE_STATIC
 #include <pcre.h>
+#include <mutex>
 #endif
 
 static const char Version[] = CPPCHECK_VERSION_STRING;
@@ -53,18 +54,100 @@ static TimerResults S_timerResults;
 // CWE ids used
 static const CWE CWE398(398U);  // Indicator of Poor Code Quality
 
+#ifdef HAVE_RULES
+namespace {
+    /** A rule pattern that is compiled and studied */
+    struct CompiledRule {
+        CompiledRule() : re(nullptr), extra(nullptr) {}
+        pcre *re;
+        pcre_extra *extra;
+        /** error message if the pattern could not be compiled */
+        std::string error;
+    };
+
+    /**
+     * Compiled rules. Each pattern is compiled once and then shared by all
+     * files, configurations and threads.
+     */
+    class CompiledRules {
+    public:
+        ~CompiledRules() {
+            for (std::map<std::string, CompiledRule>::iterator it = _rules.begin(); it != _rules.end(); ++it) {
+                if (it->second.extra) {
+#ifdef PCRE_STUDY_JIT_COMPILE
+                    pcre_free_study(it->second.extra);
+#else
+                    pcre_free(it->second.extra);
+#endif
+                }
+                if (it->second.re)
+                    pcre_free(it->second.re);
+            }
+        }
+
+        const CompiledRule &get(const std::string &pattern) {
+            std::lock_guard<std::mutex> lock(_sync);
+            const std::map<std::string, CompiledRule>::iterator it = _rules.find(pattern);
+            if (it != _rules.end())
+                return it->second;
+
+            CompiledRule &rule = _rules[pattern];
+            const char *error = nullptr;
+            int erroffset = 0;
+            rule.re = pcre_compile(pattern.c_str(), 0, &error, &erroffset, nullptr);
+            if (!rule.re) {
+                if (error)
+                    rule.error = error;
+                return rule;
+            }
+#ifdef PCRE_STUDY_JIT_COMPILE
+            const int options = PCRE_STUDY_JIT_COMPILE;
+#else
+            const int options = 0;
+#endif
+            rule.extra = pcre_study(rule.re, options, &error);
+            return rule;
+        }
+
+    private:
+        std::map<std::string, CompiledRule> _rules;
+        std::mutex _sync;
+    };
+
+    CompiledRules compiledRules;
+}
+#endif
+
 CppCheck::CppCheck(ErrorLogger &errorLogger, bool useGlobalSuppressions)
-    : _errorLogger(errorLogger), exitcode(0), _useGlobalSuppressions(useGlobalSuppressions), tooManyConfigs(false), _simplify(true)
+    : _settings(_ownSettings), _acceptedFile(true), _errorLogger(errorLogger), exitcode(0), _useGlobalSuppressions(useGlobalSuppressions), tooManyConfigs(false), _simplify(true)
 {
 }
 
+CppCheck::CppCheck(ErrorLogger &errorLogger, bool useGlobalSuppressions, const Settings &sharedSettings)
+    : _settings(sharedSettings), _acceptedFile(true), _errorLogger(errorLogger), exitcode(0), _useGlobalSuppressions(useGlobalSuppressions), tooManyConfigs(false), _simplify(true)
+{
+    _ownSettings.nomsg = sharedSettings.nomsg;
+    _ownSettings.nofail = sharedSettings.nofail;
+}
+
 CppCheck::~CppCheck()
 {
     while (!fileInfo.empty()) {
         delete fileInfo.back();
         fileInfo.pop_back();
     }
-    S_timerResults.ShowResults(_settings.showtime);
+}
+
+bool CppCheck::showTimerResults(SHOWTIME_MODES mode, const std::string &jsonFile)
+{
+    if (mode != SHOWTIME_JSON) {
+        S_timerResults.ShowResults(mode);
+        return true;
+    }
+
+    std::ofstream fout(jsonFile);
+    S_timerResults.writeJson(fout);
+    return fout.good();
 }
 
 const char * CppCheck::version()
@@ -79,6 +162,8 @@ const char * CppCheck::extraVersion()
 
 unsigned int CppCheck::check(const std::string &path)
 {
+    if (skipUnchangedFile(Path::simplifyPath(path), emptyString))
+        return exitcode;
     std::ifstream fin(path.c_str());
     return processFile(Path::simplifyPath(path), emptyString, fin);
 }
@@ -92,24 +177,73 @@ unsigned int CppCheck::check(const std::string &path, const std::string &content
 unsigned int CppCheck::check(const ImportProject::FileSettings &fs)
 {
     CppCheck temp(_errorLogger, _useGlobalSuppressions);
-    temp._settings = _settings;
-    temp._settings.userDefines = fs.cppcheckDefines();
-    temp._settings.includePaths = fs.includePaths;
-    // TODO: temp._settings.userUndefs = fs.undefs;
+    temp._ownSettings = _settings;
+    temp._ownSettings.nomsg = _ownSettings.nomsg;
+    temp._ownSettings.nofail = _ownSettings.nofail;
+    temp._ownSettings.userDefines = fs.cppcheckDefines();
+    temp._ownSettings.includePaths = fs.includePaths;
+    // TODO: temp._ownSettings.userUndefs = fs.undefs;
     if (fs.platformType != Settings::Unspecified) {
-        temp._settings.platform(fs.platformType);
+        temp._ownSettings.platform(fs.platformType);
     }
+    if (temp.skipUnchangedFile(Path::simplifyPath(fs.filename), fs.cfg))
+        return temp.exitcode;
     std::ifstream fin(fs.filename.c_str());
     return temp.processFile(Path::simplifyPath(fs.filename), fs.cfg, fin);
 }
 
+std::string CppCheck::toolInfo() const
+{
+    std::string toolinfo;
+    toolinfo += CPPCHECK_VERSION_STRING;
+    toolinfo += _settings.isEnabled(Settings::WARNING) ? 'w' : ' ';
+    toolinfo += _settings.isEnabled(Settings::STYLE) ? 's' : ' ';
+    toolinfo += _settings.isEnabled(Settings::PERFORMANCE) ? 'p' : ' ';
+    toolinfo += _settings.isEnabled(Settings::PORTABILITY) ? 'p' : ' ';
+    toolinfo += _settings.isEnabled(Settings::INFORMATION) ? 'i' : ' ';
+    toolinfo += MathLib::toString(_settings.valueFlowMaxValues);
+    toolinfo += _settings.userDefines;
+    return toolinfo;
+}
+
+std::string CppCheck::buildDirSettings() const
+{
+    std::string ret(toolInfo());
+    ret += '\n';
+    ret += _settings.platformString();
+    for (std::list<std::string>::const_iterator it = _settings.includePaths.begin(); it != _settings.includePaths.end(); ++it)
+        ret += "\n-I" + *it;
+    for (std::list<std::string>::const_iterator it = _settings.userIncludes.begin(); it != _settings.userIncludes.end(); ++it)
+        ret += "\n--include=" + *it;
+    for (std::set<std::string>::const_iterator it = _settings.userUndefs.begin(); it != _settings.userUndefs.end(); ++it)
+        ret += "\n-U" + *it;
+    return ret;
+}
+
+bool CppCheck::skipUnchangedFile(const std::string &filename, const std::string &cfgname)
+{
+    // The output files are only written when the file is analyzed
+    if (_settings.buildDir.empty() || _settings.dump || !_settings.plistOutput.empty() || _settings.checkConfiguration)
+        return false;
+
+    exitcode = 0;
+    std::list<ErrorLogger::ErrorMessage> errors;
+    if (!AnalyzerInformation::isUnchanged(_settings.buildDir, filename, cfgname, AnalyzerInformation::settingsChecksum(buildDirSettings()), &errors))
+        return false;
+
+    while (!errors.empty()) {
+        reportErr(errors.front());
+        errors.pop_front();
+    }
+    return true;
+}
+
 unsigned int CppCheck::processFile(const std::string& filename, const std::string &cfgname, std::istream& fileStream)
 {
     exitcode = 0;
 
     // only show debug warnings for accepted C/C++ source files
-    if (!Path::acceptFile(filename))
-        _settings.debugwarnings = false;
+    _acceptedFile = Path::acceptFile(filename);
 
     if (_settings.terminated())
         return exitcode;
@@ -138,7 +272,7 @@ unsigned int CppCheck::processFile(const std::string& filename, const std::strin
 
     bool internalErrorFound(false);
     try {
-        Preprocessor preprocessor(_settings, this);
+        Preprocessor preprocessor(_settings, _ownSettings.nomsg, this);
         std::set<std::string> configurations;
 
         simplecpp::OutputList outputList;
@@ -213,20 +347,11 @@ unsigned int CppCheck::processFile(const std::string& filename, const std::strin
         preprocessor.removeComments();
 
         if (!_settings.buildDir.empty()) {
-            // Get toolinfo
-            std::string toolinfo;
-            toolinfo += CPPCHECK_VERSION_STRING;
-            toolinfo += _settings.isEnabled(Settings::WARNING) ? 'w' : ' ';
-            toolinfo += _settings.isEnabled(Settings::STYLE) ? 's' : ' ';
-            toolinfo += _settings.isEnabled(Settings::PERFORMANCE) ? 'p' : ' ';
-            toolinfo += _settings.isEnabled(Settings::PORTABILITY) ? 'p' : ' ';
-            toolinfo += _settings.isEnabled(Settings::INFORMATION) ? 'i' : ' ';
-            toolinfo += _settings.userDefines;
-
             // Calculate checksum so it can be compared with old checksum / future checksums
-            const unsigned int checksum = preprocessor.calculateChecksum(tokens1, toolinfo);
+            const unsigned int checksum = preprocessor.calculateChecksum(tokens1, toolInfo());
+            const unsigned long long settingsChecksum = AnalyzerInformation::settingsChecksum(buildDirSettings());
             std::list<ErrorLogger::ErrorMessage> errors;
-            if (!analyzerInformation.analyzeFile(_settings.buildDir, filename, cfgname, checksum, &errors)) {
+            if (!analyzerInformation.analyzeFile(_settings.buildDir, filename, cfgname, checksum, settingsChecksum, files, _settings.includePaths, &errors)) {
                 while (!errors.empty()) {
                     reportErr(errors.front());
                     errors.pop_front();
@@ -282,7 +407,10 @@ unsigned int CppCheck::processFile(const std::string& filename, const std::strin
             }
         }
 
+        std::set<unsigned long long> preprocessedHashes;
+        std::set<unsigned long long> tokenListChecksums;
         std::set<unsigned long long> checksums;
+        simplecpp::MacroSnapshots macroSnapshots;
         unsigned int checkCount = 0;
         for (std::set<std::string>::const_iterator it = configurations.begin(); it != configurations.end(); ++it) {
             // bail out if terminated
@@ -329,6 +457,24 @@ unsigned int CppCheck::processFile(const std::string& filename, const std::strin
                 continue;
             }
 
+            Timer timerPreprocess("Preprocessor::preprocess", _settings.showtime, &S_timerResults);
+            const simplecpp::TokenList &tokensP = preprocessor.preprocess(tokens1, cfg, files, &macroSnapshots);
+            timerPreprocess.Stop();
+            if (tokensP.empty())
+                continue;
+
+            // Skip the configuration without tokenizing it if an earlier
+            // configuration gave the same preprocessor output
+            if ((_settings.force || _settings.maxConfigs > 1) && !_settings.dump) {
+                if (!preprocessedHashes.insert(Preprocessor::calculateHash(tokensP)).second) {
+                    if (_settings.isEnabled(Settings::INFORMATION) && (_settings.debug || _settings.verbose))
+                        purgedConfigurationMessage(filename, cfg);
+                    if (_settings.showtime != SHOWTIME_NONE)
+                        S_timerResults.AddCount("Configurations skipped (same preprocessor output)");
+                    continue;
+                }
+            }
+
             Tokenizer _tokenizer(&_settings, this);
             if (_settings.showtime != SHOWTIME_NONE)
                 _tokenizer.setTimerResults(&S_timerResults);
@@ -338,16 +484,23 @@ unsigned int CppCheck::processFile(const std::string& filename, const std::strin
 
                 // Create tokens, skip rest of iteration if failed
                 Timer timer("Tokenizer::createTokens", _settings.showtime, &S_timerResults);
-                const simplecpp::TokenList &tokensP = preprocessor.preprocess(tokens1, cfg, files);
                 _tokenizer.createTokens(&tokensP);
                 timer.Stop();
-                if (tokensP.empty())
-                    continue;
 
                 // skip rest of iteration if just checking configuration
                 if (_settings.checkConfiguration)
                     continue;
 
+                // Skip the configuration before the token list is simplified if an
+                // earlier configuration gave the same tokens
+                if ((_settings.force || _settings.maxConfigs > 1) && !_settings.dump) {
+                    if (!tokenListChecksums.insert(_tokenizer.list.calculateChecksum()).second) {
+                        if (_settings.isEnabled(Settings::INFORMATION) && (_settings.debug || _settings.verbose))
+                            purgedConfigurationMessage(filename, cfg);
+                        continue;
+                    }
+                }
+
                 // Check raw tokens
                 checkRawTokens(_tokenizer);
 
@@ -385,7 +538,7 @@ unsigned int CppCheck::processFile(const std::string& filename, const std::strin
                     checkUnusedFunctions.parseTokens(_tokenizer, filename.c_str(), &_settings, false);
 
                 // simplify more if required, skip rest of iteration if failed
-                if (_simplify) {
+                if (_simplify && _settings.simplifiedChecks) {
                     // if further simplification fails then skip rest of iteration
                     Timer timer3("Tokenizer::simplifyTokenList2", _settings.showtime, &S_timerResults);
                     result = _tokenizer.simplifyTokenList2();
@@ -442,7 +595,7 @@ unsigned int CppCheck::processFile(const std::string& filename, const std::strin
     // In jointSuppressionReport mode, unmatched suppressions are
     // collected after all files are processed
     if (!_settings.jointSuppressionReport && (_settings.isEnabled(Settings::INFORMATION) || _settings.checkConfiguration)) {
-        reportUnmatchedSuppressions(_settings.nomsg.getUnmatchedLocalSuppressions(filename, isUnusedFunctionCheckEnabled()));
+        reportUnmatchedSuppressions(_ownSettings.nomsg.getUnmatchedLocalSuppressions(filename, isUnusedFunctionCheckEnabled()));
     }
 
     _errorList.clear();
@@ -555,26 +708,30 @@ void CppCheck::executeRules(const std::string &tokenlist, const Tokenizer &token
     if (isrule == false)
         return;
 
-    // Write all tokens in a string that can be parsed by pcre
-    std::ostringstream ostr;
-    for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next())
-        ostr << " " << tok->str();
-    const std::string str(ostr.str());
+    // Write all tokens in a string that can be parsed by pcre. Remember
+    // where each token starts so a match can be mapped to a token.
+    std::string str;
+    std::vector<std::size_t> tokenOffsets;
+    std::vector<const Token *> tokens;
+    for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
+        tokenOffsets.push_back(str.size());
+        tokens.push_back(tok);
+        str += ' ';
+        str += tok->str();
+    }
 
     for (std::list<Settings::Rule>::const_iterator it = _settings.rules.begin(); it != _settings.rules.end(); ++it) {
         const Settings::Rule &rule = *it;
         if (rule.pattern.empty() || rule.id.empty() || rule.severity == Severity::none || rule.tokenlist != tokenlist)
             continue;
 
-        const char *error = nullptr;
-        int erroffset = 0;
-        pcre *re = pcre_compile(rule.pattern.c_str(),0,&error,&erroffset,nullptr);
-        if (!re) {
-            if (error) {
+        const CompiledRule &compiledRule = compiledRules.get(rule.pattern);
+        if (!compiledRule.re) {
+            if (!compiledRule.error.empty()) {
                 ErrorLogger::ErrorMessage errmsg(std::list<ErrorLogger::ErrorMessage::FileLocation>(),
                                                  emptyString,
                                                  Severity::error,
-                                                 error,
+                                                 compiledRule.error,
                                                  "pcre_compile",
                                                  false);
 
@@ -585,26 +742,24 @@ void CppCheck::executeRules(const std::string &tokenlist, const Tokenizer &token
 
         int pos = 0;
         int ovector[30]= {0};
-        while (pos < (int)str.size() && 0 <= pcre_exec(re, nullptr, str.c_str(), (int)str.size(), pos, 0, ovector, 30)) {
+        while (pos < (int)str.size() && 0 <= pcre_exec(compiledRule.re, compiledRule.extra, str.c_str(), (int)str.size(), pos, 0, ovector, 30)) {
             const unsigned int pos1 = (unsigned int)ovector[0];
             const unsigned int pos2 = (unsigned int)ovector[1];
 
-            // jump to the end of the match for the next pcre_exec
-            pos = (int)pos2;
+            // jump to the end of the match for the next pcre_exec, an empty match must not be found again
+            pos = (pos2 > pos1) ? (int)pos2 : (int)pos2 + 1;
 
             // determine location..
             ErrorLogger::ErrorMessage::FileLocation loc;
             loc.setfile(tokenizer.list.getSourceFilePath());
             loc.line = 0;
 
-            std::size_t len = 0;
-            for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
-                len = len + 1U + tok->str().size();
-                if (len > pos1) {
-                    loc.setfile(tokenizer.list.getFiles().at(tok->fileIndex()));
-                    loc.line = tok->linenr();
-                    break;
-                }
+            // the token that contains the first matched character
+            const std::vector<std::size_t>::const_iterator tokenOffset = std::upper_bound(tokenOffsets.begin(), tokenOffsets.end(), (std::size_t)pos1);
+            if (tokenOffset != tokenOffsets.begin()) {
+                const Token *tok = tokens[(tokenOffset - tokenOffsets.begin()) - 1];
+                loc.setfile(tokenizer.list.getFiles().at(tok->fileIndex()));
+                loc.line = tok->linenr();
             }
 
             const std::list<ErrorLogger::ErrorMessage::FileLocation> callStack(1, loc);
@@ -620,15 +775,13 @@ void CppCheck::executeRules(const std::string &tokenlist, const Tokenizer &token
             // Report error
             reportErr(errmsg);
         }
-
-        pcre_free(re);
     }
 #endif
 }
 
 Settings &CppCheck::settings()
 {
-    return _settings;
+    return _ownSettings;
 }
 
 void CppCheck::tooManyConfigsError(const std::string &file, const std::size_t numberOfConfigurations)
@@ -700,15 +853,17 @@ void CppCheck::purgedConfigurationMessage(const std::string &file, const std::st
 
 void CppCheck::reportErr(const ErrorLogger::ErrorMessage &msg)
 {
+    if (msg._severity == Severity::debug && _settings.debugwarnings && !_acceptedFile)
+        return;
+
     if (!_settings.library.reportErrors(msg.file0))
         return;
 
-    const std::string errmsg = msg.toString(_settings.verbose);
-    if (errmsg.empty())
+    if (msg._callStack.empty() && msg._severity == Severity::none && (_settings.verbose ? msg.verboseMessage() : msg.shortMessage()).empty())
         return;
 
     // Alert only about unique errors
-    if (std::find(_errorList.begin(), _errorList.end(), errmsg) != _errorList.end())
+    if (_errorList.contains(msg, _settings.verbose))
         return;
 
     std::string file;
@@ -719,17 +874,17 @@ void CppCheck::reportErr(const ErrorLogger::ErrorMessage &msg)
     }
 
     if (_useGlobalSuppressions) {
-        if (_settings.nomsg.isSuppressed(msg._id, file, line))
+        if (_ownSettings.nomsg.isSuppressed(msg._id, file, line))
             return;
     } else {
-        if (_settings.nomsg.isSuppressedLocal(msg._id, file, line))
+        if (_ownSettings.nomsg.isSuppressedLocal(msg._id, file, line))
             return;
     }
 
-    if (!_settings.nofail.isSuppressed(msg._id, file, line) && !_settings.nomsg.isSuppressed(msg._id, file, line))
+    if (!_ownSettings.nofail.isSuppressed(msg._id, file, line) && !_ownSettings.nomsg.isSuppressed(msg._id, file, line))
         exitcode = 1;
 
-    _errorList.push_back(errmsg);
+    _errorList.insert(msg, _settings.verbose);
 
     _errorLogger.reportErr(msg);
     analyzerInformation.reportErr(msg, _settings.verbose);
@@ -758,10 +913,10 @@ void CppCheck::reportInfo(const ErrorLogger::ErrorMessage &msg)
         line = msg._callStack.back().line;
     }
     if (_useGlobalSuppressions) {
-        if (_settings.nomsg.isSuppressed(msg._id, file, line))
+        if (_ownSettings.nomsg.isSuppressed(msg._id, file, line))
             return;
     } else {
-        if (_settings.nomsg.isSuppressedLocal(msg._id, file, line))
+        if (_ownSettings.nomsg.isSuppressedLocal(msg._id, file, line))
             return;
     }
 
@@ -804,42 +959,27 @@ void CppCheck::analyseWholeProgram(const std::string &buildDir, const std::map<s
     (void)files;
     if (buildDir.empty())
         return;
+    AnalyzerDatabase &database = AnalyzerDatabase::instance(buildDir);
+    database.save();
     if (_settings.isEnabled(Settings::UNUSED_FUNCTION))
         CheckUnusedFunctions::analyseWholeProgram(this, buildDir);
     std::list<Check::FileInfo*> fileInfoList;
 
     // Load all analyzer info data..
-    const std::string filesTxt(buildDir + "/files.txt");
-    std::ifstream fin(filesTxt.c_str());
-    std::string filesTxtLine;
-    while (std::getline(fin, filesTxtLine)) {
-        const std::string::size_type firstColon = filesTxtLine.find(':');
-        if (firstColon == std::string::npos)
-            continue;
-        const std::string::size_type lastColon = filesTxtLine.rfind(':');
-        if (firstColon == lastColon)
-            continue;
-        const std::string xmlfile = buildDir + '/' + filesTxtLine.substr(0,firstColon);
-        //const std::string sourcefile = filesTxtLine.substr(lastColon+1);
-
-        tinyxml2::XMLDocument doc;
-        tinyxml2::XMLError error = doc.LoadFile(xmlfile.c_str());
-        if (error != tinyxml2::XML_SUCCESS)
+    const std::map<std::string, std::string> filesTxt(AnalyzerInformation::readFilesTxt(buildDir));
+    for (std::map<std::string, std::string>::const_iterator f = filesTxt.begin(); f != filesTxt.end(); ++f) {
+        const std::string::size_type colon = f->first.find(':');
+        AnalyzerDatabase::FileData fileData;
+        if (!database.find(f->first.substr(colon + 1), f->first.substr(0, colon), &fileData))
             continue;
 
-        const tinyxml2::XMLElement * const rootNode = doc.FirstChildElement();
-        if (rootNode == nullptr)
-            continue;
-
-        for (const tinyxml2::XMLElement *e = rootNode->FirstChildElement(); e; e = e->NextSiblingElement()) {
-            if (std::strcmp(e->Name(), "FileInfo") != 0)
-                continue;
-            const char *checkClassAttr = e->Attribute("check");
-            if (!checkClassAttr)
+        for (std::list<std::pair<std::string, std::string> >::const_iterator fi = fileData.fileInfo.begin(); fi != fileData.fileInfo.end(); ++fi) {
+            tinyxml2::XMLDocument doc;
+            if (!AnalyzerDatabase::parseFileInfo(*fi, &doc))
                 continue;
             for (std::list<Check *>::const_iterator it = Check::instances().begin(); it != Check::instances().end(); ++it) {
-                if (checkClassAttr == (*it)->name())
-                    fileInfoList.push_back((*it)->loadFileInfoFromXml(e));
+                if (fi->first == (*it)->name())
+                    fileInfoList.push_back((*it)->loadFileInfoFromXml(doc.FirstChildElement()));
             }
         }
     }
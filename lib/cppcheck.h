@@ -52,6 +52,14 @@ public:
      */
     CppCheck(ErrorLogger &errorLogger, bool useGlobalSuppressions);
 
+    /**
+     * @brief Constructor for an instance that shares the settings read-only
+     * with other instances, e.g. in other threads. Only the suppressions
+     * are copied, since they are changed while files are checked.
+     * settings() must not be used.
+     */
+    CppCheck(ErrorLogger &errorLogger, bool useGlobalSuppressions, const Settings &sharedSettings);
+
     /**
      * @brief Destructor.
      */
@@ -113,7 +121,7 @@ public:
      * @brief Terminate checking. The checking will be terminated as soon as possible.
      */
     void terminate() {
-        _settings.terminate();
+        Settings::terminate();
     }
 
     /**
@@ -138,6 +146,14 @@ public:
     /** analyse whole program use .analyzeinfo files */
     void analyseWholeProgram(const std::string &buildDir, const std::map<std::string, std::size_t> &files);
 
+    /**
+     * Show the results of all timers of all CppCheck instances, see --showtime
+     * @param mode showtime mode
+     * @param jsonFile file that the results are written to if mode is SHOWTIME_JSON
+     * @return false if the file could not be written
+     */
+    static bool showTimerResults(SHOWTIME_MODES mode, const std::string &jsonFile);
+
     /** Check if the user wants to check for unused functions
      * and if it's possible at all */
     bool isUnusedFunctionCheckEnabled() const;
@@ -147,6 +163,21 @@ private:
     /** @brief There has been an internal error => Report information message */
     void internalError(const std::string &filename, const std::string &msg);
 
+    /** @brief Version and settings that affect the result of the analysis of a TU */
+    std::string toolInfo() const;
+
+    /** @brief Settings that must be unchanged to skip a TU that is unchanged in the build dir */
+    std::string buildDirSettings() const;
+
+    /**
+     * @brief Skip a TU if it and all the files it includes are unchanged since
+     * the last analysis in the build dir. The old results are reported.
+     * @param filename file name
+     * @param cfgname cfg name
+     * @return true if the TU was skipped
+     */
+    bool skipUnchangedFile(const std::string &filename, const std::string &cfgname);
+
     /**
      * @brief Process one file.
      * @param filename file name
@@ -197,8 +228,17 @@ private:
      */
     virtual void reportOut(const std::string &outmsg);
 
-    std::list<std::string> _errorList;
-    Settings _settings;
+    /** Errors that have been reported in the current file */
+    ErrorMessageSet _errorList;
+
+    /** @brief Settings, see settings(). Only the suppressions are used when the settings are shared. */
+    Settings _ownSettings;
+
+    /** @brief Settings that are used, _ownSettings or the shared settings */
+    const Settings &_settings;
+
+    /** @brief Is the current file an accepted C/C++ source file? Debug warnings are only shown for these. */
+    bool _acceptedFile;
 
     void reportProgress(const std::string &filename, const char stage[], const std::size_t value);
 
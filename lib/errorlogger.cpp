@@ -26,6 +26,7 @@
 #include "utils.h"
 
 #include <tinyxml2.h>
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <cctype>
@@ -371,6 +372,51 @@ void ErrorLogger::ErrorMessage::findAndReplace(std::string &source, const std::s
     }
 }
 
+/** Add a string and its terminating zero, that separates it from the next data */
+static void addString(FnvHash &h, const std::string &str)
+{
+    h.add(str.c_str(), str.size() + 1U);
+}
+
+unsigned long long ErrorLogger::ErrorMessage::hash(bool verbose) const
+{
+    // Same data as in the default output format + id
+    FnvHash h;
+    addString(h, _id);
+    h.addInt(static_cast<unsigned long long>(_severity));
+    h.addInt(static_cast<unsigned long long>(_inconclusive));
+    h.addInt(static_cast<unsigned long long>(_callStack.size()));
+    for (std::list<FileLocation>::const_iterator loc = _callStack.begin(); loc != _callStack.end(); ++loc) {
+        addString(h, loc->getfile(false));
+        h.addInt(static_cast<unsigned long long>(loc->line));
+    }
+    addString(h, verbose ? _verboseMessage : _shortMessage);
+    return h.get();
+}
+
+std::string ErrorMessageSet::text(const ErrorLogger::ErrorMessage &msg, bool verbose)
+{
+    return msg._id + ' ' + msg.toString(verbose);
+}
+
+bool ErrorMessageSet::contains(const ErrorLogger::ErrorMessage &msg, bool verbose) const
+{
+    const std::unordered_map<unsigned long long, std::vector<std::string> >::const_iterator it = _messages.find(msg.hash(verbose));
+    if (it == _messages.end())
+        return false;
+    return std::find(it->second.begin(), it->second.end(), text(msg, verbose)) != it->second.end();
+}
+
+bool ErrorMessageSet::insert(const ErrorLogger::ErrorMessage &msg, bool verbose)
+{
+    std::vector<std::string> &texts = _messages[msg.hash(verbose)];
+    const std::string t(text(msg, verbose));
+    if (std::find(texts.begin(), texts.end(), t) != texts.end())
+        return false;
+    texts.push_back(t);
+    return true;
+}
+
 std::string ErrorLogger::ErrorMessage::toString(bool verbose, const std::string &outputFormat) const
 {
     // Save this ErrorMessage in plain text.
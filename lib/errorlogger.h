@@ -28,6 +28,7 @@
 #include <fstream>
 #include <list>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -262,6 +263,15 @@ public:
          */
         std::string toString(bool verbose, const std::string &outputFormat = emptyString) const;
 
+        /**
+         * Hash of the id, the locations and the message. Messages that have
+         * the same hash are reported only once. The formatted message is
+         * not created.
+         * @param verbose use verbose message
+         * @return hash
+         */
+        unsigned long long hash(bool verbose) const;
+
         std::string serialize() const;
         bool deserialize(const std::string &data);
 
@@ -375,6 +385,35 @@ public:
     }
 };
 
+/**
+ * @brief Set of error messages, used to report each error only once.
+ * Messages are looked up by ErrorMessage::hash(). Messages with the same
+ * hash are compared by their text, so a hash collision does not hide an
+ * error.
+ */
+class CPPCHECKLIB ErrorMessageSet {
+public:
+    /** Is an equal message in the set? */
+    bool contains(const ErrorLogger::ErrorMessage &msg, bool verbose) const;
+
+    /**
+     * Add a message.
+     * @return false if an equal message was already in the set
+     */
+    bool insert(const ErrorLogger::ErrorMessage &msg, bool verbose);
+
+    void clear() {
+        _messages.clear();
+    }
+
+private:
+    /** The text that messages are compared by: the id and the default output format */
+    static std::string text(const ErrorLogger::ErrorMessage &msg, bool verbose);
+
+    /** The texts of the messages by hash */
+    std::unordered_map<unsigned long long, std::vector<std::string> > _messages;
+};
+
 /// @}
 //---------------------------------------------------------------------------
 #endif // errorloggerH
@@ -6,6 +6,7 @@ INCLUDEPATH += $$PWD
 HEADERS += $${PWD}/check.h \
            $${PWD}/analyzerinfo.h \
            $${PWD}/astutils.h \
+           $${PWD}/blocklist.h \
            $${PWD}/check.h \
            $${PWD}/check64bit.h \
            $${PWD}/checkassert.h \
@@ -42,11 +43,14 @@ HEADERS += $${PWD}/check.h \
            $${PWD}/platform.h \
            $${PWD}/preprocessor.h \
            $${PWD}/settings.h \
+           $${PWD}/smallvector.h \
            $${PWD}/suppressions.h \
            $${PWD}/symboldatabase.h \
            $${PWD}/templatesimplifier.h \
+           $${PWD}/threadpool.h \
            $${PWD}/timer.h \
            $${PWD}/token.h \
+           $${PWD}/tokenarena.h \
            $${PWD}/tokenize.h \
            $${PWD}/tokenlist.h \
            $${PWD}/valueflow.h \
@@ -93,8 +97,10 @@ SOURCES += $${PWD}/analyzerinfo.cpp \
            $${PWD}/suppressions.cpp \
            $${PWD}/symboldatabase.cpp \
            $${PWD}/templatesimplifier.cpp \
+           $${PWD}/threadpool.cpp \
            $${PWD}/timer.cpp \
            $${PWD}/token.cpp \
+           $${PWD}/tokenarena.cpp \
            $${PWD}/tokenize.cpp \
            $${PWD}/tokenlist.cpp \
            $${PWD}/valueflow.cpp
@@ -25,6 +25,7 @@
 #include "settings.h"
 #include "simplecpp.h"
 #include "suppressions.h"
+#include "utils.h"
 
 #include <algorithm>
 #include <cstdint>
@@ -52,12 +53,18 @@ Directive::Directive(const std::string &_file, const int _linenr, const std::str
 {
 }
 
-bool Preprocessor::missingIncludeFlag;
-bool Preprocessor::missingSystemIncludeFlag;
+std::atomic<bool> Preprocessor::missingIncludeFlag;
+std::atomic<bool> Preprocessor::missingSystemIncludeFlag;
+
+simplecpp::FileCache *Preprocessor::fileCache = nullptr;
 
 char Preprocessor::macroChar = char(1);
 
-Preprocessor::Preprocessor(Settings& settings, ErrorLogger *errorLogger) : _settings(settings), _errorLogger(errorLogger)
+Preprocessor::Preprocessor(Settings& settings, ErrorLogger *errorLogger) : _settings(settings), _nomsg(settings.nomsg), _errorLogger(errorLogger)
+{
+}
+
+Preprocessor::Preprocessor(const Settings& settings, Suppressions &nomsg, ErrorLogger *errorLogger) : _settings(settings), _nomsg(nomsg), _errorLogger(errorLogger)
 {
 }
 
@@ -68,7 +75,7 @@ Preprocessor::~Preprocessor()
 }
 
 
-static void inlineSuppressions(const simplecpp::TokenList &tokens, Settings &_settings)
+static void inlineSuppressions(const simplecpp::TokenList &tokens, const Settings &_settings, Suppressions &nomsg)
 {
     std::list<std::string> suppressionIDs;
 
@@ -101,7 +108,7 @@ static void inlineSuppressions(const simplecpp::TokenList &tokens, Settings &_se
 
         // Add the suppressions.
         for (std::list<std::string>::const_iterator it = suppressionIDs.begin(); it != suppressionIDs.end(); ++it) {
-            _settings.nomsg.addSuppression(*it, relativeFilename, tok->location.line);
+            nomsg.addSuppression(*it, relativeFilename, tok->location.line);
         }
         suppressionIDs.clear();
     }
@@ -111,10 +118,10 @@ void Preprocessor::inlineSuppressions(const simplecpp::TokenList &tokens)
 {
     if (!_settings.inlineSuppressions)
         return;
-    ::inlineSuppressions(tokens, _settings);
+    ::inlineSuppressions(tokens, _settings, _nomsg);
     for (std::map<std::string,simplecpp::TokenList*>::const_iterator it = tokenlists.begin(); it != tokenlists.end(); ++it) {
         if (it->second)
-            ::inlineSuppressions(*it->second, _settings);
+            ::inlineSuppressions(*it->second, _settings, _nomsg);
     }
 }
 
@@ -567,7 +574,7 @@ void Preprocessor::loadFiles(const simplecpp::TokenList &rawtokens, std::vector<
 
     simplecpp::OutputList outputList;
 
-    tokenlists = simplecpp::load(rawtokens, files, dui, &outputList);
+    tokenlists = simplecpp::load(rawtokens, files, dui, &outputList, fileCache);
 }
 
 void Preprocessor::removeComments()
@@ -598,14 +605,14 @@ void Preprocessor::setPlatformInfo(simplecpp::TokenList *tokens) const
     tokens->sizeOfType["long double *"] = _settings.sizeof_pointer;
 }
 
-simplecpp::TokenList Preprocessor::preprocess(const simplecpp::TokenList &tokens1, const std::string &cfg, std::vector<std::string> &files)
+simplecpp::TokenList Preprocessor::preprocess(const simplecpp::TokenList &tokens1, const std::string &cfg, std::vector<std::string> &files, simplecpp::MacroSnapshots *snapshots)
 {
     const simplecpp::DUI dui = createDUI(_settings, cfg, files[0]);
 
     simplecpp::OutputList outputList;
     std::list<simplecpp::MacroUsage> macroUsage;
     simplecpp::TokenList tokens2(files);
-    simplecpp::preprocess(tokens2, tokens1, files, tokenlists, dui, &outputList, &macroUsage);
+    simplecpp::preprocess(tokens2, tokens1, files, tokenlists, dui, &outputList, &macroUsage, snapshots);
 
     bool showerror = (!_settings.userDefines.empty() && !_settings.force);
     reportOutput(outputList, showerror);
@@ -713,9 +720,9 @@ void Preprocessor::error(const std::string &filename, unsigned int linenr, const
 void Preprocessor::missingInclude(const std::string &filename, unsigned int linenr, const std::string &header, HeaderTypes headerType)
 {
     const std::string fname = Path::fromNativeSeparators(filename);
-    if (_settings.nomsg.isSuppressed("missingInclude", fname, linenr))
+    if (_nomsg.isSuppressed("missingInclude", fname, linenr))
         return;
-    if (headerType == SystemHeader && _settings.nomsg.isSuppressed("missingIncludeSystem", fname, linenr))
+    if (headerType == SystemHeader && _nomsg.isSuppressed("missingIncludeSystem", fname, linenr))
         return;
 
     if (headerType == SystemHeader)
@@ -883,6 +890,20 @@ unsigned int Preprocessor::calculateChecksum(const simplecpp::TokenList &tokens1
     return crc32(ostr.str());
 }
 
+unsigned long long Preprocessor::calculateHash(const simplecpp::TokenList &tokens2)
+{
+    FnvHash hash;
+    for (const simplecpp::Token *tok = tokens2.cfront(); tok; tok = tok->next) {
+        hash.add(tok->str);
+        hash.addInt((unsigned int)tok->str.size());
+        hash.addInt(tok->location.fileIndex);
+        hash.addInt(tok->location.line);
+        hash.addInt(tok->location.col);
+        hash.addInt(tok->macro.empty() ? 0U : 1U);
+    }
+    return hash.get();
+}
+
 void Preprocessor::simplifyPragmaAsm(simplecpp::TokenList *tokenList)
 {
     Preprocessor::simplifyPragmaAsmPrivate(tokenList);
@@ -24,6 +24,7 @@
 #include "config.h"
 
 #include <simplecpp.h>
+#include <atomic>
 #include <istream>
 #include <list>
 #include <map>
@@ -33,6 +34,7 @@
 
 class ErrorLogger;
 class Settings;
+class Suppressions;
 
 /**
  * @brief A preprocessor directive
@@ -82,10 +84,20 @@ public:
     static char macroChar;
 
     Preprocessor(Settings& settings, ErrorLogger *errorLogger = nullptr);
+    /** Use the given suppressions instead of the suppressions in the settings */
+    Preprocessor(const Settings& settings, Suppressions &nomsg, ErrorLogger *errorLogger = nullptr);
     virtual ~Preprocessor();
 
-    static bool missingIncludeFlag;
-    static bool missingSystemIncludeFlag;
+    /** Set when an include file is missing, by all threads */
+    static std::atomic<bool> missingIncludeFlag;
+    static std::atomic<bool> missingSystemIncludeFlag;
+
+    /**
+     * Cache of lexed headers shared by all Preprocessor instances, each
+     * header is then only read and tokenized once per run. No caching is
+     * done when this is null.
+     */
+    static simplecpp::FileCache *fileCache;
 
     void inlineSuppressions(const simplecpp::TokenList &tokens);
 
@@ -136,7 +148,11 @@ public:
      */
     void preprocess(std::istream &srcCodeStream, std::string &processedFile, std::list<std::string> &resultConfigurations, const std::string &filename, const std::list<std::string> &includePaths);
 
-    simplecpp::TokenList preprocess(const simplecpp::TokenList &tokens1, const std::string &cfg, std::vector<std::string> &files);
+    /**
+     * Preprocess tokens1 for the configuration cfg
+     * @param snapshots optional macro snapshots, that are shared by the configurations of tokens1
+     */
+    simplecpp::TokenList preprocess(const simplecpp::TokenList &tokens1, const std::string &cfg, std::vector<std::string> &files, simplecpp::MacroSnapshots *snapshots = nullptr);
 
     std::string getcode(const simplecpp::TokenList &tokens1, const std::string &cfg, std::vector<std::string> &files, const bool writeLocations);
 
@@ -172,6 +188,15 @@ public:
      */
     unsigned int calculateChecksum(const simplecpp::TokenList &tokens1, const std::string &toolinfo) const;
 
+    /**
+     * Calculate a 64-bit hash of preprocessed tokens. Configurations with
+     * the same hash give the same token list.
+     *
+     * @param tokens2    Preprocessor output
+     * @return hash of the strings, locations and macro flags of the tokens
+     */
+    static unsigned long long calculateHash(const simplecpp::TokenList &tokens2);
+
     void simplifyPragmaAsm(simplecpp::TokenList *tokenList);
 
 private:
@@ -206,7 +231,8 @@ private:
     void missingInclude(const std::string &filename, unsigned int linenr, const std::string &header, HeaderTypes headerType);
     void error(const std::string &filename, unsigned int linenr, const std::string &msg);
 
-    Settings& _settings;
+    const Settings& _settings;
+    Suppressions &_nomsg;
     ErrorLogger *_errorLogger;
 
     /** list of all directives met while preprocessing file */
@@ -18,6 +18,7 @@
 
 #include "settings.h"
 
+#include "threadpool.h"
 #include "valueflow.h"
 
 bool Settings::_terminated;
@@ -40,14 +41,19 @@ Settings::Settings()
       xml(false), xml_version(2),
       jobs(1),
       loadAverage(0),
+      orderFilesByCost(true),
+      functionJobs(1),
+      functionJobThreads(std::make_shared<ThreadPool>()),
       exitCode(0),
       showtime(SHOWTIME_NONE),
       preprocessOnly(false),
+      valueFlowMaxValues(10),
       maxConfigs(12),
       enforcedLang(None),
       reportProgress(false),
       checkConfiguration(false),
-      checkLibrary(false)
+      checkLibrary(false),
+      simplifiedChecks(true)
 {
 }
 
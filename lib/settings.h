@@ -31,10 +31,12 @@
 #include "timer.h"
 
 #include <list>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
 
+class ThreadPool;
 namespace ValueFlow {
     class Value;
 }
@@ -152,6 +154,18 @@ public:
     /** @brief Load average value */
     unsigned int loadAverage;
 
+    /** @brief When several jobs are used, check the files that are expected
+        to take the longest time first. Default is true. (--file-order=cost|name) */
+    bool orderFilesByCost;
+
+    /** @brief How many threads check the functions of one file at the
+        same time. Default is 1. (--function-jobs=N) */
+    unsigned int functionJobs;
+
+    /** @brief Threads that check functions. Copies of the settings share
+        the threads, they are started when they are first needed. */
+    std::shared_ptr<ThreadPool> functionJobThreads;
+
     /** @brief If errors are found, this value is returned from main().
         Default value is 0. */
     int exitCode;
@@ -160,9 +174,12 @@ public:
         e.g. "{severity} {file}:{line} {message} {id}" */
     std::string outputFormat;
 
-    /** @brief show timing information (--showtime=file|summary|top5) */
+    /** @brief show timing information (--showtime=file|summary|top5|json:<file>) */
     SHOWTIME_MODES showtime;
 
+    /** @brief file that the timing information is written to in JSON format (--showtime=json:<file>) */
+    std::string showtimeFile;
+
     /** @brief Using -E for debugging purposes */
     bool preprocessOnly;
 
@@ -170,6 +187,10 @@ public:
         for finding include files inside source files. (-I) */
     std::list<std::string> includePaths;
 
+    /** @brief Maximum number of ValueFlow values for a token.
+        More values are dropped for performance reasons. Default is 10. (--max-valueflow-values=N) */
+    unsigned int valueFlowMaxValues;
+
     /** @brief Maximum number of configurations to check before bailing.
         Default is 12. (--max-configs=N) */
     unsigned int maxConfigs;
@@ -270,6 +291,13 @@ public:
     /** Check for incomplete info in library files? */
     bool checkLibrary;
 
+    /**
+     * @brief Create the simplified token list and run the checks that
+     * need it? When --no-simplified-checks is given only the checks
+     * that use the normal token list are run.
+     */
+    bool simplifiedChecks;
+
     /** Struct contains standards settings */
     Standards standards;
 
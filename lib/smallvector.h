@@ -0,0 +1,141 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2016 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef smallvectorH
+#define smallvectorH
+//---------------------------------------------------------------------------
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/// @addtogroup Core
+/// @{
+
+/**
+ * @brief Contiguous container that stores up to N elements inside the object.
+ *
+ * When more than N elements are added they are moved to a heap buffer that
+ * grows like a std::vector. Iterators are plain pointers and are invalidated
+ * when an element is added.
+ */
+template<class T, std::size_t N>
+class SmallVector {
+public:
+    typedef T value_type;
+    typedef T *iterator;
+    typedef const T *const_iterator;
+    typedef std::size_t size_type;
+
+    SmallVector() : _data(inlineData()), _size(0), _capacity(N) {
+    }
+
+    ~SmallVector() {
+        clear();
+        if (_data != inlineData())
+            ::operator delete(_data);
+    }
+
+    iterator begin() {
+        return _data;
+    }
+    const_iterator begin() const {
+        return _data;
+    }
+    iterator end() {
+        return _data + _size;
+    }
+    const_iterator end() const {
+        return _data + _size;
+    }
+
+    size_type size() const {
+        return _size;
+    }
+    bool empty() const {
+        return _size == 0;
+    }
+
+    T &front() {
+        return _data[0];
+    }
+    const T &front() const {
+        return _data[0];
+    }
+    T &back() {
+        return _data[_size - 1];
+    }
+    const T &back() const {
+        return _data[_size - 1];
+    }
+    T &operator[](size_type i) {
+        return _data[i];
+    }
+    const T &operator[](size_type i) const {
+        return _data[i];
+    }
+
+    void push_back(const T &value) {
+        if (_size == _capacity)
+            grow();
+        new (_data + _size) T(value);
+        ++_size;
+    }
+
+    /** Remove all elements, a heap buffer is kept for reuse */
+    void clear() {
+        for (unsigned int i = 0; i < _size; ++i)
+            _data[i].~T();
+        _size = 0;
+    }
+
+private:
+    /** Disable copy constructor, no implementation */
+    SmallVector(const SmallVector &);
+
+    /** Disable assignment operator, no implementation */
+    SmallVector &operator=(const SmallVector &);
+
+    T *inlineData() {
+        return reinterpret_cast<T *>(&_inline);
+    }
+
+    void grow() {
+        const unsigned int capacity = 2 * _capacity;
+        T *data = static_cast<T *>(::operator new(capacity * sizeof(T)));
+        for (unsigned int i = 0; i < _size; ++i) {
+            new (data + i) T(std::move(_data[i]));
+            _data[i].~T();
+        }
+        if (_data != inlineData())
+            ::operator delete(_data);
+        _data = data;
+        _capacity = capacity;
+    }
+
+    T *_data;
+    unsigned int _size;
+    unsigned int _capacity;
+    typename std::aligned_storage<N * sizeof(T), std::alignment_of<T>::value>::type _inline;
+};
+
+/// @}
+//---------------------------------------------------------------------------
+#endif // smallvectorH
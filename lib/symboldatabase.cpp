@@ -22,6 +22,7 @@
 #include "errorlogger.h"
 #include "platform.h"
 #include "settings.h"
+#include "timer.h"
 #include "token.h"
 #include "tokenize.h"
 #include "tokenlist.h"
@@ -35,7 +36,7 @@
 //---------------------------------------------------------------------------
 
 SymbolDatabase::SymbolDatabase(const Tokenizer *tokenizer, const Settings *settings, ErrorLogger *errorLogger)
-    : _tokenizer(tokenizer), _settings(settings), _errorLogger(errorLogger)
+    : _tokenizer(tokenizer), _settings(settings), _errorLogger(errorLogger), _baseFunctionCacheHits(0), _baseFunctionCacheMisses(0)
 {
     cpp = isCPP();
 
@@ -60,6 +61,11 @@ SymbolDatabase::SymbolDatabase(const Tokenizer *tokenizer, const Settings *setti
     createSymbolDatabaseSetTypePointers();
     createSymbolDatabaseEnums();
     createSymbolDatabaseUnknownArrayDimensions();
+
+    if (_settings->showtime != SHOWTIME_NONE && _tokenizer->m_timerResults) {
+        _tokenizer->m_timerResults->AddCount("Scope::findFunction base class cache hits", _baseFunctionCacheHits);
+        _tokenizer->m_timerResults->AddCount("Scope::findFunction base class cache misses", _baseFunctionCacheMisses);
+    }
 }
 
 void SymbolDatabase::createSymbolDatabaseFindAllScopes()
@@ -166,7 +172,7 @@ void SymbolDatabase::createSymbolDatabaseFindAllScopes()
                     if (!new_type) {
                         typeList.push_back(Type(new_scope->classDef, new_scope, scope));
                         new_type = &typeList.back();
-                        scope->definedTypes.push_back(new_type);
+                        scope->addDefinedType(new_type);
                     } else
                         new_type->classScope = new_scope;
                     new_scope->definedType = new_type;
@@ -196,13 +202,13 @@ void SymbolDatabase::createSymbolDatabaseFindAllScopes()
 
                 if (new_scope->type == Scope::eEnum) {
                     tok2 = new_scope->addEnum(tok, _tokenizer->isCPP());
-                    scope->nestedList.push_back(new_scope);
+                    scope->addNestedScope(new_scope);
 
                     if (!tok2)
                         _tokenizer->syntaxError(tok);
                 } else {
                     // make the new scope the current scope
-                    scope->nestedList.push_back(new_scope);
+                    scope->addNestedScope(new_scope);
                     scope = new_scope;
                 }
 
@@ -232,7 +238,7 @@ void SymbolDatabase::createSymbolDatabaseFindAllScopes()
             }
 
             // make the new scope the current scope
-            scope->nestedList.push_back(new_scope);
+            scope->addNestedScope(new_scope);
             scope = &scopeList.back();
 
             tok = tok2;
@@ -244,7 +250,7 @@ void SymbolDatabase::createSymbolDatabaseFindAllScopes()
             if (!findType(tok->next(), scope)) {
                 // fill typeList..
                 typeList.push_back(Type(tok, nullptr, scope));
-                scope->definedTypes.push_back(&typeList.back());
+                scope->addDefinedType(&typeList.back());
             }
             tok = tok->tokAt(2);
         }
@@ -286,7 +292,7 @@ void SymbolDatabase::createSymbolDatabaseFindAllScopes()
 
             typeList.push_back(Type(tok, new_scope, scope));
             new_scope->definedType = &typeList.back();
-            scope->definedTypes.push_back(&typeList.back());
+            scope->addDefinedType(&typeList.back());
 
             scope->addVariable(varNameTok, tok, tok, access[scope], new_scope->definedType, scope, &_settings->library);
 
@@ -302,7 +308,7 @@ void SymbolDatabase::createSymbolDatabaseFindAllScopes()
             }
 
             // make the new scope the current scope
-            scope->nestedList.push_back(new_scope);
+            scope->addNestedScope(new_scope);
             scope = new_scope;
 
             tok = tok2;
@@ -324,7 +330,7 @@ void SymbolDatabase::createSymbolDatabaseFindAllScopes()
 
             typeList.push_back(Type(tok, new_scope, scope));
             new_scope->definedType = &typeList.back();
-            scope->definedTypes.push_back(&typeList.back());
+            scope->addDefinedType(&typeList.back());
 
             // make sure we have valid code
             if (!new_scope->classEnd) {
@@ -333,7 +339,7 @@ void SymbolDatabase::createSymbolDatabaseFindAllScopes()
             }
 
             // make the new scope the current scope
-            scope->nestedList.push_back(new_scope);
+            scope->addNestedScope(new_scope);
             scope = new_scope;
 
             tok = tok2;
@@ -342,7 +348,7 @@ void SymbolDatabase::createSymbolDatabaseFindAllScopes()
         // forward declared enum
         else if (Token::Match(tok, "enum class| %name% ;") || Token::Match(tok, "enum class| %name% : %name% ;")) {
             typeList.push_back(Type(tok, nullptr, scope));
-            scope->definedTypes.push_back(&typeList.back());
+            scope->addDefinedType(&typeList.back());
             tok = tok->tokAt(2);
         }
 
@@ -792,7 +798,7 @@ void SymbolDatabase::createSymbolDatabaseFindAllScopes()
                     scopeList.push_back(Scope(this, tok, scope, Scope::eTry, tok1));
 
                 tok = tok1;
-                scope->nestedList.push_back(&scopeList.back());
+                scope->addNestedScope(&scopeList.back());
                 scope = &scopeList.back();
             } else if (Token::Match(tok, "if|for|while|catch|switch (") && Token::simpleMatch(tok->next()->link(), ") {")) {
                 const Token *scopeStartTok = tok->next()->link()->next();
@@ -807,7 +813,7 @@ void SymbolDatabase::createSymbolDatabaseFindAllScopes()
                 } else // if (tok->str() == "switch")
                     scopeList.push_back(Scope(this, tok, scope, Scope::eSwitch, scopeStartTok));
 
-                scope->nestedList.push_back(&scopeList.back());
+                scope->addNestedScope(&scopeList.back());
                 scope = &scopeList.back();
                 if (scope->type == Scope::eFor)
                     scope->checkVariable(tok->tokAt(2), Local, &_settings->library); // check for variable declaration and add it to new scope if found
@@ -826,11 +832,11 @@ void SymbolDatabase::createSymbolDatabaseFindAllScopes()
 
                     if (tok2 && tok2->str() == ")" && tok2->link()->strAt(-1) == "]") {
                         scopeList.push_back(Scope(this, tok2->link()->linkAt(-1), scope, Scope::eLambda, tok));
-                        scope->nestedList.push_back(&scopeList.back());
+                        scope->addNestedScope(&scopeList.back());
                         scope = &scopeList.back();
                     } else if (!Token::Match(tok->previous(), "=|,|(|return") && !(tok->strAt(-1) == ")" && Token::Match(tok->linkAt(-1)->previous(), "=|,|(|return"))) {
                         scopeList.push_back(Scope(this, tok, scope, Scope::eUnconditional, tok));
-                        scope->nestedList.push_back(&scopeList.back());
+                        scope->addNestedScope(&scopeList.back());
                         scope = &scopeList.back();
                     } else {
                         tok = tok->link();
@@ -839,13 +845,16 @@ void SymbolDatabase::createSymbolDatabaseFindAllScopes()
             }
         }
     }
+
+    for (BlockList<Scope>::const_iterator it = scopeList.begin(); it != scopeList.end(); ++it)
+        _scopesByName.insert(std::make_pair(it->className, &*it));
 }
 
 void SymbolDatabase::createSymbolDatabaseClassInfo()
 {
     if (!_tokenizer->isC()) {
         // fill in using info
-        for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+        for (BlockList<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
             for (std::list<Scope::UsingInfo>::iterator i = it->usingList.begin(); i != it->usingList.end(); ++i) {
                 // only find if not already found
                 if (i->scope == nullptr) {
@@ -861,7 +870,7 @@ void SymbolDatabase::createSymbolDatabaseClassInfo()
         }
 
         // fill in base class info
-        for (std::list<Type>::iterator it = typeList.begin(); it != typeList.end(); ++it) {
+        for (BlockList<Type>::iterator it = typeList.begin(); it != typeList.end(); ++it) {
             // finish filling in base class info
             for (unsigned int i = 0; i < it->derivedFrom.size(); ++i) {
                 const Type* found = findType(it->derivedFrom[i].nameTok, it->enclosingScope);
@@ -875,7 +884,7 @@ void SymbolDatabase::createSymbolDatabaseClassInfo()
         }
 
         // fill in friend info
-        for (std::list<Type>::iterator it = typeList.begin(); it != typeList.end(); ++it) {
+        for (BlockList<Type>::iterator it = typeList.begin(); it != typeList.end(); ++it) {
             for (std::list<Type::FriendInfo>::iterator i = it->friendList.begin(); i != it->friendList.end(); ++i) {
                 i->type = findType(i->nameStart, it->enclosingScope);
             }
@@ -887,14 +896,14 @@ void SymbolDatabase::createSymbolDatabaseClassInfo()
 void SymbolDatabase::createSymbolDatabaseVariableInfo()
 {
     // fill in variable info
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+    for (BlockList<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
         // find variables
         it->getVariableList(&_settings->library);
     }
 
     // fill in function arguments
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
-        std::list<Function>::iterator func;
+    for (BlockList<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+        BlockList<Function>::iterator func;
 
         for (func = it->functionList.begin(); func != it->functionList.end(); ++func) {
             // add arguments
@@ -906,7 +915,7 @@ void SymbolDatabase::createSymbolDatabaseVariableInfo()
 void SymbolDatabase::createSymbolDatabaseFunctionScopes()
 {
     // fill in function scopes
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+    for (BlockList<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
         if (it->type == Scope::eFunction)
             functionScopes.push_back(&*it);
     }
@@ -915,7 +924,7 @@ void SymbolDatabase::createSymbolDatabaseFunctionScopes()
 void SymbolDatabase::createSymbolDatabaseClassAndStructScopes()
 {
     // fill in class and struct scopes
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+    for (BlockList<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
         if (it->isClassOrStruct())
             classAndStructScopes.push_back(&*it);
     }
@@ -924,8 +933,8 @@ void SymbolDatabase::createSymbolDatabaseClassAndStructScopes()
 void SymbolDatabase::createSymbolDatabaseFunctionReturnTypes()
 {
     // fill in function return types
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
-        std::list<Function>::iterator func;
+    for (BlockList<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+        BlockList<Function>::iterator func;
 
         for (func = it->functionList.begin(); func != it->functionList.end(); ++func) {
             // add return types
@@ -947,7 +956,7 @@ void SymbolDatabase::createSymbolDatabaseNeedInitialization()
 {
     if (_tokenizer->isC()) {
         // For C code it is easy, as there are no constructors and no default values
-        for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+        for (BlockList<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
             Scope *scope = &(*it);
             if (scope->definedType)
                 scope->definedType->needInitialization = Type::True;
@@ -960,7 +969,7 @@ void SymbolDatabase::createSymbolDatabaseNeedInitialization()
         do {
             unknowns = 0;
 
-            for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+            for (BlockList<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
                 Scope *scope = &(*it);
 
                 if (!scope->definedType) {
@@ -972,7 +981,7 @@ void SymbolDatabase::createSymbolDatabaseNeedInitialization()
                     // check for default constructor
                     bool hasDefaultConstructor = false;
 
-                    std::list<Function>::const_iterator func;
+                    BlockList<Function>::const_iterator func;
 
                     for (func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
                         if (func->type == Function::eConstructor) {
@@ -1001,7 +1010,7 @@ void SymbolDatabase::createSymbolDatabaseNeedInitialization()
                         bool needInitialization = false;
                         bool unknown = false;
 
-                        std::list<Variable>::const_iterator var;
+                        BlockList<Variable>::const_iterator var;
                         for (var = scope->varlist.begin(); var != scope->varlist.end() && !needInitialization; ++var) {
                             if (var->isClass()) {
                                 if (var->type()) {
@@ -1032,7 +1041,7 @@ void SymbolDatabase::createSymbolDatabaseNeedInitialization()
 
         // this shouldn't happen so output a debug warning
         if (retry == 100 && _settings->debugwarnings) {
-            for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+            for (BlockList<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
                 const Scope *scope = &(*it);
 
                 if (scope->isClassOrStruct() && scope->definedType->needInitialization == Type::Unknown)
@@ -1049,11 +1058,11 @@ void SymbolDatabase::createSymbolDatabaseVariableSymbolTable()
     std::fill_n(_variableList.begin(), _variableList.size(), (const Variable*)nullptr);
 
     // check all scopes for variables
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+    for (BlockList<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
         Scope *scope = &(*it);
 
         // add all variables
-        for (std::list<Variable>::iterator var = scope->varlist.begin(); var != scope->varlist.end(); ++var) {
+        for (BlockList<Variable>::iterator var = scope->varlist.begin(); var != scope->varlist.end(); ++var) {
             unsigned int varId = var->declarationId();
             if (varId)
                 _variableList[varId] = &(*var);
@@ -1066,8 +1075,8 @@ void SymbolDatabase::createSymbolDatabaseVariableSymbolTable()
         }
 
         // add all function parameters
-        for (std::list<Function>::iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
-            for (std::list<Variable>::iterator arg = func->argumentList.begin(); arg != func->argumentList.end(); ++arg) {
+        for (BlockList<Function>::iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
+            for (BlockList<Variable>::iterator arg = func->argumentList.begin(); arg != func->argumentList.end(); ++arg) {
                 // check for named parameters
                 if (arg->nameToken() && arg->declarationId()) {
                     const unsigned int declarationId = arg->declarationId();
@@ -1113,7 +1122,7 @@ void SymbolDatabase::createSymbolDatabaseVariableSymbolTable()
 void SymbolDatabase::createSymbolDatabaseSetScopePointers()
 {
     // Set scope pointers
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+    for (BlockList<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
         Token* start = const_cast<Token*>(it->classStart);
         Token* end = const_cast<Token*>(it->classEnd);
         if (it->type == Scope::eGlobal) {
@@ -1152,8 +1161,8 @@ void SymbolDatabase::createSymbolDatabaseSetFunctionPointers(bool firstPass)
 {
     if (firstPass) {
         // Set function definition and declaration pointers
-        for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
-            for (std::list<Function>::const_iterator func = it->functionList.begin(); func != it->functionList.end(); ++func) {
+        for (BlockList<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+            for (BlockList<Function>::const_iterator func = it->functionList.begin(); func != it->functionList.end(); ++func) {
                 if (func->tokenDef)
                     const_cast<Token *>(func->tokenDef)->function(&*func);
 
@@ -1173,15 +1182,15 @@ void SymbolDatabase::createSymbolDatabaseSetFunctionPointers(bool firstPass)
     }
 
     // Set C++ 11 delegate constructor function call pointers
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
-        for (std::list<Function>::const_iterator func = it->functionList.begin(); func != it->functionList.end(); ++func) {
+    for (BlockList<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+        for (BlockList<Function>::const_iterator func = it->functionList.begin(); func != it->functionList.end(); ++func) {
             // look for initializer list
             if (func->type == Function::eConstructor && func->functionScope &&
                 func->functionScope->functionOf && func->arg && func->arg->link()->strAt(1) == ":") {
                 const Token * tok = func->arg->link()->tokAt(2);
                 while (tok && tok != func->functionScope->classStart) {
                     if (Token::Match(tok, "%name% {|(")) {
-                        if (tok->str() == func->tokenDef->str()) {
+                        if (tok->strEquals(func->tokenDef)) {
                             const Function *function = func->functionScope->functionOf->findFunction(tok);
                             if (function)
                                 const_cast<Token *>(tok)->function(function);
@@ -1320,7 +1329,7 @@ void SymbolDatabase::createSymbolDatabaseSetVariablePointers()
 void SymbolDatabase::createSymbolDatabaseEnums()
 {
     // fill in enumerators in enum
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+    for (BlockList<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
         if (it->type != Scope::eEnum)
             continue;
 
@@ -1330,7 +1339,7 @@ void SymbolDatabase::createSymbolDatabaseEnums()
     }
 
     // fill in enumerator values
-    for (std::list<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
+    for (BlockList<Scope>::iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
         if (it->type != Scope::eEnum)
             continue;
 
@@ -1824,7 +1833,7 @@ bool Function::argsMatch(const Scope *scope, const Token *first, const Token *se
     if (Token::Match(second, "const %type% %name%|,|)"))
         second = second->next();
 
-    while (first->str() == second->str() &&
+    while (first->strEquals(second) &&
            first->isLong() == second->isLong() &&
            first->isUnsigned() == second->isUnsigned()) {
         // at end of argument list
@@ -1907,7 +1916,7 @@ bool Function::argsMatch(const Scope *scope, const Token *first, const Token *se
         // variable names are different
         else if ((Token::Match(first->next(), "%name% ,|)|=|[") &&
                   Token::Match(second->next(), "%name% ,|)|[")) &&
-                 (first->next()->str() != second->next()->str())) {
+                 (!first->next()->strEquals(second->next()))) {
             // skip variable names
             first = first->next();
             second = second->next();
@@ -2104,7 +2113,7 @@ void SymbolDatabase::addClassFunction(Scope **scope, const Token **tok, const To
         path_length++;
     }
 
-    std::list<Scope>::iterator it1;
+    BlockList<Scope>::iterator it1;
 
     // search for match
     for (it1 = scopeList.begin(); it1 != scopeList.end(); ++it1) {
@@ -2249,7 +2258,7 @@ void SymbolDatabase::addNewFunction(Scope **scope, const Token **tok)
             return;
         }
 
-        (*scope)->nestedList.push_back(newScope);
+        (*scope)->addNestedScope(newScope);
         *scope = newScope;
         *tok = tok1;
     } else {
@@ -2660,14 +2669,14 @@ void SymbolDatabase::printOut(const char *title) const
     if (title)
         std::cout << "\n### " << title << " ###\n";
 
-    for (std::list<Scope>::const_iterator scope = scopeList.begin(); scope != scopeList.end(); ++scope) {
+    for (BlockList<Scope>::const_iterator scope = scopeList.begin(); scope != scopeList.end(); ++scope) {
         std::cout << "Scope: " << &*scope << " " << scope->type << std::endl;
         std::cout << "    className: " << scope->className << std::endl;
         std::cout << "    classDef: " << tokenToString(scope->classDef, _tokenizer) << std::endl;
         std::cout << "    classStart: " << tokenToString(scope->classStart, _tokenizer) << std::endl;
         std::cout << "    classEnd: " << tokenToString(scope->classEnd, _tokenizer) << std::endl;
 
-        std::list<Function>::const_iterator func;
+        BlockList<Function>::const_iterator func;
 
         // find the function body if not implemented inline
         for (func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
@@ -2745,7 +2754,7 @@ void SymbolDatabase::printOut(const char *title) const
             std::cout << "        nestedIn: " << scopeToString(func->nestedIn, _tokenizer) << std::endl;
             std::cout << "        functionScope: " << scopeToString(func->functionScope, _tokenizer) << std::endl;
 
-            std::list<Variable>::const_iterator var;
+            BlockList<Variable>::const_iterator var;
 
             for (var = func->argumentList.begin(); var != func->argumentList.end(); ++var) {
                 std::cout << "        Variable: " << &*var << std::endl;
@@ -2753,7 +2762,7 @@ void SymbolDatabase::printOut(const char *title) const
             }
         }
 
-        std::list<Variable>::const_iterator var;
+        BlockList<Variable>::const_iterator var;
 
         for (var = scope->varlist.begin(); var != scope->varlist.end(); ++var) {
             std::cout << "    Variable: " << &*var << std::endl;
@@ -2832,7 +2841,7 @@ void SymbolDatabase::printOut(const char *title) const
         std::cout << std::endl;
     }
 
-    for (std::list<Type>::const_iterator type = typeList.begin(); type != typeList.end(); ++type) {
+    for (BlockList<Type>::const_iterator type = typeList.begin(); type != typeList.end(); ++type) {
         std::cout << "Type: " << &(*type) << std::endl;
         std::cout << "    name: " << type->name() << std::endl;
         std::cout << "    classDef: " << tokenToString(type->classDef, _tokenizer) << std::endl;
@@ -2901,7 +2910,7 @@ void SymbolDatabase::printXml(std::ostream &out) const
     out << std::setiosflags(std::ios::boolalpha);
     // Scopes..
     out << "  <scopes>" << std::endl;
-    for (std::list<Scope>::const_iterator scope = scopeList.begin(); scope != scopeList.end(); ++scope) {
+    for (BlockList<Scope>::const_iterator scope = scopeList.begin(); scope != scopeList.end(); ++scope) {
         out << "    <scope";
         out << " id=\"" << &*scope << "\"";
         out << " type=\"" << scope->type << "\"";
@@ -2921,7 +2930,7 @@ void SymbolDatabase::printXml(std::ostream &out) const
             out << '>' << std::endl;
             if (!scope->functionList.empty()) {
                 out << "      <functionList>" << std::endl;
-                for (std::list<Function>::const_iterator function = scope->functionList.begin(); function != scope->functionList.end(); ++function) {
+                for (BlockList<Function>::const_iterator function = scope->functionList.begin(); function != scope->functionList.end(); ++function) {
                     out << "        <function id=\"" << &*function << "\" tokenDef=\"" << function->tokenDef << "\" name=\"" << ErrorLogger::toxml(function->name()) << '\"';
                     if (function->argCount() == 0U)
                         out << "/>" << std::endl;
@@ -2938,7 +2947,7 @@ void SymbolDatabase::printXml(std::ostream &out) const
             }
             if (!scope->varlist.empty()) {
                 out << "      <varlist>" << std::endl;
-                for (std::list<Variable>::const_iterator var = scope->varlist.begin(); var != scope->varlist.end(); ++var)
+                for (BlockList<Variable>::const_iterator var = scope->varlist.begin(); var != scope->varlist.end(); ++var)
                     out << "        <var id=\""   << &*var << "\"/>" << std::endl;
                 out << "      </varlist>" << std::endl;
             }
@@ -3133,7 +3142,7 @@ bool Function::isImplicitlyVirtual_rec(const ::Type* baseType, bool& safe) const
 
                     // check for matching return parameters
                     while (temp1->str() != "virtual") {
-                        if (temp1->str() != temp2->str() &&
+                        if (!temp1->strEquals(temp2) &&
                             !(temp1->str() == derivedFromType->name() &&
                               temp2->str() == baseType->name())) {
                             returnMatch = false;
@@ -3169,7 +3178,7 @@ bool Function::isImplicitlyVirtual_rec(const ::Type* baseType, bool& safe) const
 
 const Variable* Function::getArgumentVar(std::size_t num) const
 {
-    for (std::list<Variable>::const_iterator i = argumentList.begin(); i != argumentList.end(); ++i) {
+    for (BlockList<Variable>::const_iterator i = argumentList.begin(); i != argumentList.end(); ++i) {
         if (i->index() == num)
             return (&*i);
         else if (i->index() > num)
@@ -3250,7 +3259,7 @@ Scope::Scope(const SymbolDatabase *check_, const Token *classDef_, const Scope *
 bool Scope::hasDefaultConstructor() const
 {
     if (numConstructors) {
-        std::list<Function>::const_iterator func;
+        BlockList<Function>::const_iterator func;
 
         for (func = functionList.begin(); func != functionList.end(); ++func) {
             if (func->type == Function::eConstructor && func->argCount() == 0)
@@ -3454,7 +3463,7 @@ const Token *Scope::checkVariable(const Token *tok, AccessControl varaccess, con
 
 const Variable *Scope::getVariable(const std::string &varname) const
 {
-    std::list<Variable>::const_iterator iter;
+    BlockList<Variable>::const_iterator iter;
 
     for (iter = varlist.begin(); iter != varlist.end(); ++iter) {
         if (iter->name() == varname)
@@ -3878,7 +3887,7 @@ static void checkVariableCallMatch(const Variable* callarg, const Variable* func
         bool ptrequals = callarg->isArrayOrPointer() == funcarg->isArrayOrPointer();
         bool constEquals = !callarg->isArrayOrPointer() || ((callarg->typeStartToken()->strAt(-1) == "const") == (funcarg->typeStartToken()->strAt(-1) == "const"));
         if (ptrequals && constEquals &&
-            callarg->typeStartToken()->str() == funcarg->typeStartToken()->str() &&
+            callarg->typeStartToken()->strEquals(funcarg->typeStartToken()) &&
             callarg->typeStartToken()->isUnsigned() == funcarg->typeStartToken()->isUnsigned() &&
             callarg->typeStartToken()->isLong() == funcarg->typeStartToken()->isLong()) {
             same++;
@@ -3907,6 +3916,11 @@ const Function* Scope::findFunction(const Token *tok, bool requireConst) const
     if (!end)
         return nullptr;
 
+    // nothing to match if there is no function with this name
+    const bool hasBase = isClassOrStruct() && definedType && !definedType->derivedFrom.empty();
+    if (!hasBase && functionMap.find(tok->str()) == functionMap.end())
+        return nullptr;
+
     std::vector<const Token *> arguments;
 
     // find all the arguments for this function call
@@ -3927,8 +3941,19 @@ const Function* Scope::findFunction(const Token *tok, bool requireConst) const
         }
     }
 
-    // check in base classes
-    findFunctionInBase(tok->str(), args, matches);
+    // check in base classes, the same base class functions are looked up for many calls
+    if (hasBase) {
+        const std::pair<std::string, size_t> key(tok->str(), args);
+        std::map<std::pair<std::string, size_t>, std::vector<const Function *> >::const_iterator it = _baseFunctionMatches.find(key);
+        if (it == _baseFunctionMatches.end()) {
+            ++check->_baseFunctionCacheMisses;
+            std::vector<const Function *> baseMatches;
+            findFunctionInBase(tok->str(), args, baseMatches);
+            it = _baseFunctionMatches.insert(std::make_pair(key, baseMatches)).first;
+        } else
+            ++check->_baseFunctionCacheHits;
+        matches.insert(matches.end(), it->second.begin(), it->second.end());
+    }
 
     const Function* fallback1Func = nullptr;
     const Function* fallback2Func = nullptr;
@@ -3979,7 +4004,7 @@ const Function* Scope::findFunction(const Token *tok, bool requireConst) const
                 if (callarg) {
                     bool funcargptr = (funcarg->typeEndToken()->str() == "*");
                     if (funcargptr &&
-                        (callarg->typeStartToken()->str() == funcarg->typeStartToken()->str() &&
+                        (callarg->typeStartToken()->strEquals(funcarg->typeStartToken()) &&
                          callarg->typeStartToken()->isUnsigned() == funcarg->typeStartToken()->isUnsigned() &&
                          callarg->typeStartToken()->isLong() == funcarg->typeStartToken()->isLong())) {
                         same++;
@@ -4282,35 +4307,29 @@ const Function* SymbolDatabase::findFunction(const Token *tok) const
 
 const Scope *SymbolDatabase::findScopeByName(const std::string& name) const
 {
-    for (std::list<Scope>::const_iterator it = scopeList.begin(); it != scopeList.end(); ++it) {
-        if (it->className == name)
-            return &*it;
-    }
-    return nullptr;
+    const std::unordered_map<std::string, const Scope *>::const_iterator it = _scopesByName.find(name);
+    return it != _scopesByName.end() ? it->second : nullptr;
 }
 
 //---------------------------------------------------------------------------
 
 Scope *Scope::findInNestedList(const std::string & name)
 {
-    std::list<Scope *>::iterator it;
-
-    for (it = nestedList.begin(); it != nestedList.end(); ++it) {
-        if ((*it)->className == name)
-            return (*it);
-    }
-    return nullptr;
+    const std::unordered_map<std::string, std::vector<Scope *> >::const_iterator it = nestedMap.find(name);
+    return it != nestedMap.end() ? it->second.front() : nullptr;
 }
 
 //---------------------------------------------------------------------------
 
 const Scope *Scope::findRecordInNestedList(const std::string & name) const
 {
-    std::list<Scope *>::const_iterator it;
+    const std::unordered_map<std::string, std::vector<Scope *> >::const_iterator it = nestedMap.find(name);
+    if (it == nestedMap.end())
+        return nullptr;
 
-    for (it = nestedList.begin(); it != nestedList.end(); ++it) {
-        if ((*it)->className == name && (*it)->type != eFunction)
-            return (*it);
+    for (std::size_t i = 0; i < it->second.size(); ++i) {
+        if (it->second[i]->type != eFunction)
+            return it->second[i];
     }
     return nullptr;
 }
@@ -4319,26 +4338,41 @@ const Scope *Scope::findRecordInNestedList(const std::string & name) const
 
 const Type* Scope::findType(const std::string & name) const
 {
-    std::list<Type*>::const_iterator it;
+    const std::unordered_map<std::string, std::vector<Type *> >::const_iterator it = definedTypesMap.find(name);
+    if (it == definedTypesMap.end())
+        return nullptr;
 
-    for (it = definedTypes.begin(); it != definedTypes.end(); ++it) {
-        if ((*it)->name() == name)
-            return (*it);
+    // the name may have changed, see addDefinedType()
+    for (std::size_t i = 0; i < it->second.size(); ++i) {
+        if (it->second[i]->name() == name)
+            return it->second[i];
     }
     return nullptr;
 }
 
 //---------------------------------------------------------------------------
 
-Scope *Scope::findInNestedListRecursive(const std::string & name)
+void Scope::addDefinedType(Type *t)
 {
-    std::list<Scope *>::iterator it;
+    definedTypes.push_back(t);
+
+    // the name of an enum class is only known when its scope is set,
+    // see Type::name(). Add it for both names.
+    const Token *nameTok = t->classDef->next();
+    definedTypesMap[nameTok->isName() ? nameTok->str() : emptyString].push_back(t);
+    if (t->isEnumType() && nameTok->str() == "class" && nameTok->next())
+        definedTypesMap[nameTok->next()->str()].push_back(t);
+}
 
-    for (it = nestedList.begin(); it != nestedList.end(); ++it) {
-        if ((*it)->className == name)
-            return (*it);
-    }
+//---------------------------------------------------------------------------
+
+Scope *Scope::findInNestedListRecursive(const std::string & name)
+{
+    Scope *nested = findInNestedList(name);
+    if (nested)
+        return nested;
 
+    std::list<Scope *>::iterator it;
     for (it = nestedList.begin(); it != nestedList.end(); ++it) {
         Scope *child = (*it)->findInNestedListRecursive(name);
         if (child)
@@ -4351,7 +4385,7 @@ Scope *Scope::findInNestedListRecursive(const std::string & name)
 
 const Function *Scope::getDestructor() const
 {
-    std::list<Function>::const_iterator it;
+    BlockList<Function>::const_iterator it;
     for (it = functionList.begin(); it != functionList.end(); ++it) {
         if (it->type == Function::eDestructor)
             return &(*it);
@@ -4665,7 +4699,7 @@ static void setAutoTokenProperties(Token * const autoTok)
 
 void SymbolDatabase::setValueType(Token *tok, const ValueType &valuetype)
 {
-    tok->setValueType(new ValueType(valuetype));
+    tok->setValueType(&valuetype);
     Token *parent = const_cast<Token *>(tok->astParent());
     if (!parent || parent->valueType())
         return;
@@ -4755,7 +4789,7 @@ void SymbolDatabase::setValueType(Token *tok, const ValueType &valuetype)
             const Scope *typeScope = vt1->typeScope;
             if (!typeScope)
                 return;
-            for (std::list<Variable>::const_iterator it = typeScope->varlist.begin(); it != typeScope->varlist.end(); ++it) {
+            for (BlockList<Variable>::const_iterator it = typeScope->varlist.begin(); it != typeScope->varlist.end(); ++it) {
                 if (it->nameToken()->str() == name) {
                     var = &*it;
                     break;
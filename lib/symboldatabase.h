@@ -21,6 +21,7 @@
 #define symboldatabaseH
 //---------------------------------------------------------------------------
 
+#include "blocklist.h"
 #include "config.h"
 #include "library.h"
 #include "mathlib.h"
@@ -31,6 +32,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -852,7 +854,7 @@ public:
     const ::Type *retType; // function return type
     const Scope *functionScope; // scope of function body
     const Scope* nestedIn; // Scope the function is declared in
-    std::list<Variable> argumentList; // argument list
+    BlockList<Variable> argumentList; // argument list
     unsigned int initArgCount; // number of args with default values
     Type type;             // constructor, destructor, ...
     AccessControl access;  // public/protected/private
@@ -893,17 +895,19 @@ public:
     const Token *classDef;   // class/struct/union/namespace token
     const Token *classStart; // '{' token
     const Token *classEnd;   // '}' token
-    std::list<Function> functionList;
+    BlockList<Function> functionList;
     std::multimap<std::string, const Function *> functionMap;
-    std::list<Variable> varlist;
+    BlockList<Variable> varlist;
     const Scope *nestedIn;
     std::list<Scope *> nestedList;
+    std::unordered_map<std::string, std::vector<Scope *> > nestedMap;
     unsigned int numConstructors;
     unsigned int numCopyOrMoveConstructors;
     std::list<UsingInfo> usingList;
     ScopeType type;
     Type* definedType;
     std::list<Type*> definedTypes;
+    std::unordered_map<std::string, std::vector<Type *> > definedTypesMap;
 
     // function specific fields
     const Scope *functionOf; // scope this function belongs to
@@ -992,6 +996,13 @@ public:
         functionMap.insert(make_pair(back->tokenDef->str(), back));
     }
 
+    void addNestedScope(Scope *scope) {
+        nestedList.push_back(scope);
+        nestedMap[scope->className].push_back(scope);
+    }
+
+    void addDefinedType(Type *t);
+
     bool hasDefaultConstructor() const;
 
     AccessControl defaultAccess() const;
@@ -1025,6 +1036,13 @@ private:
     bool isVariableDeclaration(const Token* const tok, const Token*& vartok, const Token*& typetok) const;
 
     void findFunctionInBase(const std::string & name, size_t args, std::vector<const Function *> & matches) const;
+
+    /**
+     * @brief results of findFunctionInBase() by function name and argument count.
+     * Filled by findFunction() while the symbol database is created. It is
+     * not thread-safe, findFunction() must not be called by several threads.
+     */
+    mutable std::map<std::pair<std::string, size_t>, std::vector<const Function *> > _baseFunctionMatches;
 };
 
 
@@ -1073,7 +1091,7 @@ public:
     ~SymbolDatabase();
 
     /** @brief Information about all namespaces/classes/structrues */
-    std::list<Scope> scopeList;
+    BlockList<Scope> scopeList;
 
     /** @brief Fast access to function scopes */
     std::vector<const Scope *> functionScopes;
@@ -1082,7 +1100,7 @@ public:
     std::vector<const Scope *> classAndStructScopes;
 
     /** @brief Fast access to types */
-    std::list<Type> typeList;
+    BlockList<Type> typeList;
 
     /**
      * @brief find a variable type if it's a user defined type
@@ -1203,7 +1221,14 @@ private:
     std::vector<const Variable *> _variableList;
 
     /** list for missing types */
-    std::list<Type> _blankTypes;
+    BlockList<Type> _blankTypes;
+
+    /** Lookups in Scope::_baseFunctionMatches, shown with --showtime */
+    mutable long _baseFunctionCacheHits;
+    mutable long _baseFunctionCacheMisses;
+
+    /** first scope of each name in scopeList */
+    std::unordered_map<std::string, const Scope *> _scopesByName;
 
     bool cpp;
     ValueType::Sign defaultSignedness;
@@ -816,7 +816,7 @@ void TemplateSimplifier::expandTemplate(
             if (tok3->isName()) {
                 // search for this token in the type vector
                 unsigned int itype = 0;
-                while (itype < typeParametersInDeclaration.size() && typeParametersInDeclaration[itype]->str() != tok3->str())
+                while (itype < typeParametersInDeclaration.size() && !typeParametersInDeclaration[itype]->strEquals(tok3))
                     ++itype;
 
                 // replace type with given type..
@@ -0,0 +1,125 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2016 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "threadpool.h"
+
+#include <exception>
+
+struct ThreadPool::Batch {
+    explicit Batch(Task *t) : task(t), pending(0) {
+    }
+
+    Task * const task;
+
+    /** queued and running calls */
+    std::size_t pending;
+
+    /** first exception of a pool thread */
+    std::exception_ptr exception;
+};
+
+ThreadPool::ThreadPool()
+    : _stop(false)
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _queued.notify_all();
+    for (std::vector<std::thread>::iterator thread = _threads.begin(); thread != _threads.end(); ++thread)
+        thread->join();
+}
+
+void ThreadPool::run(Task &task, std::size_t threads)
+{
+    Batch batch(&task);
+    if (threads > 1) {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            while (_threads.size() < threads - 1)
+                _threads.push_back(std::thread(&ThreadPool::work, this));
+            for (std::size_t i = 1; i < threads; ++i)
+                _queue.push_back(&batch);
+            batch.pending = threads - 1;
+        }
+        _queued.notify_all();
+    }
+
+    std::exception_ptr exception;
+    try {
+        task.run();
+    } catch (...) {
+        exception = std::current_exception();
+    }
+
+    if (threads > 1) {
+        std::unique_lock<std::mutex> lock(_mutex);
+        for (std::deque<Batch *>::iterator it = _queue.begin(); it != _queue.end();) {
+            if (*it == &batch) {
+                it = _queue.erase(it);
+                --batch.pending;
+            } else
+                ++it;
+        }
+        while (batch.pending > 0)
+            _finished.wait(lock);
+        if (!exception)
+            exception = batch.exception;
+    }
+
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+std::size_t ThreadPool::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _threads.size();
+}
+
+void ThreadPool::work()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    for (;;) {
+        while (!_stop && _queue.empty())
+            _queued.wait(lock);
+        if (_stop)
+            return;
+
+        Batch * const batch = _queue.front();
+        _queue.pop_front();
+        lock.unlock();
+
+        std::exception_ptr exception;
+        try {
+            batch->task->run();
+        } catch (...) {
+            exception = std::current_exception();
+        }
+
+        lock.lock();
+        if (exception && !batch->exception)
+            batch->exception = exception;
+        if (--batch->pending == 0)
+            _finished.notify_all();
+    }
+}
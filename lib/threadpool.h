@@ -0,0 +1,99 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2016 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef threadpoolH
+#define threadpoolH
+//---------------------------------------------------------------------------
+
+#include "config.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// @addtogroup Core
+/// @{
+
+/**
+ * @brief Worker threads that are kept for the lifetime of the pool.
+ *
+ * Threads are started when they are first needed and wait for more work
+ * until the pool is destroyed, so their thread_local caches are reused.
+ * Several callers can use the pool at the same time.
+ */
+class CPPCHECKLIB ThreadPool {
+public:
+    /** Work that is done by several threads at the same time */
+    class Task {
+    public:
+        virtual ~Task() {}
+
+        /** Called by each thread, must return when there is no work left */
+        virtual void run() = 0;
+    };
+
+    ThreadPool();
+
+    /** Stops and joins the threads. The pool must not be in use. */
+    ~ThreadPool();
+
+    /**
+     * Call task.run() in this thread and in up to threads-1 threads of the
+     * pool. Returns when all these calls have returned. Calls that have not
+     * been started by a pool thread when task.run() returns in this thread
+     * are dropped. The first exception that is thrown by a call is rethrown.
+     */
+    void run(Task &task, std::size_t threads);
+
+    /** Number of threads that have been started */
+    std::size_t size() const;
+
+private:
+    /** The calls of one run() */
+    struct Batch;
+
+    /** Main loop of a pool thread */
+    void work();
+
+    mutable std::mutex _mutex;
+
+    /** notified when calls are queued or the pool is stopped */
+    std::condition_variable _queued;
+
+    /** notified when a call is finished */
+    std::condition_variable _finished;
+
+    /** calls that have not been started yet, one entry per call */
+    std::deque<Batch *> _queue;
+
+    std::vector<std::thread> _threads;
+
+    bool _stop;
+
+    /** disabled assignment operator and copy constructor */
+    void operator=(const ThreadPool &);
+    ThreadPool(const ThreadPool &);
+};
+
+/// @}
+//---------------------------------------------------------------------------
+#endif // threadpoolH
@@ -19,13 +19,21 @@
 #include "timer.h"
 
 #include <algorithm>
+#include <cstring>
+#include <ctime>
 #include <iostream>
 #include <utility>
 #include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(_POSIX_THREAD_CPUTIME) || defined(__linux__) || defined(__APPLE__)
+#include <time.h>
+#define HAVE_THREAD_CPUTIME
+#endif
 /*
     TODO:
     - rename "file" to "single"
-    - synchronise map access in multithreaded mode or disable timing
     - add unit tests
         - for --showtime (needs input file)
         - for Timer* classes
@@ -37,58 +45,193 @@ namespace {
     {
         return lhs.second.seconds() > rhs.second.seconds();
     }
+
+    /** innermost running timer of the thread */
+    thread_local Timer *currentTimer = nullptr;
+
+    /** timer tree, used when results are written in JSON format */
+    struct TimerNode {
+        TimerNode() {}
+        TimerResultsData data;
+        std::map<std::string, TimerNode> children;
+    };
+
+    void writeJsonString(std::ostream &ostr, const std::string &str)
+    {
+        ostr << '\"';
+        for (std::string::const_iterator c = str.begin(); c != str.end(); ++c) {
+            if (*c == '\"' || *c == '\\')
+                ostr << '\\';
+            ostr << *c;
+        }
+        ostr << '\"';
+    }
+
+    void writeJsonNodes(std::ostream &ostr, const std::map<std::string, TimerNode> &nodes, unsigned int indent)
+    {
+        const std::string spaces(indent, ' ');
+        ostr << '[';
+        for (std::map<std::string, TimerNode>::const_iterator it = nodes.begin(); it != nodes.end(); ++it) {
+            ostr << (it == nodes.begin() ? "\n" : ",\n") << spaces << "{\"name\": ";
+            writeJsonString(ostr, it->first);
+            ostr << ", \"calls\": " << it->second.data._numberOfResults
+                 << ", \"wall\": " << it->second.data._wallSeconds
+                 << ", \"cpu\": " << it->second.data._cpuSeconds;
+            if (!it->second.children.empty()) {
+                ostr << ", \"children\": ";
+                writeJsonNodes(ostr, it->second.children, indent + 2);
+            }
+            ostr << '}';
+        }
+        if (!nodes.empty())
+            ostr << '\n' << std::string(indent - 2, ' ');
+        ostr << ']';
+    }
 }
 
 void TimerResults::ShowResults(SHOWTIME_MODES mode) const
 {
-    if (mode == SHOWTIME_NONE)
+    // JSON results are written to a file with writeJson()
+    if (mode == SHOWTIME_NONE || mode == SHOWTIME_JSON)
         return;
 
     std::cout << std::endl;
     TimerResultsData overallData;
 
-    std::vector<dataElementType> data(_results.begin(), _results.end());
+    // Summarize the timers with the same name
+    std::map<std::string, struct TimerResultsData> results;
+    std::unique_lock<std::mutex> lock(_resultsSync);
+    for (std::map<std::string, struct TimerResultsData>::const_iterator it = _results.begin(); it != _results.end(); ++it) {
+        const std::string::size_type pos = it->first.rfind('/');
+        const bool toplevel = (pos == std::string::npos);
+        TimerResultsData &data = results[toplevel ? it->first : it->first.substr(pos + 1)];
+        data._wallSeconds += it->second._wallSeconds;
+        data._cpuSeconds += it->second._cpuSeconds;
+        data._numberOfResults += it->second._numberOfResults;
+        if (toplevel) {
+            overallData._wallSeconds += it->second._wallSeconds;
+            overallData._cpuSeconds += it->second._cpuSeconds;
+        }
+    }
+    const std::map<std::string, long> counters(_counters);
+    lock.unlock();
+    std::vector<dataElementType> data(results.begin(), results.end());
     std::sort(data.begin(), data.end(), more_second_sec);
 
     size_t ordinal = 1; // maybe it would be nice to have an ordinal in output later!
     for (std::vector<dataElementType>::const_iterator iter=data.begin() ; iter!=data.end(); ++iter) {
         const double sec = iter->second.seconds();
         const double secAverage = sec / (double)(iter->second._numberOfResults);
-        overallData._clocks += iter->second._clocks;
         if ((mode != SHOWTIME_TOP5) || (ordinal<=5)) {
-            std::cout << iter->first << ": " << sec << "s (avg. " << secAverage << "s - " << iter->second._numberOfResults  << " result(s))" << std::endl;
+            std::cout << iter->first << ": " << sec << "s (avg. " << secAverage << "s - " << iter->second._numberOfResults  << " result(s), wall " << iter->second._wallSeconds << "s)" << std::endl;
         }
         ++ordinal;
     }
 
-    const double secOverall = overallData.seconds();
-    std::cout << "Overall time: " << secOverall << "s" << std::endl;
+    std::cout << "Overall time: " << overallData.seconds() << "s (wall " << overallData._wallSeconds << "s)" << std::endl;
+
+    for (std::map<std::string, long>::const_iterator it = counters.begin(); it != counters.end(); ++it)
+        std::cout << it->first << ": " << it->second << std::endl;
+}
+
+void TimerResults::writeJson(std::ostream &ostr) const
+{
+    TimerNode root;
+    std::map<std::string, long> counters;
+    {
+        std::lock_guard<std::mutex> lock(_resultsSync);
+        counters = _counters;
+        for (std::map<std::string, struct TimerResultsData>::const_iterator it = _results.begin(); it != _results.end(); ++it) {
+            TimerNode *node = &root;
+            std::string::size_type pos1 = 0;
+            for (;;) {
+                const std::string::size_type pos2 = it->first.find('/', pos1);
+                node = &node->children[it->first.substr(pos1, pos2 - pos1)];
+                if (pos2 == std::string::npos)
+                    break;
+                pos1 = pos2 + 1;
+            }
+            node->data = it->second;
+        }
+    }
+
+    ostr << "{\"timers\": ";
+    writeJsonNodes(ostr, root.children, 2);
+    ostr << ",\n \"counters\": {";
+    for (std::map<std::string, long>::const_iterator it = counters.begin(); it != counters.end(); ++it) {
+        ostr << (it == counters.begin() ? "" : ", ");
+        writeJsonString(ostr, it->first);
+        ostr << ": " << it->second;
+    }
+    ostr << "}}" << std::endl;
+}
+
+void TimerResults::AddResults(const std::string& path, double wallSeconds, double cpuSeconds)
+{
+    std::lock_guard<std::mutex> lock(_resultsSync);
+    TimerResultsData &data = _results[path];
+    data._wallSeconds += wallSeconds;
+    data._cpuSeconds += cpuSeconds;
+    data._numberOfResults++;
 }
 
-void TimerResults::AddResults(const std::string& str, std::clock_t clocks)
+void TimerResults::AddCount(const std::string& name, long count)
 {
-    _results[str]._clocks += clocks;
-    _results[str]._numberOfResults++;
+    std::lock_guard<std::mutex> lock(_resultsSync);
+    _counters[name] += count;
+}
+
+double Timer::cpuTime()
+{
+#if defined(_WIN32)
+    FILETIME creationTime, exitTime, kernelTime, userTime;
+    if (GetThreadTimes(GetCurrentThread(), &creationTime, &exitTime, &kernelTime, &userTime)) {
+        const unsigned long long t = ((unsigned long long)userTime.dwHighDateTime << 32) + userTime.dwLowDateTime +
+                                     ((unsigned long long)kernelTime.dwHighDateTime << 32) + kernelTime.dwLowDateTime;
+        return (double)t / 1e7;
+    }
+#elif defined(HAVE_THREAD_CPUTIME)
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+        return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+#endif
+    return (double)std::clock() / CLOCKS_PER_SEC;
 }
 
 Timer::Timer(const std::string& str, unsigned int showtimeMode, TimerResultsIntf* timerResults)
-    : _str(str)
-    , _timerResults(timerResults)
-    , _start(0)
+    : _timerResults(timerResults)
+    , _parent(nullptr)
+    , _cpuStart(0)
     , _showtimeMode(showtimeMode)
     , _stopped(false)
 {
     if (showtimeMode != SHOWTIME_NONE)
-        _start = std::clock();
+        start(str.c_str(), str.size());
 }
 
-Timer::Timer(const Timer& other)
-    : _str(other._str)
-    , _timerResults(other._timerResults)
-    , _start(other._start)
-    , _showtimeMode(other._showtimeMode)
-    , _stopped(other._stopped)
+Timer::Timer(const char str[], unsigned int showtimeMode, TimerResultsIntf* timerResults)
+    : _timerResults(timerResults)
+    , _parent(nullptr)
+    , _cpuStart(0)
+    , _showtimeMode(showtimeMode)
+    , _stopped(false)
 {
+    if (showtimeMode != SHOWTIME_NONE)
+        start(str, std::strlen(str));
+}
+
+void Timer::start(const char str[], std::size_t len)
+{
+    _parent = currentTimer;
+    if (_parent) {
+        _path = _parent->_path + '/';
+        if (!_timerResults)
+            _timerResults = _parent->_timerResults;
+    }
+    _path.append(str, len);
+    currentTimer = this;
+    _cpuStart = cpuTime();
+    _start = std::chrono::steady_clock::now();
 }
 
 Timer::~Timer()
@@ -99,15 +242,20 @@ Timer::~Timer()
 void Timer::Stop()
 {
     if ((_showtimeMode != SHOWTIME_NONE) && !_stopped) {
-        const std::clock_t end = std::clock();
-        const std::clock_t diff = end - _start;
+        const double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+        const double cpu = cpuTime() - _cpuStart;
+
+        if (currentTimer == this) {
+            currentTimer = _parent;
+            while (currentTimer && currentTimer->_stopped)
+                currentTimer = currentTimer->_parent;
+        }
 
         if (_showtimeMode == SHOWTIME_FILE) {
-            double sec = (double)diff / CLOCKS_PER_SEC;
-            std::cout << _str << ": " << sec << "s" << std::endl;
+            std::cout << _path << ": " << cpu << "s (wall " << wall << "s)" << std::endl;
         } else {
             if (_timerResults)
-                _timerResults->AddResults(_str, diff);
+                _timerResults->AddResults(_path, wall, cpu);
         }
     }
 
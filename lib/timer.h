@@ -22,64 +22,104 @@
 
 #include "config.h"
 
-#include <ctime>
+#include <chrono>
 #include <map>
+#include <mutex>
+#include <ostream>
 #include <string>
 
 enum SHOWTIME_MODES {
     SHOWTIME_NONE = 0,
     SHOWTIME_FILE,
     SHOWTIME_SUMMARY,
-    SHOWTIME_TOP5
+    SHOWTIME_TOP5,
+    SHOWTIME_JSON
 };
 
 class CPPCHECKLIB TimerResultsIntf {
 public:
     virtual ~TimerResultsIntf() { }
 
-    virtual void AddResults(const std::string& str, std::clock_t clocks) = 0;
+    /**
+     * Add the time of a timer
+     * @param path names of the enclosing timers and the timer, separated by '/'
+     * @param wallSeconds elapsed real time
+     * @param cpuSeconds CPU time of the thread
+     */
+    virtual void AddResults(const std::string& path, double wallSeconds, double cpuSeconds) = 0;
 };
 
 struct TimerResultsData {
-    std::clock_t _clocks;
+    double _wallSeconds;
+    double _cpuSeconds;
     long _numberOfResults;
 
     TimerResultsData()
-        : _clocks(0)
+        : _wallSeconds(0)
+        , _cpuSeconds(0)
         , _numberOfResults(0) {
     }
 
     double seconds() const {
-        double ret = (double)((unsigned long)_clocks) / (double)CLOCKS_PER_SEC;
-        return ret;
+        return _cpuSeconds;
     }
 };
 
+/**
+ * Collects the times of the timers. It is safe to add results from
+ * several threads.
+ */
 class CPPCHECKLIB TimerResults : public TimerResultsIntf {
 public:
     TimerResults() {
     }
 
     void ShowResults(SHOWTIME_MODES mode) const;
-    virtual void AddResults(const std::string& str, std::clock_t clocks);
+    virtual void AddResults(const std::string& path, double wallSeconds, double cpuSeconds);
+
+    /** Add to a counter that is shown after the timers */
+    void AddCount(const std::string& name, long count = 1);
+
+    /** Write the results as a tree of timers in JSON format */
+    void writeJson(std::ostream &ostr) const;
 
 private:
+    /** results for each timer path */
     std::map<std::string, struct TimerResultsData> _results;
+
+    /** counters, e.g. number of skipped configurations */
+    std::map<std::string, long> _counters;
+    mutable std::mutex _resultsSync;
 };
 
+/**
+ * Measures wall clock time and CPU time of a scope.
+ *
+ * Timers are hierarchical: a timer that is created while another timer is
+ * running in the same thread is a child of that timer. If no
+ * TimerResultsIntf is given, the results of the enclosing timer are used.
+ */
 class CPPCHECKLIB Timer {
 public:
     Timer(const std::string& str, unsigned int showtimeMode, TimerResultsIntf* timerResults = nullptr);
-    Timer(const Timer& other);
+    Timer(const char str[], unsigned int showtimeMode, TimerResultsIntf* timerResults = nullptr);
     ~Timer();
     void Stop();
 
+    /** CPU time of the current thread in seconds */
+    static double cpuTime();
+
 private:
+    Timer(const Timer&); // disallow copying
     Timer& operator=(const Timer&); // disallow assignments
 
-    const std::string _str;
+    void start(const char str[], std::size_t len);
+
+    std::string _path;
     TimerResultsIntf* _timerResults;
-    std::clock_t _start;
+    Timer* _parent;
+    std::chrono::steady_clock::time_point _start;
+    double _cpuStart;
     const unsigned int _showtimeMode;
     bool _stopped;
 };
@@ -22,6 +22,8 @@
 #include "library.h"
 #include "settings.h"
 #include "symboldatabase.h"
+#include "tokenarena.h"
+#include "tokenlist.h"
 #include "utils.h"
 
 #include <cassert>
@@ -29,12 +31,16 @@
 #include <cstring>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <new>
 #include <set>
 #include <stack>
+#include <unordered_map>
 #include <utility>
 
-Token::Token(Token **tokens) :
-    tokensBack(tokens),
+Token::Token(TokenListState *state) :
+    tokenListState(state),
+    _str(TokenArena::emptyText()),
     _next(nullptr),
     _previous(nullptr),
     _link(nullptr),
@@ -45,6 +51,7 @@ Token::Token(Token **tokens) :
     _linenr(0),
     _col(0),
     _progressValue(0),
+    _index(0),
     _tokType(eNone),
     _flags(0),
     _astOperand1(nullptr),
@@ -58,54 +65,115 @@ Token::Token(Token **tokens) :
 
 Token::~Token()
 {
-    delete _originalName;
-    delete valuetype;
+    if (!arena() && _str != TokenArena::emptyText())
+        TokenArena::destroy(const_cast<std::string *>(_str));
+    TokenArena::destroy(_originalName);
+    TokenArena::destroy(valuetype);
     delete _values;
 }
 
+void *Token::operator new(std::size_t size)
+{
+    return TokenArena::allocate(nullptr, size);
+}
+
+void *Token::operator new(std::size_t size, TokenArena *arena)
+{
+    return TokenArena::allocate(arena, size);
+}
+
+void Token::operator delete(void *p, std::size_t size)
+{
+    TokenArena::deallocate(p, size);
+}
+
+void Token::operator delete(void *p, TokenArena *)
+{
+    TokenArena::deallocate(p, sizeof(Token));
+}
+
+TokenArena *Token::arena() const
+{
+    return tokenListState ? tokenListState->arena : nullptr;
+}
+
+std::string *Token::newString() const
+{
+    return new (TokenArena::allocate(arena(), sizeof(std::string))) std::string;
+}
+
+void Token::setText(const std::string &s)
+{
+    if (arena()) {
+        _str = TokenArena::intern(arena(), s);
+        return;
+    }
+
+    // The text of a token that is not in a token list is owned by the token
+    const std::string * const old = _str;
+    _str = s.empty() ? TokenArena::emptyText() : new (TokenArena::allocate(nullptr, sizeof(std::string))) std::string(s);
+    if (old != TokenArena::emptyText())
+        TokenArena::destroy(const_cast<std::string *>(old));
+}
+
+void Token::str(const std::string &s)
+{
+    setText(s);
+    _varId = 0;
+
+    update_property_info();
+}
+
+bool Token::strEquals(const Token *tok) const
+{
+    if (_str == tok->_str)
+        return true;
+    return (arena() != tok->arena() || !arena()) && *_str == *tok->_str;
+}
+
 void Token::update_property_info()
 {
-    if (!_str.empty()) {
-        if (_str == "true" || _str == "false")
+    if (!_str->empty()) {
+        if (*_str == "true" || *_str == "false")
             _tokType = eBoolean;
-        else if (std::isalpha((unsigned char)_str[0]) || _str[0] == '_' || _str[0] == '$') { // Name
+        else if (std::isalpha((unsigned char)(*_str)[0]) || (*_str)[0] == '_' || (*_str)[0] == '$') { // Name
             if (_varId)
                 _tokType = eVariable;
             else if (_tokType != eVariable && _tokType != eFunction && _tokType != eType && _tokType != eKeyword)
                 _tokType = eName;
-        } else if (std::isdigit((unsigned char)_str[0]) || (_str.length() > 1 && _str[0] == '-' && std::isdigit((unsigned char)_str[1])))
+        } else if (std::isdigit((unsigned char)(*_str)[0]) || (_str->length() > 1 && (*_str)[0] == '-' && std::isdigit((unsigned char)(*_str)[1])))
             _tokType = eNumber;
-        else if (_str.length() > 1 && _str[0] == '"' && endsWith(_str,'"'))
+        else if (_str->length() > 1 && (*_str)[0] == '"' && endsWith(*_str,'"'))
             _tokType = eString;
-        else if (_str.length() > 1 && _str[0] == '\'' && endsWith(_str,'\''))
+        else if (_str->length() > 1 && (*_str)[0] == '\'' && endsWith(*_str,'\''))
             _tokType = eChar;
-        else if (_str == "=" || _str == "<<=" || _str == ">>=" ||
-                 (_str.size() == 2U && _str[1] == '=' && std::strchr("+-*/%&^|", _str[0])))
+        else if (*_str == "=" || *_str == "<<=" || *_str == ">>=" ||
+                 (_str->size() == 2U && (*_str)[1] == '=' && std::strchr("+-*/%&^|", (*_str)[0])))
             _tokType = eAssignmentOp;
-        else if (_str.size() == 1 && _str.find_first_of(",[]()?:") != std::string::npos)
+        else if (_str->size() == 1 && _str->find_first_of(",[]()?:") != std::string::npos)
             _tokType = eExtendedOp;
-        else if (_str=="<<" || _str==">>" || (_str.size()==1 && _str.find_first_of("+-*/%") != std::string::npos))
+        else if (*_str == "<<" || *_str == ">>" || (_str->size()==1 && _str->find_first_of("+-*/%") != std::string::npos))
             _tokType = eArithmeticalOp;
-        else if (_str.size() == 1 && _str.find_first_of("&|^~") != std::string::npos)
+        else if (_str->size() == 1 && _str->find_first_of("&|^~") != std::string::npos)
             _tokType = eBitOp;
-        else if (_str.size() <= 2 &&
-                 (_str == "&&" ||
-                  _str == "||" ||
-                  _str == "!"))
+        else if (_str->size() <= 2 &&
+                 (*_str == "&&" ||
+                  *_str == "||" ||
+                  *_str == "!"))
             _tokType = eLogicalOp;
-        else if (_str.size() <= 2 && !_link &&
-                 (_str == "==" ||
-                  _str == "!=" ||
-                  _str == "<"  ||
-                  _str == "<=" ||
-                  _str == ">"  ||
-                  _str == ">="))
+        else if (_str->size() <= 2 && !_link &&
+                 (*_str == "==" ||
+                  *_str == "!=" ||
+                  *_str == "<"  ||
+                  *_str == "<=" ||
+                  *_str == ">"  ||
+                  *_str == ">="))
             _tokType = eComparisonOp;
-        else if (_str.size() == 2 &&
-                 (_str == "++" ||
-                  _str == "--"))
+        else if (_str->size() == 2 &&
+                 (*_str == "++" ||
+                  *_str == "--"))
             _tokType = eIncDecOp;
-        else if (_str.size() == 1 && (_str.find_first_of("{}") != std::string::npos || (_link && _str.find_first_of("<>") != std::string::npos)))
+        else if (_str->size() == 1 && (_str->find_first_of("{}") != std::string::npos || (_link && _str->find_first_of("<>") != std::string::npos)))
             _tokType = eBracket;
         else
             _tokType = eOther;
@@ -133,10 +201,10 @@ void Token::update_property_isStandardType()
 {
     isStandardType(false);
 
-    if (_str.size() < 3)
+    if (_str->size() < 3)
         return;
 
-    if (stdTypes.find(_str)!=stdTypes.end()) {
+    if (stdTypes.find(*_str)!=stdTypes.end()) {
         isStandardType(true);
         _tokType = eType;
     }
@@ -147,8 +215,8 @@ bool Token::isUpperCaseName() const
 {
     if (!isName())
         return false;
-    for (size_t i = 0; i < _str.length(); ++i) {
-        if (std::islower(_str[i]))
+    for (size_t i = 0; i < _str->length(); ++i) {
+        if (std::islower((*_str)[i]))
             return false;
     }
     return true;
@@ -156,8 +224,9 @@ bool Token::isUpperCaseName() const
 
 void Token::concatStr(std::string const& b)
 {
-    _str.erase(_str.length() - 1);
-    _str.append(b.begin() + 1, b.end());
+    std::string s(_str->begin(), _str->end() - 1);
+    s.append(b.begin() + 1, b.end());
+    setText(s);
 
     update_property_info();
 }
@@ -165,7 +234,7 @@ void Token::concatStr(std::string const& b)
 std::string Token::strValue() const
 {
     assert(_tokType == eString);
-    std::string ret(_str.substr(1, _str.length() - 2));
+    std::string ret(_str->substr(1, _str->length() - 2));
     std::string::size_type pos = 0U;
     while ((pos = ret.find('\\', pos)) != std::string::npos) {
         ret.erase(pos,1U);
@@ -195,8 +264,8 @@ void Token::deleteNext(unsigned long index)
 
     if (_next)
         _next->previous(this);
-    else if (tokensBack)
-        *tokensBack = this;
+    else if (tokenListState)
+        tokenListState->back = this;
 }
 
 void Token::swapWithNext()
@@ -225,7 +294,7 @@ void Token::swapWithNext()
 void Token::deleteThis()
 {
     if (_next) { // Copy next to this and delete next
-        _str = _next->_str;
+        std::swap(_str, _next->_str);
         _tokType = _next->_tokType;
         _flags = _next->_flags;
         _varId = _next->_varId;
@@ -235,7 +304,7 @@ void Token::deleteThis()
         _scope = _next->_scope;
         _function = _next->_function;
         if (_next->_originalName) {
-            delete _originalName;
+            TokenArena::destroy(_originalName);
             _originalName = _next->_originalName;
             _next->_originalName = nullptr;
         }
@@ -245,7 +314,7 @@ void Token::deleteThis()
             _next->_values = nullptr;
         }
         if (_next->valuetype) {
-            delete valuetype;
+            TokenArena::destroy(valuetype);
             valuetype = _next->valuetype;
             _next->valuetype = nullptr;
         }
@@ -254,7 +323,7 @@ void Token::deleteThis()
 
         deleteNext();
     } else if (_previous && _previous->_previous) { // Copy previous to this and delete previous
-        _str = _previous->_str;
+        std::swap(_str, _previous->_str);
         _tokType = _previous->_tokType;
         _flags = _previous->_flags;
         _varId = _previous->_varId;
@@ -264,7 +333,7 @@ void Token::deleteThis()
         _scope = _previous->_scope;
         _function = _previous->_function;
         if (_previous->_originalName) {
-            delete _originalName;
+            TokenArena::destroy(_originalName);
             _originalName = _previous->_originalName;
             _previous->_originalName = nullptr;
         }
@@ -274,7 +343,7 @@ void Token::deleteThis()
             _previous->_values = nullptr;
         }
         if (_previous->valuetype) {
-            delete valuetype;
+            TokenArena::destroy(valuetype);
             valuetype = _previous->valuetype;
             _previous->valuetype = nullptr;
         }
@@ -312,10 +381,10 @@ void Token::replace(Token *replaceThis, Token *start, Token *end)
     start->previous(replaceThis->previous());
     end->next(replaceThis->next());
 
-    if (end->tokensBack && *(end->tokensBack) == end) {
+    if (end->tokenListState && end->tokenListState->back == end) {
         while (end->next())
             end = end->next();
-        *(end->tokensBack) = end;
+        end->tokenListState->back = end;
     }
 
     // Update _progressValue, fileIndex and linenr
@@ -352,7 +421,7 @@ const Token *Token::linkAt(int index) const
 const std::string &Token::strAt(int index) const
 {
     const Token *tok = this->tokAt(index);
-    return tok ? tok->_str : emptyString;
+    return tok ? *tok->_str : emptyString;
 }
 
 static int multiComparePercent(const Token *tok, const char*& haystack, unsigned int varid)
@@ -557,7 +626,7 @@ bool Token::simpleMatch(const Token *tok, const char pattern[])
     while (*current) {
         std::size_t length = next - current;
 
-        if (!tok || length != tok->_str.length() || std::strncmp(current, tok->_str.c_str(), length))
+        if (!tok || length != tok->_str->length() || std::strncmp(current, tok->_str->c_str(), length))
             return false;
 
         current = next;
@@ -600,7 +669,7 @@ const char *Token::chrInFirstWord(const char *str, char c)
     }
 }
 
-bool Token::Match(const Token *tok, const char pattern[], unsigned int varid)
+bool Token::interpretedMatch(const Token *tok, const char pattern[], unsigned int varid)
 {
     const char *p = pattern;
     while (*p) {
@@ -687,6 +756,210 @@ bool Token::Match(const Token *tok, const char pattern[], unsigned int varid)
     return true;
 }
 
+MatchPattern::MatchPattern(const char pattern[]) : _pattern(pattern)
+{
+    std::string::size_type pos = 0;
+    while (pos < _pattern.size()) {
+        // Skip spaces in pattern..
+        if (_pattern[pos] == ' ') {
+            ++pos;
+            continue;
+        }
+
+        std::string::size_type end = _pattern.find(' ', pos);
+        if (end == std::string::npos)
+            end = _pattern.size();
+        const std::string word = _pattern.substr(pos, end - pos);
+
+        Word w;
+        w.offset = pos;
+        if (word[0] == '[' && word.find(']') != std::string::npos) {
+            // "[;{}]" => one-character token. ']' is matched when it is given twice: "[]]"
+            w.kind = Word::CHARSET;
+            unsigned int count = 0;
+            for (std::string::size_type i = 1; i < word.size(); ++i) {
+                if (word[i] == ']')
+                    ++count;
+                else
+                    w.str += word[i];
+            }
+            w.closingBracket = (count > 1);
+        } else if (word.compare(0, 2, "!!") == 0 && pos + 2 < _pattern.size()) {
+            w.kind = Word::NOT;
+            w.str = word.substr(2);
+        } else if (!parseMulti(word, w)) {
+            w.kind = Word::INTERPRETED;
+        }
+        _words.push_back(w);
+
+        pos = end;
+    }
+}
+
+bool MatchPattern::parseMulti(const std::string &word, Word &w)
+{
+    static const struct {
+        const char *str;
+        Alternative::Kind kind;
+    } commands[] = {
+        { "%any%", Alternative::ANY },
+        { "%assign%", Alternative::ASSIGN },
+        { "%bool%", Alternative::BOOL },
+        { "%char%", Alternative::CHAR },
+        { "%comp%", Alternative::COMP },
+        { "%cop%", Alternative::COP },
+        { "%name%", Alternative::NAME },
+        { "%num%", Alternative::NUM },
+        { "%op%", Alternative::OP },
+        { "%or%", Alternative::OR },
+        { "%oror%", Alternative::OROR },
+        { "%str%", Alternative::STR },
+        { "%type%", Alternative::TYPE },
+        { "%var%", Alternative::VAR },
+        { "%varid%", Alternative::VARID }
+    };
+
+    w.kind = Word::MULTI;
+    std::string::size_type pos = 0;
+    for (;;) {
+        std::string::size_type end = word.find('|', pos);
+        const bool last = (end == std::string::npos);
+        if (last)
+            end = word.size();
+        const std::string alternative = word.substr(pos, end - pos);
+
+        if (alternative.empty()) {
+            // Only a trailing empty alternative means "no token"
+            if (last)
+                w.optional = true;
+        } else if (alternative[0] == '%' && alternative.size() > 1) {
+            std::size_t i = 0;
+            while (i < sizeof(commands) / sizeof(commands[0]) && alternative != commands[i].str)
+                ++i;
+            if (i == sizeof(commands) / sizeof(commands[0]))
+                return false;
+            w.alternatives.push_back(Alternative(commands[i].kind, alternative));
+        } else {
+            w.alternatives.push_back(Alternative(Alternative::LITERAL, alternative));
+        }
+
+        if (last)
+            return true;
+        pos = end + 1;
+    }
+}
+
+bool MatchPattern::matchAlternative(const Token *tok, const Alternative &alternative, unsigned int varid)
+{
+    switch (alternative.kind) {
+    case Alternative::LITERAL:
+        return tok->str() == alternative.str;
+    case Alternative::ANY:
+        return true;
+    case Alternative::ASSIGN:
+        return tok->isAssignmentOp();
+    case Alternative::BOOL:
+        return tok->isBoolean();
+    case Alternative::CHAR:
+        return tok->tokType() == Token::eChar;
+    case Alternative::COMP:
+        return tok->isComparisonOp();
+    case Alternative::COP:
+        return tok->isConstOp();
+    case Alternative::NAME:
+        return tok->isName();
+    case Alternative::NUM:
+        return tok->isNumber();
+    case Alternative::OP:
+        return tok->isOp();
+    case Alternative::OR:
+        return tok->tokType() == Token::eBitOp && tok->str() == "|";
+    case Alternative::OROR:
+        return tok->tokType() == Token::eLogicalOp && tok->str() == "||";
+    case Alternative::STR:
+        return tok->tokType() == Token::eString;
+    case Alternative::TYPE:
+        return tok->isName() && tok->varId() == 0 && !tok->isKeyword();
+    case Alternative::VAR:
+        return tok->varId() != 0;
+    case Alternative::VARID:
+        if (varid == 0)
+            throw InternalError(tok, "Internal error. Token::Match called with varid 0. Please report this to Cppcheck developers");
+        return tok->varId() == varid;
+    }
+    return false;
+}
+
+bool MatchPattern::match(const Token *tok, unsigned int varid) const
+{
+    for (std::vector<Word>::const_iterator w = _words.begin(); w != _words.end(); ++w) {
+        if (!tok) {
+            // If we have no tokens, pattern "!!else" should return true
+            if (w->kind == Word::NOT)
+                continue;
+            return false;
+        }
+
+        if (w->kind == Word::CHARSET) {
+            if (tok->str().length() != 1)
+                return false;
+            if (tok->str()[0] == ']' ? !w->closingBracket : w->str.find(tok->str()[0]) == std::string::npos)
+                return false;
+        } else if (w->kind == Word::NOT) {
+            if (tok->str() == w->str)
+                return false;
+        } else if (w->kind == Word::MULTI && !tok->str().empty()) {
+            std::vector<Alternative>::const_iterator alternative = w->alternatives.begin();
+            while (alternative != w->alternatives.end() && !matchAlternative(tok, *alternative, varid))
+                ++alternative;
+            if (alternative == w->alternatives.end()) {
+                if (w->optional)
+                    continue; // Empty alternative matches, use the same token on next round
+                return false;
+            }
+        } else {
+            const int res = Token::multiCompare(tok, _pattern.c_str() + w->offset, varid);
+            if (res == 0)
+                continue;
+            if (res == -1)
+                return false;
+        }
+
+        tok = tok->next();
+    }
+
+    // The end of the pattern has been reached and nothing wrong has been found
+    return true;
+}
+
+namespace {
+    struct CompiledPatternSlot {
+        const char *pattern;
+        const MatchPattern *compiled;
+    };
+
+    // Direct mapped cache in front of the table that owns the parsed patterns
+    const std::size_t numberOfCompiledPatternSlots = 2048;
+    thread_local CompiledPatternSlot compiledPatternSlots[numberOfCompiledPatternSlots];
+
+    // Parsed patterns by the address of the pattern array
+    thread_local std::unordered_map<const char *, std::unique_ptr<MatchPattern> > compiledPatterns;
+}
+
+const MatchPattern &Token::compiledPattern(const char pattern[])
+{
+    const std::size_t address = reinterpret_cast<std::size_t>(pattern);
+    CompiledPatternSlot &slot = compiledPatternSlots[(address ^ (address >> 11)) % numberOfCompiledPatternSlots];
+    if (slot.pattern != pattern) {
+        std::unique_ptr<MatchPattern> &compiled = compiledPatterns[pattern];
+        if (!compiled)
+            compiled.reset(new MatchPattern(pattern));
+        slot.pattern = pattern;
+        slot.compiled = compiled.get();
+    }
+    return *slot.compiled;
+}
+
 std::size_t Token::getStrLength(const Token *tok)
 {
     assert(tok != nullptr);
@@ -826,7 +1099,7 @@ const Token * Token::findClosingBracket() const
 {
     const Token *closing = nullptr;
 
-    if (_str == "<") {
+    if (*_str == "<") {
         unsigned int depth = 0;
         for (closing = this; closing != nullptr; closing = closing->next()) {
             if (Token::Match(closing, "{|[|(")) {
@@ -905,10 +1178,10 @@ void Token::insertToken(const std::string &tokenStr, const std::string &original
         return;
 
     Token *newToken;
-    if (_str.empty())
+    if (_str->empty())
         newToken = this;
     else
-        newToken = new Token(tokensBack);
+        newToken = new (arena()) Token(tokenListState);
     newToken->str(tokenStr);
     if (!originalNameStr.empty())
         newToken->originalName(originalNameStr);
@@ -930,8 +1203,8 @@ void Token::insertToken(const std::string &tokenStr, const std::string &original
             if (this->next()) {
                 newToken->next(this->next());
                 newToken->next()->previous(newToken);
-            } else if (tokensBack) {
-                *tokensBack = newToken;
+            } else if (tokenListState) {
+                tokenListState->back = newToken;
             }
             this->next(newToken);
             newToken->previous(this);
@@ -990,14 +1263,14 @@ void Token::stringify(std::ostream& os, bool varid, bool attributes, bool macro)
     }
     if (macro && isExpandedMacro())
         os << "$";
-    if (_str[0] != '\"' || _str.find('\0') == std::string::npos)
-        os << _str;
+    if ((*_str)[0] != '\"' || _str->find('\0') == std::string::npos)
+        os << *_str;
     else {
-        for (std::size_t i = 0U; i < _str.size(); ++i) {
-            if (_str[i] == '\0')
+        for (std::size_t i = 0U; i < _str->size(); ++i) {
+            if ((*_str)[i] == '\0')
                 os << "\\0";
             else
-                os << _str[i];
+                os << (*_str)[i];
         }
     }
     if (varid && _varId != 0)
@@ -1309,7 +1582,7 @@ std::string Token::astStringVerbose(const unsigned int indent1, const unsigned i
 
     if (isExpandedMacro())
         ret += '$';
-    ret += _str;
+    ret += *_str;
     if (valuetype)
         ret += " \'" + valuetype->str() + '\'';
     ret += '\n';
@@ -1350,7 +1623,7 @@ void Token::printValueFlow(bool xml, std::ostream &out) const
             if (tok->_values->size() > 1U)
                 out << '{';
         }
-        for (std::list<ValueFlow::Value>::const_iterator it=tok->_values->begin(); it!=tok->_values->end(); ++it) {
+        for (ValueFlow::TokenValues::const_iterator it=tok->_values->begin(); it!=tok->_values->end(); ++it) {
             if (xml) {
                 out << "      <value ";
                 switch (it->valueType) {
@@ -1423,7 +1696,7 @@ const ValueFlow::Value * Token::getValueLE(const MathLib::bigint val, const Sett
     if (!_values)
         return nullptr;
     const ValueFlow::Value *ret = nullptr;
-    std::list<ValueFlow::Value>::const_iterator it;
+    ValueFlow::TokenValues::const_iterator it;
     for (it = _values->begin(); it != _values->end(); ++it) {
         if (it->isIntValue() && it->intvalue <= val) {
             if (!ret || ret->inconclusive || (ret->condition && !it->inconclusive))
@@ -1446,7 +1719,7 @@ const ValueFlow::Value * Token::getValueGE(const MathLib::bigint val, const Sett
     if (!_values)
         return nullptr;
     const ValueFlow::Value *ret = nullptr;
-    std::list<ValueFlow::Value>::const_iterator it;
+    ValueFlow::TokenValues::const_iterator it;
     for (it = _values->begin(); it != _values->end(); ++it) {
         if (it->isIntValue() && it->intvalue >= val) {
             if (!ret || ret->inconclusive || (ret->condition && !it->inconclusive))
@@ -1469,7 +1742,7 @@ const ValueFlow::Value * Token::getInvalidValue(const Token *ftok, unsigned int
     if (!_values)
         return nullptr;
     const ValueFlow::Value *ret = nullptr;
-    std::list<ValueFlow::Value>::const_iterator it;
+    ValueFlow::TokenValues::const_iterator it;
     for (it = _values->begin(); it != _values->end(); ++it) {
         if (it->isIntValue() && !settings->library.isargvalid(ftok, argnr, it->intvalue)) {
             if (!ret || ret->inconclusive || (ret->condition && !it->inconclusive))
@@ -1493,7 +1766,7 @@ const Token *Token::getValueTokenMinStrSize() const
         return nullptr;
     const Token *ret = nullptr;
     std::size_t minsize = ~0U;
-    std::list<ValueFlow::Value>::const_iterator it;
+    ValueFlow::TokenValues::const_iterator it;
     for (it = _values->begin(); it != _values->end(); ++it) {
         if (it->isTokValue() && it->tokvalue && it->tokvalue->tokType() == Token::eString) {
             std::size_t size = getStrSize(it->tokvalue);
@@ -1512,7 +1785,7 @@ const Token *Token::getValueTokenMaxStrLength() const
         return nullptr;
     const Token *ret = nullptr;
     std::size_t maxlength = 0U;
-    std::list<ValueFlow::Value>::const_iterator it;
+    ValueFlow::TokenValues::const_iterator it;
     for (it = _values->begin(); it != _values->end(); ++it) {
         if (it->isTokValue() && it->tokvalue && it->tokvalue->tokType() == Token::eString) {
             std::size_t length = getStrLength(it->tokvalue);
@@ -1536,7 +1809,7 @@ const Token *Token::getValueTokenDeadPointer() const
 {
     const Scope * const functionscope = getfunctionscope(this->scope());
 
-    std::list<ValueFlow::Value>::const_iterator it;
+    ValueFlow::TokenValues::const_iterator it;
     for (it = values().begin(); it != values().end(); ++it) {
         // Is this a pointer alias?
         if (!it->isTokValue() || (it->tokvalue && it->tokvalue->str() != "&"))
@@ -1565,7 +1838,7 @@ const Token *Token::getValueTokenDeadPointer() const
     return nullptr;
 }
 
-bool Token::addValue(const ValueFlow::Value &value)
+bool Token::addValue(const ValueFlow::Value &value, std::size_t maxValues)
 {
     if (value.isKnown() && _values) {
         // Clear all other values since value is known
@@ -1573,13 +1846,12 @@ bool Token::addValue(const ValueFlow::Value &value)
     }
 
     if (_values) {
-        // Don't handle more than 10 values for performance reasons
-        // TODO: add setting?
-        if (_values->size() >= 10U)
+        // Don't handle too many values for performance reasons
+        if (_values->size() >= maxValues)
             return false;
 
         // if value already exists, don't add it again
-        std::list<ValueFlow::Value>::iterator it;
+        ValueFlow::TokenValues::iterator it;
         for (it = _values->begin(); it != _values->end(); ++it) {
             // different intvalue => continue
             if (it->intvalue != value.intvalue)
@@ -1614,7 +1886,8 @@ bool Token::addValue(const ValueFlow::Value &value)
         ValueFlow::Value v(value);
         if (v.varId == 0)
             v.varId = _varId;
-        _values = new std::list<ValueFlow::Value>(1, v);
+        _values = new ValueFlow::TokenValues;
+        _values->push_back(v);
     }
 
     return true;
@@ -1630,11 +1903,18 @@ void Token::assignProgressValues(Token *tok)
         tok2->_progressValue = count++ * 100 / total_count;
 }
 
-void Token::setValueType(ValueType *vt)
+void Token::assignIndexes(Token *tok)
+{
+    unsigned int index = 0;
+    for (Token *tok2 = tok; tok2; tok2 = tok2->next())
+        tok2->_index = ++index;
+}
+
+void Token::setValueType(const ValueType *vt)
 {
     if (vt != valuetype) {
-        delete valuetype;
-        valuetype = vt;
+        TokenArena::destroy(valuetype);
+        valuetype = vt ? new (TokenArena::allocate(arena(), sizeof(ValueType))) ValueType(*vt) : nullptr;
     }
 }
 
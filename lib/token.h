@@ -29,19 +29,88 @@
 #include <list>
 #include <ostream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 class Enumerator;
 class Function;
 class Scope;
 class Settings;
+class Token;
+class TokenArena;
 class Type;
+struct TokenListState;
 class ValueType;
 class Variable;
 
 /// @addtogroup Core
 /// @{
 
+/**
+ * @brief A Token::Match() pattern that has been parsed once.
+ *
+ * The words of the pattern are classified when the pattern is created so
+ * matching a token only needs to compare it with the prepared words. The
+ * result is always the same as when the pattern text is interpreted.
+ */
+class CPPCHECKLIB MatchPattern {
+public:
+    explicit MatchPattern(const char pattern[]);
+
+    /** @return the pattern text */
+    const std::string &str() const {
+        return _pattern;
+    }
+
+    /** Same as Token::Match(tok, str().c_str(), varid) */
+    bool match(const Token *tok, unsigned int varid = 0) const;
+
+private:
+    /** One alternative in a multi compare word like "void|%type%" */
+    struct Alternative {
+        enum Kind { LITERAL, ANY, ASSIGN, BOOL, CHAR, COMP, COP, NAME, NUM, OP, OR, OROR, STR, TYPE, VAR, VARID };
+
+        Alternative(Kind k, const std::string &s) : kind(k), str(s) {}
+
+        Kind kind;
+        std::string str;
+    };
+
+    struct Word {
+        enum Kind {
+            MULTI,      ///< "int|char|", "%name%", "{"
+            CHARSET,    ///< "[;{}]"
+            NOT,        ///< "!!else"
+            INTERPRETED ///< anything unusual, handled by Token::multiCompare()
+        };
+
+        Word() : kind(MULTI), optional(false), closingBracket(false), offset(0) {}
+
+        Kind kind;
+
+        /** MULTI: the alternatives in the order they are written */
+        std::vector<Alternative> alternatives;
+
+        /** MULTI: the word has an empty alternative, "int|" */
+        bool optional;
+
+        /** CHARSET: the characters. NOT: the string that must not match */
+        std::string str;
+
+        /** CHARSET: ']' is in the set, "[]]" */
+        bool closingBracket;
+
+        /** offset of the word in the pattern text */
+        std::size_t offset;
+    };
+
+    static bool parseMulti(const std::string &word, Word &w);
+    static bool matchAlternative(const Token *tok, const Alternative &alternative, unsigned int varid);
+
+    std::string _pattern;
+    std::vector<Word> _words;
+};
+
 /**
  * @brief The token list that the TokenList generates is a linked-list of this class.
  *
@@ -54,7 +123,7 @@ class Variable;
  */
 class CPPCHECKLIB Token {
 private:
-    Token **tokensBack;
+    TokenListState *tokenListState;
 
     // Not implemented..
     Token();
@@ -71,16 +140,16 @@ public:
         eNone
     };
 
-    explicit Token(Token **tokens);
+    explicit Token(TokenListState *state);
     ~Token();
 
-    template<typename T>
-    void str(T&& s) {
-        _str = s;
-        _varId = 0;
+    /** Tokens are allocated from the arena of their TokenList */
+    static void *operator new(std::size_t size);
+    static void *operator new(std::size_t size, TokenArena *arena);
+    static void operator delete(void *p, std::size_t size);
+    static void operator delete(void *p, TokenArena *arena);
 
-        update_property_info();
-    }
+    void str(const std::string &s);
 
     /**
      * Concatenate two (quoted) strings. Automatically cuts of the last/first character.
@@ -89,9 +158,15 @@ public:
     void concatStr(std::string const& b);
 
     const std::string &str() const {
-        return _str;
+        return *_str;
     }
 
+    /**
+     * Compare the texts of two tokens. Texts are shared by the tokens
+     * of a list, so this is an address compare for tokens of one list.
+     */
+    bool strEquals(const Token *tok) const;
+
     /**
      * Unlink and delete the next 'index' tokens.
      */
@@ -190,8 +265,38 @@ public:
      * will be matched against this argument
      * @return true if given token matches with given pattern
      *         false if given token does not match with given pattern
+     *
+     * @note A pattern in a const array, i.e. a string literal, is parsed
+     * only once per thread, see compiledPattern(). The array must not change
+     * while the program runs, so a local const array must be static.
+     * Patterns in non-const arrays and pointers are interpreted by
+     * interpretedMatch().
      */
-    static bool Match(const Token *tok, const char pattern[], unsigned int varid = 0);
+    template<std::size_t N>
+    static bool Match(const Token *tok, const char (&pattern)[N], unsigned int varid = 0) {
+        return compiledPattern(pattern).match(tok, varid);
+    }
+
+    template<std::size_t N>
+    static bool Match(const Token *tok, char (&pattern)[N], unsigned int varid = 0) {
+        return interpretedMatch(tok, pattern, varid);
+    }
+
+    template<class T>
+    static typename std::enable_if<std::is_same<T, const char *>::value || std::is_same<T, char *>::value, bool>::type
+    Match(const Token *tok, T pattern, unsigned int varid = 0) {
+        return interpretedMatch(tok, pattern, varid);
+    }
+
+    /** Same as Match() but the pattern text is parsed on every call */
+    static bool interpretedMatch(const Token *tok, const char pattern[], unsigned int varid = 0);
+
+    /**
+     * Get the parsed form of a pattern array with static storage duration
+     * (i.e. a string literal). The patterns are cached by address only, the
+     * text is not compared.
+     */
+    static const MatchPattern &compiledPattern(const char pattern[]);
 
     /**
      * @return length of C-string.
@@ -224,7 +329,8 @@ public:
     const ValueType *valueType() const {
         return valuetype;
     }
-    void setValueType(ValueType *vt);
+    /** Set a copy of the given value type, nullptr => no value type */
+    void setValueType(const ValueType *vt);
 
     const ValueType *argumentType() const {
         const Token *top = this;
@@ -577,7 +683,7 @@ public:
      */
     void link(Token *linkToToken) {
         _link = linkToToken;
-        if (_str == "<" || _str == ">")
+        if (*_str == "<" || *_str == ">")
             update_property_info();
     }
 
@@ -709,6 +815,26 @@ public:
     /** Calculate progress values for all tokens */
     static void assignProgressValues(Token *tok);
 
+    /**
+     * Get position of token in the token list. The value is only
+     * meaningful after assignIndexes() and until the list is modified.
+     */
+    unsigned int index() const {
+        return _index;
+    }
+
+    /**
+     * Set position of token. Tokenizer::simplifyTypedef() numbers the
+     * tokens with gaps. ValueFlow::setValues() calls assignIndexes()
+     * before it uses the positions, other code must do the same.
+     */
+    void index(unsigned int pos) {
+        _index = pos;
+    }
+
+    /** Number all tokens in order, starting at 1 */
+    static void assignIndexes(Token *tok);
+
     /**
      * @return the first token of the next argument. Does only work on argument
      * lists. Requires that Tokenizer::createLinks2() has been called before.
@@ -745,9 +871,9 @@ public:
         return _originalName ? *_originalName : emptyString;
     }
 
-    const std::list<ValueFlow::Value>& values() const {
-        static const std::list<ValueFlow::Value> emptyList;
-        return _values ? *_values : emptyList;
+    const ValueFlow::TokenValues& values() const {
+        static const ValueFlow::TokenValues emptyValues;
+        return _values ? *_values : emptyValues;
     }
 
     /**
@@ -756,9 +882,8 @@ public:
     template<typename T>
     void originalName(T&& name) {
         if (!_originalName)
-            _originalName = new std::string(name);
-        else
-            *_originalName = name;
+            _originalName = newString();
+        *_originalName = name;
     }
 
     bool hasKnownIntValue() const {
@@ -768,7 +893,7 @@ public:
     const ValueFlow::Value * getValue(const MathLib::bigint val) const {
         if (!_values)
             return nullptr;
-        for (std::list<ValueFlow::Value>::const_iterator it = _values->begin(); it != _values->end(); ++it) {
+        for (ValueFlow::TokenValues::const_iterator it = _values->begin(); it != _values->end(); ++it) {
             if (it->isIntValue() && it->intvalue == val)
                 return &(*it);
         }
@@ -779,7 +904,7 @@ public:
         if (!_values)
             return nullptr;
         const ValueFlow::Value *ret = nullptr;
-        for (std::list<ValueFlow::Value>::const_iterator it = _values->begin(); it != _values->end(); ++it) {
+        for (ValueFlow::TokenValues::const_iterator it = _values->begin(); it != _values->end(); ++it) {
             if (!it->isIntValue())
                 continue;
             if ((!ret || it->intvalue > ret->intvalue) &&
@@ -792,7 +917,7 @@ public:
     const ValueFlow::Value * getMovedValue() const {
         if (!_values)
             return nullptr;
-        for (std::list<ValueFlow::Value>::const_iterator it = _values->begin(); it != _values->end(); ++it) {
+        for (ValueFlow::TokenValues::const_iterator it = _values->begin(); it != _values->end(); ++it) {
             if (it->isMovedValue() && it->moveKind != ValueFlow::Value::NonMovedVariable)
                 return &(*it);
         }
@@ -809,8 +934,12 @@ public:
 
     const Token *getValueTokenDeadPointer() const;
 
-    /** Add token value. Return true if value is added. */
-    bool addValue(const ValueFlow::Value &value);
+    /**
+     * Add token value. Return true if value is added.
+     * @param value value to add
+     * @param maxValues the value is not added if the token already has this many values
+     */
+    bool addValue(const ValueFlow::Value &value, std::size_t maxValues);
 
 private:
 
@@ -835,7 +964,20 @@ private:
      */
     static const char *chrInFirstWord(const char *str, char c);
 
-    std::string _str;
+    /** @return arena of the token list, nullptr => heap */
+    TokenArena *arena() const;
+
+    /** Create an empty string in the arena */
+    std::string *newString() const;
+
+    /** Set the text, see _str */
+    void setText(const std::string &s);
+
+    /**
+     * Shared text of the token list, see TokenArena::intern(). A token that
+     * is not in a token list owns its text.
+     */
+    const std::string *_str;
 
     Token *_next;
     Token *_previous;
@@ -861,6 +1003,9 @@ private:
      */
     unsigned int _progressValue;
 
+    /** Position in the token list, see assignIndexes() */
+    unsigned int _index;
+
     Token::Type _tokType;
 
     enum {
@@ -924,7 +1069,7 @@ private:
     ValueType *valuetype;
 
     // ValueFlow
-    std::list<ValueFlow::Value>* _values;
+    ValueFlow::TokenValues* _values;
 
 public:
     void astOperand1(Token *tok);
@@ -970,7 +1115,7 @@ public:
             ret = _astOperand1->astString(sep);
         if (_astOperand2)
             ret += _astOperand2->astString(sep);
-        return ret + sep + _str;
+        return ret + sep + *_str;
     }
 
     std::string astStringVerbose(const unsigned int indent1, const unsigned int indent2) const;
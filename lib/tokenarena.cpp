@@ -0,0 +1,108 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2016 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tokenarena.h"
+
+#include <cassert>
+#include <new>
+
+namespace {
+    const std::string empty;
+}
+
+TokenArena::TokenArena()
+    : _current(nullptr), _end(nullptr), _usedBlocks(0)
+{
+    for (std::size_t i = 0; i < sizeof(_freeBlocks) / sizeof(_freeBlocks[0]); ++i)
+        _freeBlocks[i] = nullptr;
+}
+
+TokenArena::~TokenArena()
+{
+    for (std::vector<char *>::const_iterator it = _slabs.begin(); it != _slabs.end(); ++it)
+        delete[] *it;
+}
+
+void *TokenArena::allocate(TokenArena *arena, std::size_t size)
+{
+    const std::size_t bsize = blockSize(size);
+    Header *header;
+    if (arena && bsize <= MaxBlockSize) {
+        header = static_cast<Header *>(arena->allocateBlock(bsize));
+    } else {
+        header = static_cast<Header *>(::operator new(bsize));
+        arena = nullptr;
+    }
+    header->arena = arena;
+    return header + 1;
+}
+
+void TokenArena::deallocate(void *p, std::size_t size)
+{
+    if (!p)
+        return;
+    Header *header = static_cast<Header *>(p) - 1;
+    if (header->arena)
+        header->arena->releaseBlock(header, blockSize(size));
+    else
+        ::operator delete(header);
+}
+
+void *TokenArena::allocateBlock(std::size_t bsize)
+{
+    ++_usedBlocks;
+
+    void *&freeBlock = _freeBlocks[bsize / Granularity];
+    if (freeBlock) {
+        void *block = freeBlock;
+        freeBlock = static_cast<Header *>(block)->next;
+        return block;
+    }
+
+    if (static_cast<std::size_t>(_end - _current) < bsize) {
+        _slabs.push_back(new char[SlabSize]);
+        _current = _slabs.back();
+        _end = _current + SlabSize;
+    }
+    void *block = _current;
+    _current += bsize;
+    return block;
+}
+
+void TokenArena::releaseBlock(void *block, std::size_t bsize)
+{
+    assert(_usedBlocks > 0);
+    --_usedBlocks;
+
+    void *&freeBlock = _freeBlocks[bsize / Granularity];
+    static_cast<Header *>(block)->next = freeBlock;
+    freeBlock = block;
+}
+
+const std::string *TokenArena::intern(TokenArena *arena, const std::string &s)
+{
+    if (s.empty())
+        return &empty;
+    assert(arena != nullptr);
+    return &*arena->_strings.insert(s).first;
+}
+
+const std::string *TokenArena::emptyText()
+{
+    return &empty;
+}
@@ -0,0 +1,136 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2016 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+//---------------------------------------------------------------------------
+#ifndef tokenarenaH
+#define tokenarenaH
+//---------------------------------------------------------------------------
+
+#include "config.h"
+
+#include <cstddef>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/// @addtogroup Core
+/// @{
+
+/**
+ * @brief Slab allocator for the tokens of a TokenList and the objects they own.
+ *
+ * Every block starts with a header that remembers the arena it was taken from,
+ * so a block can be released without knowing its TokenList. Released blocks
+ * are reused for allocations of the same size and all slabs are freed
+ * together when the arena is destroyed. The arena also owns the texts of
+ * the tokens, each distinct text is stored once.
+ */
+class CPPCHECKLIB TokenArena {
+public:
+    TokenArena();
+    ~TokenArena();
+
+    /**
+     * Allocate memory for an object with at most pointer alignment.
+     * @param arena arena to allocate from, nullptr => the heap is used
+     * @param size size of the object
+     */
+    static void *allocate(TokenArena *arena, std::size_t size);
+
+    /**
+     * Release memory that was returned by allocate().
+     * @param p memory to release, can be nullptr
+     * @param size the size that was given to allocate()
+     */
+    static void deallocate(void *p, std::size_t size);
+
+    /** Destruct an object created in memory from allocate() and release the memory */
+    template<class T>
+    static void destroy(T *p) {
+        if (p) {
+            p->~T();
+            deallocate(p, sizeof(T));
+        }
+    }
+
+    /**
+     * Get the shared copy of a token text. Equal texts of one arena get the
+     * same copy, so they can be compared by address. The copy lives as long
+     * as the arena. Tokens that are not in a token list own their texts
+     * instead, see Token::_str.
+     * @param arena arena that owns the copy
+     * @param s the text
+     */
+    static const std::string *intern(TokenArena *arena, const std::string &s);
+
+    /** @return the shared empty text, the same for all arenas */
+    static const std::string *emptyText();
+
+    /** @return number of distinct texts in the arena */
+    std::size_t stringCount() const {
+        return _strings.size();
+    }
+
+    /** @return number of bytes that are allocated from the heap for slabs */
+    std::size_t reservedBytes() const {
+        return _slabs.size() * SlabSize;
+    }
+
+    /** @return number of blocks that are currently in use */
+    std::size_t usedBlocks() const {
+        return _usedBlocks;
+    }
+
+private:
+    /** Disable copy constructor, no implementation */
+    TokenArena(const TokenArena &);
+
+    /** Disable assignment operator, no implementation */
+    TokenArena &operator=(const TokenArena &);
+
+    void *allocateBlock(std::size_t blockSize);
+    void releaseBlock(void *block, std::size_t blockSize);
+
+    union Header {
+        TokenArena *arena;
+        void *next; // next free block
+    };
+
+    static const std::size_t Granularity = sizeof(void *);
+    static const std::size_t MaxBlockSize = 512;
+    static const std::size_t SlabSize = 256 * 1024;
+
+    static std::size_t blockSize(std::size_t size) {
+        return (sizeof(Header) + size + Granularity - 1) / Granularity * Granularity;
+    }
+
+    std::vector<char *> _slabs;
+    char *_current;
+    char *_end;
+    std::size_t _usedBlocks;
+
+    /** free lists, indexed by block size / Granularity */
+    void *_freeBlocks[MaxBlockSize / Granularity + 1];
+
+    /** shared token texts, see intern() */
+    std::unordered_set<std::string> _strings;
+};
+
+/// @}
+//---------------------------------------------------------------------------
+#endif // tokenarenaH
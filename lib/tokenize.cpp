@@ -39,6 +39,7 @@
 #include <cstring>
 #include <ctime>
 #include <iostream>
+#include <set>
 #include <stack>
 #include <utility>
 #include <vector>
@@ -139,6 +140,7 @@ Tokenizer::Tokenizer() :
     _errorLogger(nullptr),
     _symbolDatabase(nullptr),
     _varId(0),
+    _unnamedCount(0),
     _codeWithTemplates(false), //is there any templates?
     m_timerResults(nullptr)
 #ifdef MAXTIME
@@ -153,6 +155,7 @@ Tokenizer::Tokenizer(const Settings *settings, ErrorLogger *errorLogger) :
     _errorLogger(errorLogger),
     _symbolDatabase(nullptr),
     _varId(0),
+    _unnamedCount(0),
     _codeWithTemplates(false), //is there any templates?
     m_timerResults(nullptr)
 #ifdef MAXTIME
@@ -331,7 +334,7 @@ bool Tokenizer::duplicateTypedef(Token **tokPtr, const Token *name, const Token
                                 return true;
                             } else if (Token::Match(tok->next(), ")|*")) {
                                 return true;
-                            } else if (tok->next()->str() == name->str()) {
+                            } else if (tok->next()->strEquals(name)) {
                                 return true;
                             } else if (tok->next()->str() != ";") {
                                 return true;
@@ -432,7 +435,116 @@ namespace {
     };
 }
 
-static Token *splitDefinitionFromTypedef(Token *tok)
+Tokenizer::NameIndex::NameIndex(TokenList &list)
+    : _list(list)
+{
+    rebuild();
+}
+
+void Tokenizer::NameIndex::rebuild()
+{
+    unsigned int count = 0;
+    for (const Token *tok = _list.front(); tok; tok = tok->next())
+        ++count;
+    const unsigned int step = std::max(0xffffffffU / (count + 2U), 2U);
+    unsigned int pos = 0;
+    _names.clear();
+    for (Token *tok = _list.front(); tok; tok = tok->next()) {
+        pos += step;
+        tok->index(pos);
+        if (tok->isName())
+            _names[tok->str()].push_back(Position(pos, tok));
+    }
+}
+
+void Tokenizer::NameIndex::update(Token *start, const Token *end, const std::set<std::string> &removed)
+{
+    while (!start->index() && start->previous())
+        start = start->previous();
+    const Token *last = end ? end : _list.back();
+    while (last->next() && !last->next()->index())
+        last = last->next();
+    const unsigned int low = start->index();
+    const unsigned int high = last->next() ? last->next()->index() : 0xffffffffU;
+    for (std::set<std::string>::const_iterator it = removed.begin(); it != removed.end(); ++it) {
+        Positions &positions = _names[*it];
+        positions.erase(std::lower_bound(positions.begin(), positions.end(), Position(low, nullptr), before),
+                        std::lower_bound(positions.begin(), positions.end(), Position(high, nullptr), before));
+    }
+    for (Token *tok = start; tok; tok = tok->next()) {
+        if (!tok->index() && !number(tok)) {
+            rebuild();
+            return;
+        }
+        if (tok->isName())
+            add(tok);
+        if (tok == last)
+            break;
+    }
+}
+
+Token *Tokenizer::NameIndex::next(const std::string &name, Token *tok, Token *end)
+{
+    const std::set<std::string> removed;
+    if (!tok->index())
+        update(tok, tok, removed);
+    if (end && !end->index())
+        update(end, end, removed);
+    const std::unordered_map<std::string, Positions>::const_iterator positions = _names.find(name);
+    if (positions == _names.end())
+        return nullptr;
+    const unsigned int endPos = end ? end->index() : 0xffffffffU;
+    for (Positions::const_iterator it = std::upper_bound(positions->second.begin(), positions->second.end(), Position(tok->index(), nullptr), before);
+         it != positions->second.end() && it->first < endPos; ++it) {
+        // renamed tokens are not removed from their old name
+        if (it->second->str() == name)
+            return it->second;
+    }
+    return nullptr;
+}
+
+Token *Tokenizer::NameIndex::advance(const std::string &name, Token *tok, Token *&changedUse, const std::set<std::string> &removed, bool jump, Token *end)
+{
+    if (changedUse) {
+        update(changedUse->previous() ? changedUse->previous() : changedUse, tok, removed);
+        changedUse = nullptr;
+    }
+    return jump ? next(name, tok, end) : tok->next();
+}
+
+void Tokenizer::NameIndex::add(Token *tok)
+{
+    Positions &positions = _names[tok->str()];
+    const Position pos(tok->index(), tok);
+    const Positions::iterator it = std::lower_bound(positions.begin(), positions.end(), pos, before);
+    if (it != positions.end() && it->first == pos.first)
+        it->second = tok;
+    else
+        positions.insert(it, pos);
+}
+
+bool Tokenizer::NameIndex::number(Token *tok)
+{
+    unsigned int count = 1;
+    const Token *last = tok;
+    while (last->next() && !last->next()->index()) {
+        last = last->next();
+        ++count;
+    }
+    const unsigned int low = tok->previous() ? tok->previous()->index() : 0;
+    const unsigned int high = last->next() ? last->next()->index() : 0xffffffffU;
+    if (high - low <= count)
+        return false;
+    const unsigned int step = (high - low) / (count + 1);
+    unsigned int pos = low;
+    for (Token *tok2 = tok; count > 0; tok2 = tok2->next(), --count) {
+        pos += step;
+        tok2->index(pos);
+    }
+    return true;
+}
+
+static Token *splitDefinitionFromTypedef(Token *tok, unsigned int *unnamedCount)
 {
     Token *tok1;
     std::string name;
@@ -451,8 +563,7 @@ static Token *splitDefinitionFromTypedef(Token *tok)
             if (Token::Match(tok1->next(), "%type%"))
                 name = tok1->next()->str();
             else { // create a unique name
-                static unsigned int count = 0;
-                name = "Unnamed" + MathLib::toString(count++);
+                name = "Unnamed" + MathLib::toString((*unnamedCount)++);
             }
             tok->next()->insertToken(name);
         } else
@@ -568,7 +679,13 @@ Token *Tokenizer::processFunc(Token *tok2, bool inOperator) const
 
 void Tokenizer::simplifyTypedef()
 {
+    // the name index is not needed if there are no typedefs
+    if (!Token::findsimplematch(list.front(), "typedef"))
+        return;
+
+    NameIndex nameIndex(list);
     std::vector<Space> spaceInfo;
+    std::vector<Token *> blocks;
     bool isNamespace = false;
     std::string className;
     bool hasClass = false;
@@ -610,6 +727,10 @@ void Tokenizer::simplifyTypedef()
                 hasClass = false;
             } else if (!spaceInfo.empty() && tok->str() == "}" && spaceInfo.back().classEnd == tok) {
                 spaceInfo.pop_back();
+            } else if (tok->str() == "{" && (blocks.empty() || blocks.back() != tok)) { // goback may visit it again
+                blocks.push_back(tok);
+            } else if (!blocks.empty() && blocks.back()->link() == tok) {
+                blocks.pop_back();
             }
             continue;
         }
@@ -617,7 +738,7 @@ void Tokenizer::simplifyTypedef()
         // pull struct, union, enum or class definition out of typedef
         // use typedef name for unnamed struct, union, enum or class
         if (Token::Match(tok->next(), "const| struct|enum|union|class %type%| {")) {
-            Token *tok1 = splitDefinitionFromTypedef(tok);
+            Token *tok1 = splitDefinitionFromTypedef(tok, &_unnamedCount);
             if (!tok1)
                 continue;
             tok = tok1;
@@ -626,7 +747,7 @@ void Tokenizer::simplifyTypedef()
             while (tok1 && tok1->str() != ";" && tok1->str() != "{")
                 tok1 = tok1->next();
             if (tok1 && tok1->str() == "{") {
-                tok1 = splitDefinitionFromTypedef(tok);
+                tok1 = splitDefinitionFromTypedef(tok, &_unnamedCount);
                 if (!tok1)
                     continue;
                 tok = tok1;
@@ -1036,10 +1157,40 @@ void Tokenizer::simplifyTypedef()
             bool globalScope = false;
             std::size_t classLevel = spaceInfo.size();
 
-            for (Token *tok2 = tok; tok2; tok2 = tok2->next()) {
+            // Outside of classes and namespaces only the uses of the name
+            // until the end of the scope need to be visited. In C++ a block
+            // may contain a namespace, it is searched token by token.
+            Token *scopeEnd = blocks.empty() ? nullptr : blocks.back()->link();
+            const bool jump = spaceInfo.empty() &&
+                              (!scopeEnd || !isCPP() || !nameIndex.next("namespace", tok, scopeEnd));
+
+            // Otherwise search only if the name occurs later. A later
+            // namespace with the same name as an enclosing one also needs
+            // the search since it updates spaceInfo.
+            std::set<std::string> removed;
+            Token *tok2;
+            if (jump) {
+                tok2 = nameIndex.next(typeName->str(), tok, scopeEnd);
+            } else {
+                bool search = nameIndex.next(typeName->str(), tok, nullptr) != nullptr;
+                for (std::size_t i = 0; !search && i < spaceInfo.size(); ++i)
+                    search = spaceInfo[i].isNamespace && nameIndex.next(spaceInfo[i].className, tok, nullptr);
+                tok2 = search ? tok : nullptr;
+
+                // qualifications that may be removed at the uses
+                removed.insert(typeName->str());
+                for (std::size_t i = 0; i < spaceInfo.size(); ++i)
+                    removed.insert(spaceInfo[i].className);
+            }
+
+            Token *use = nullptr;
+            Token *changedUse = nullptr;
+            for (; tok2; tok2 = nameIndex.advance(typeName->str(), tok2, changedUse, removed, jump, scopeEnd)) {
                 if (_settings->terminated())
                     return;
 
+                use = tok2;
+
                 if (tok2->link()) { // Pre-check for performance
                     // check for end of scope
                     if (tok2->str() == "}") {
@@ -1120,7 +1271,7 @@ void Tokenizer::simplifyTypedef()
                 else if (isCPP() &&
                          tok2->str() == "operator" &&
                          tok2->next() &&
-                         tok2->next()->str() == typeName->str() &&
+                         tok2->next()->strEquals(typeName) &&
                          tok2->linkAt(2) &&
                          tok2->strAt(2) == "(" &&
                          Token::Match(tok2->linkAt(2), ") const| {")) {
@@ -1137,10 +1288,10 @@ void Tokenizer::simplifyTypedef()
 
                 // check for typedef that can be substituted
                 else if (Token::simpleMatch(tok2, pattern.c_str()) ||
-                         (inMemberFunc && tok2->str() == typeName->str())) {
+                         (inMemberFunc && tok2->strEquals(typeName))) {
 
                     // member function class variables don't need qualification
-                    if (!(inMemberFunc && tok2->str() == typeName->str()) && pattern.find("::") != std::string::npos) { // has a "something ::"
+                    if (!(inMemberFunc && tok2->strEquals(typeName)) && pattern.find("::") != std::string::npos) { // has a "something ::"
                         Token *start = tok2;
                         std::size_t count = 0;
                         int back = int(classLevel) - 1;
@@ -1216,6 +1367,8 @@ void Tokenizer::simplifyTypedef()
                 }
 
                 if (simplifyType) {
+                    changedUse = use;
+
                     // can't simplify 'operator functionPtr ()' and 'functionPtr operator ... ()'
                     if (functionPtr && (tok2->previous()->str() == "operator" ||
                                         (tok2->next() && tok2->next()->str() == "operator"))) {
@@ -1573,6 +1726,9 @@ void Tokenizer::simplifyTypedef()
                     break;
             }
 
+            if (changedUse)
+                nameIndex.update(changedUse->previous() ? changedUse->previous() : changedUse, tok2, removed);
+
             if (!tok)
                 syntaxError(nullptr);
 
@@ -1658,6 +1814,7 @@ void Tokenizer::simplifyTypedef()
 
 void Tokenizer::simplifyMulAndParens()
 {
+    Timer timer("Tokenizer::simplifyMulAndParens", _settings->showtime);
     if (!list.front())
         return;
     for (Token *tok = list.front()->tokAt(3); tok; tok = tok->next()) {
@@ -1764,7 +1921,10 @@ bool Tokenizer::simplifyTokens1(const std::string &configuration)
         }
     }
 
-    _symbolDatabase->setValueTypeInTokenList();
+    {
+        Timer timer("SymbolDatabase::setValueTypeInTokenList", _settings->showtime);
+        _symbolDatabase->setValueTypeInTokenList();
+    }
     ValueFlow::setValues(&list, _symbolDatabase, _errorLogger, _settings);
 
     printDebugOutput(1);
@@ -1785,12 +1945,14 @@ bool Tokenizer::tokenize(std::istream &code,
 
 void Tokenizer::findComplicatedSyntaxErrorsInTemplates()
 {
+    Timer timer("Tokenizer::findComplicatedSyntaxErrorsInTemplates", _settings->showtime);
     validate();
     TemplateSimplifier::checkComplicatedSyntaxErrorsInTemplates(list.front());
 }
 
 void Tokenizer::checkForEnumsWithTypedef()
 {
+    Timer timer("Tokenizer::checkForEnumsWithTypedef", _settings->showtime);
     for (const Token *tok = list.front(); tok; tok = tok->next()) {
         if (Token::Match(tok, "enum %name% {")) {
             tok = tok->tokAt(2);
@@ -1820,6 +1982,7 @@ void Tokenizer::fillTypeSizes()
 
 void Tokenizer::combineOperators()
 {
+    Timer timer("Tokenizer::combineOperators", _settings->showtime);
     const bool cpp = isCPP();
 
     // Combine tokens..
@@ -1888,6 +2051,7 @@ void Tokenizer::combineOperators()
 
 void Tokenizer::combineStringAndCharLiterals()
 {
+    Timer timer("Tokenizer::combineStringAndCharLiterals", _settings->showtime);
     // Combine wide strings and wide characters
     for (Token *tok = list.front();
          tok;
@@ -1907,17 +2071,22 @@ void Tokenizer::combineStringAndCharLiterals()
         if (tok->str()[0] != '"')
             continue;
 
-        tok->str(simplifyString(tok->str()));
+        // Two strings after each other, combine them. The combined text is
+        // built here so only the final text is stored in the token.
+        std::string str(simplifyString(tok->str()));
         while (tok->next() && tok->next()->tokType() == Token::eString) {
-            // Two strings after each other, combine them
-            tok->concatStr(simplifyString(tok->next()->str()));
+            const std::string next(simplifyString(tok->next()->str()));
+            str.erase(str.size() - 1);
+            str.append(next, 1, std::string::npos);
             tok->deleteNext();
         }
+        tok->str(str);
     }
 }
 
 void Tokenizer::concatenateNegativeNumberAndAnyPositive()
 {
+    Timer timer("Tokenizer::concatenateNegativeNumberAndAnyPositive", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (!Token::Match(tok, "?|:|,|(|[|{|return|case|sizeof|%op% +|-") || tok->tokType() == Token::eIncDecOp)
             continue;
@@ -1934,6 +2103,7 @@ void Tokenizer::concatenateNegativeNumberAndAnyPositive()
 
 void Tokenizer::simplifyExternC()
 {
+    Timer timer("Tokenizer::simplifyExternC", _settings->showtime);
     if (isC())
         return;
     for (Token *tok = list.front(); tok; tok = tok->next()) {
@@ -1950,6 +2120,7 @@ void Tokenizer::simplifyExternC()
 
 void Tokenizer::simplifyRoundCurlyParentheses()
 {
+    Timer timer("Tokenizer::simplifyRoundCurlyParentheses", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         while (Token::Match(tok, "[;{}:] ( {") &&
                Token::simpleMatch(tok->linkAt(2), "} ) ;")) {
@@ -1971,6 +2142,7 @@ void Tokenizer::simplifyRoundCurlyParentheses()
 
 void Tokenizer::simplifySQL()
 {
+    Timer timer("Tokenizer::simplifySQL", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (Token::simpleMatch(tok, "EXEC SQL")) {
             const Token *end = tok->tokAt(2);
@@ -1997,6 +2169,7 @@ void Tokenizer::simplifySQL()
 
 void Tokenizer::simplifyArrayAccessSyntax()
 {
+    Timer timer("Tokenizer::simplifyArrayAccessSyntax", _settings->showtime);
     // 0[a] -> a[0]
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (tok->isNumber() && Token::Match(tok, "%num% [ %name% ]")) {
@@ -2011,6 +2184,7 @@ void Tokenizer::simplifyArrayAccessSyntax()
 
 void Tokenizer::simplifyParameterVoid()
 {
+    Timer timer("Tokenizer::simplifyParameterVoid", _settings->showtime);
     for (Token* tok = list.front(); tok; tok = tok->next()) {
         if (Token::Match(tok, "%name% ( void )"))
             tok->next()->deleteNext();
@@ -2019,6 +2193,7 @@ void Tokenizer::simplifyParameterVoid()
 
 void Tokenizer::simplifyRedundantConsecutiveBraces()
 {
+    Timer timer("Tokenizer::simplifyRedundantConsecutiveBraces", _settings->showtime);
     // Remove redundant consecutive braces, i.e. '.. { { .. } } ..' -> '.. { .. } ..'.
     for (Token *tok = list.front(); tok;) {
         if (Token::simpleMatch(tok, "= {")) {
@@ -2034,6 +2209,7 @@ void Tokenizer::simplifyRedundantConsecutiveBraces()
 
 void Tokenizer::simplifyDoublePlusAndDoubleMinus()
 {
+    Timer timer("Tokenizer::simplifyDoublePlusAndDoubleMinus", _settings->showtime);
     // Convert - - into + and + - into -
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         while (tok->next()) {
@@ -2076,6 +2252,7 @@ void Tokenizer::simplifyDoublePlusAndDoubleMinus()
 
 void Tokenizer::arraySize()
 {
+    Timer timer("Tokenizer::arraySize", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (!tok->isName() || !Token::Match(tok, "%var% [ ] ="))
             continue;
@@ -2170,6 +2347,7 @@ const Token * Tokenizer::startOfExecutableScope(const Token * tok)
 
 void Tokenizer::simplifyLabelsCaseDefault()
 {
+    Timer timer("Tokenizer::simplifyLabelsCaseDefault", _settings->showtime);
     bool executablescope = false;
     unsigned int indentlevel = 0;
     for (Token *tok = list.front(); tok; tok = tok->next()) {
@@ -2234,6 +2412,7 @@ void Tokenizer::simplifyLabelsCaseDefault()
 
 void Tokenizer::simplifyCaseRange()
 {
+    Timer timer("Tokenizer::simplifyCaseRange", _settings->showtime);
     for (Token* tok = list.front(); tok; tok = tok->next()) {
         if (Token::Match(tok, "case %num% . . . %num% :")) {
             MathLib::bigint start = MathLib::toLongNumber(tok->strAt(1));
@@ -2272,6 +2451,7 @@ void Tokenizer::simplifyCaseRange()
 
 void Tokenizer::simplifyTemplates()
 {
+    Timer timer("Tokenizer::simplifyTemplates", _settings->showtime);
     if (isC())
         return;
 
@@ -2308,7 +2488,33 @@ void Tokenizer::simplifyTemplates()
 //---------------------------------------------------------------------------
 
 
-static bool setVarIdParseDeclaration(const Token **tok, const std::map<std::string,unsigned int> &variableId, bool executableScope, bool cpp, bool c)
+bool VariableMap::leaveScope()
+{
+    if (_scopeStart.empty())
+        return false;
+    const std::size_t start = _scopeStart.back();
+    _scopeStart.pop_back();
+    while (_undo.size() > start) {
+        const std::pair<std::string, unsigned int> &old = _undo.back();
+        if (old.second)
+            _varIds[old.first] = old.second;
+        else
+            _varIds.erase(old.first);
+        _undo.pop_back();
+    }
+    return true;
+}
+
+void VariableMap::addVariable(const std::string &varname, unsigned int varid)
+{
+    const std::pair<std::unordered_map<std::string, unsigned int>::iterator, bool> ins = _varIds.insert(std::make_pair(varname, varid));
+    const unsigned int old = ins.second ? 0U : ins.first->second;
+    ins.first->second = varid;
+    if (!_scopeStart.empty())
+        _undo.push_back(std::make_pair(varname, old));
+}
+
+static bool setVarIdParseDeclaration(const Token **tok, const VariableMap &variableId, bool executableScope, bool cpp, bool c)
 {
     const Token *tok2 = *tok;
     if (!tok2->isName())
@@ -2329,7 +2535,7 @@ static bool setVarIdParseDeclaration(const Token **tok, const std::map<std::stri
                 singleNameCount = 0;
             } else if (tok2->str() == "const") {
                 ;  // just skip "const"
-            } else if (!hasstruct && variableId.find(tok2->str()) != variableId.end() && tok2->previous()->str() != "::") {
+            } else if (!hasstruct && variableId.hasVariable(tok2->str()) && tok2->previous()->str() != "::") {
                 ++typeCount;
                 tok2 = tok2->next();
                 if (!tok2 || tok2->str() != "::")
@@ -2386,7 +2592,7 @@ static bool setVarIdParseDeclaration(const Token **tok, const std::map<std::stri
 
 
 static void setVarIdStructMembers(Token **tok1,
-                                  std::map<unsigned int, std::map<std::string, unsigned int> >& structMembers,
+                                  std::unordered_map<unsigned int, std::unordered_map<std::string, unsigned int> >& structMembers,
                                   unsigned int *_varId)
 {
     Token *tok = *tok1;
@@ -2396,7 +2602,7 @@ static void setVarIdStructMembers(Token **tok1,
         if (struct_varid == 0)
             return;
 
-        std::map<std::string, unsigned int>& members = structMembers[struct_varid];
+        std::unordered_map<std::string, unsigned int>& members = structMembers[struct_varid];
 
         tok = tok->tokAt(3);
         while (tok->str() != "}") {
@@ -2404,7 +2610,7 @@ static void setVarIdStructMembers(Token **tok1,
                 tok = tok->link();
             if (Token::Match(tok->previous(), "[,{] . %name% =")) {
                 tok = tok->next();
-                const std::map<std::string, unsigned int>::iterator it = members.find(tok->str());
+                const std::unordered_map<std::string, unsigned int>::iterator it = members.find(tok->str());
                 if (it == members.end()) {
                     members[tok->str()] = ++(*_varId);
                     tok->varId(*_varId);
@@ -2428,8 +2634,8 @@ static void setVarIdStructMembers(Token **tok1,
         if (TemplateSimplifier::templateParameters(tok->next()) > 0)
             break;
 
-        std::map<std::string, unsigned int>& members = structMembers[struct_varid];
-        const std::map<std::string, unsigned int>::iterator it = members.find(tok->str());
+        std::unordered_map<std::string, unsigned int>& members = structMembers[struct_varid];
+        const std::unordered_map<std::string, unsigned int>::iterator it = members.find(tok->str());
         if (it == members.end()) {
             members[tok->str()] = ++(*_varId);
             tok->varId(*_varId);
@@ -2443,9 +2649,9 @@ static void setVarIdStructMembers(Token **tok1,
 
 
 void Tokenizer::setVarIdClassDeclaration(const Token * const startToken,
-        const std::map<std::string, unsigned int> &variableId,
+        const VariableMap &variableId,
         const unsigned int scopeStartVarId,
-        std::map<unsigned int, std::map<std::string,unsigned int> >& structMembers)
+        std::unordered_map<unsigned int, std::unordered_map<std::string, unsigned int> >& structMembers)
 {
     // end of scope
     const Token * const endToken = startToken->link();
@@ -2486,10 +2692,9 @@ void Tokenizer::setVarIdClassDeclaration(const Token * const startToken,
             --indentlevel;
             inEnum = false;
         } else if (initList && indentlevel == 0 && Token::Match(tok->previous(), "[,:] %name% [({]")) {
-            const std::map<std::string, unsigned int>::const_iterator it = variableId.find(tok->str());
-            if (it != variableId.end()) {
-                tok->varId(it->second);
-            }
+            const unsigned int varid = variableId.varId(tok->str());
+            if (varid)
+                tok->varId(varid);
         } else if (tok->isName() && tok->varId() <= scopeStartVarId) {
             if (indentlevel > 0 || initList) {
                 if (Token::Match(tok->previous(), "::|.") && tok->strAt(-2) != "this" && !Token::simpleMatch(tok->tokAt(-5), "( * this ) ."))
@@ -2504,9 +2709,9 @@ void Tokenizer::setVarIdClassDeclaration(const Token * const startToken,
                 }
 
                 if (!inEnum) {
-                    const std::map<std::string, unsigned int>::const_iterator it = variableId.find(tok->str());
-                    if (it != variableId.end()) {
-                        tok->varId(it->second);
+                    const unsigned int varid = variableId.varId(tok->str());
+                    if (varid) {
+                        tok->varId(varid);
                         setVarIdStructMembers(&tok, structMembers, &_varId);
                     }
                 }
@@ -2524,7 +2729,7 @@ static void setVarIdClassFunction(const std::string &classname,
                                   Token * const startToken,
                                   const Token * const endToken,
                                   const std::map<std::string, unsigned int> &varlist,
-                                  std::map<unsigned int, std::map<std::string, unsigned int> >& structMembers,
+                                  std::unordered_map<unsigned int, std::unordered_map<std::string, unsigned int> >& structMembers,
                                   unsigned int *_varId)
 {
     for (Token *tok2 = startToken; tok2 && tok2 != endToken; tok2 = tok2->next()) {
@@ -2577,9 +2782,8 @@ void Tokenizer::setVarIdPass1()
 
     // variable id
     _varId = 0;
-    std::map<std::string, unsigned int> variableId;
-    std::map<unsigned int, std::map<std::string, unsigned int> > structMembers;
-    std::stack< std::map<std::string, unsigned int> > scopeInfo;
+    VariableMap variableId;
+    std::unordered_map<unsigned int, std::unordered_map<std::string, unsigned int> > structMembers;
 
     std::stack<VarIdScopeInfo> scopeStack;
 
@@ -2592,10 +2796,8 @@ void Tokenizer::setVarIdPass1()
             if (tok->str() == ":")
                 initlist = true;
             else if (tok->str() == ";") {
-                if (scopeInfo.empty())
+                if (!variableId.leaveScope())
                     cppcheckError(tok);
-                variableId.swap(scopeInfo.top());
-                scopeInfo.pop();
             } else if (tok->str() == "{")
                 scopeStack.push(VarIdScopeInfo(true, scopeStack.top().isStructInit || tok->strAt(-1) == "=", /*isEnum=*/false, _varId));
         } else if (!initlist && tok->str()=="(") {
@@ -2610,7 +2812,7 @@ void Tokenizer::setVarIdPass1()
             if (newFunctionDeclEnd &&
                 (functionDeclEndStack.empty() || newFunctionDeclEnd != functionDeclEndStack.top())) {
                 functionDeclEndStack.push(newFunctionDeclEnd);
-                scopeInfo.push(variableId);
+                variableId.enterScope();
             }
         } else if (Token::Match(tok, "{|}")) {
             const Token * const startToken = (tok->str() == "{") ? tok : tok->link();
@@ -2628,7 +2830,7 @@ void Tokenizer::setVarIdPass1()
                         isExecutable = ((scopeStack.top().isExecutable || initlist || tok->strAt(-1) == "else") &&
                                         !isClassStructUnionEnumStart(tok));
                         if (!(scopeStack.top().isStructInit || tok->strAt(-1) == "="))
-                            scopeInfo.push(variableId);
+                            variableId.enterScope();
                     }
                     initlist = false;
                     scopeStack.push(VarIdScopeInfo(isExecutable, scopeStack.top().isStructInit || tok->strAt(-1) == "=", isEnumStart(tok), _varId));
@@ -2645,12 +2847,8 @@ void Tokenizer::setVarIdPass1()
                     }
 
                     if (!scopeStack.top().isStructInit) {
-                        if (scopeInfo.empty()) {
+                        if (!variableId.leaveScope())
                             variableId.clear();
-                        } else {
-                            variableId.swap(scopeInfo.top());
-                            scopeInfo.pop();
-                        }
                     }
 
                     scopeStack.pop();
@@ -2728,7 +2926,7 @@ void Tokenizer::setVarIdPass1()
                                     continue;
 
                                 if (tok3->isLiteral() ||
-                                    (tok3->isName() && (variableId.find(tok3->str()) != variableId.end())) ||
+                                    (tok3->isName() && variableId.hasVariable(tok3->str())) ||
                                     tok3->isOp() ||
                                     tok3->str() == "(" ||
                                     notstart.find(tok3->str()) != notstart.end()) {
@@ -2746,7 +2944,7 @@ void Tokenizer::setVarIdPass1()
                     decl = false;
 
                 if (decl) {
-                    variableId[prev2->str()] = ++_varId;
+                    variableId.addVariable(prev2->str(), ++_varId);
 
                     // set varid for template parameters..
                     tok = tok->next();
@@ -2755,8 +2953,8 @@ void Tokenizer::setVarIdPass1()
                     if (tok && tok->str() == "<") {
                         const Token *end = tok->findClosingBracket();
                         while (tok != end) {
-                            if (tok->isName() && variableId.find(tok->str()) != variableId.end())
-                                tok->varId(variableId[tok->str()]);
+                            if (tok->isName() && variableId.hasVariable(tok->str()))
+                                tok->varId(variableId.varId(tok->str()));
                             tok = tok->next();
                         }
                     }
@@ -2811,9 +3009,9 @@ void Tokenizer::setVarIdPass1()
             }
 
             if (!scopeStack.top().isEnum) {
-                const std::map<std::string, unsigned int>::const_iterator it = variableId.find(tok->str());
-                if (it != variableId.end()) {
-                    tok->varId(it->second);
+                const unsigned int varid = variableId.varId(tok->str());
+                if (varid) {
+                    tok->varId(varid);
                     setVarIdStructMembers(&tok, structMembers, &_varId);
                 }
             }
@@ -2833,7 +3031,7 @@ void Tokenizer::setVarIdPass1()
 
 void Tokenizer::setVarIdPass2()
 {
-    std::map<unsigned int, std::map<std::string, unsigned int> > structMembers;
+    std::unordered_map<unsigned int, std::unordered_map<std::string, unsigned int> > structMembers;
 
     // Member functions and variables in this source
     std::list<Token *> allMemberFunctions;
@@ -3013,6 +3211,7 @@ static void linkBrackets(const Tokenizer * const tokenizer, std::stack<const Tok
 
 void Tokenizer::createLinks()
 {
+    Timer timer("Tokenizer::createLinks", _settings->showtime);
     std::stack<const Token*> type;
     std::stack<Token*> links1;
     std::stack<Token*> links2;
@@ -3047,6 +3246,7 @@ void Tokenizer::createLinks()
 
 void Tokenizer::createLinks2()
 {
+    Timer timer("Tokenizer::createLinks2", _settings->showtime);
     if (isC())
         return;
 
@@ -3111,6 +3311,7 @@ void Tokenizer::createLinks2()
 
 void Tokenizer::sizeofAddParentheses()
 {
+    Timer timer("Tokenizer::sizeofAddParentheses", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (!Token::Match(tok, "sizeof !!("))
             continue;
@@ -3135,6 +3336,7 @@ void Tokenizer::sizeofAddParentheses()
 
 bool Tokenizer::simplifySizeof()
 {
+    Timer timer("Tokenizer::simplifySizeof", _settings->showtime);
     // Locate variable declarations and calculate the size
     std::map<unsigned int, unsigned int> sizeOfVar;
     std::map<unsigned int, const Token *> declTokOfVar;
@@ -3822,7 +4024,10 @@ bool Tokenizer::simplifyTokenList2()
 
     // Create symbol database and then remove const keywords
     createSymbolDatabase();
-    _symbolDatabase->setValueTypeInTokenList();
+    {
+        Timer timer("SymbolDatabase::setValueTypeInTokenList", _settings->showtime);
+        _symbolDatabase->setValueTypeInTokenList();
+    }
 
     ValueFlow::setValues(&list, _symbolDatabase, _errorLogger, _settings);
 
@@ -3963,6 +4168,7 @@ void Tokenizer::dump(std::ostream &out) const
 
 void Tokenizer::removeMacrosInGlobalScope()
 {
+    Timer timer("Tokenizer::removeMacrosInGlobalScope", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (tok->str() == "(") {
             tok = tok->link();
@@ -4027,6 +4233,7 @@ void Tokenizer::removeMacrosInGlobalScope()
 
 void Tokenizer::removeMacroInClassDef()
 {
+    Timer timer("Tokenizer::removeMacroInClassDef", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (Token::Match(tok, "class|struct %name% %name% {|:") &&
             (tok->next()->isUpperCaseName() || tok->tokAt(2)->isUpperCaseName())) {
@@ -4042,6 +4249,7 @@ void Tokenizer::removeMacroInClassDef()
 
 void Tokenizer::removeMacroInVarDecl()
 {
+    Timer timer("Tokenizer::removeMacroInVarDecl", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (Token::Match(tok, "[;{}] %name% (") && tok->next() && tok->next()->isUpperCaseName()) {
             // goto ')' parentheses
@@ -4071,6 +4279,7 @@ void Tokenizer::removeMacroInVarDecl()
 
 void Tokenizer::removeRedundantAssignment()
 {
+    Timer timer("Tokenizer::removeRedundantAssignment", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (tok->str() == "{")
             tok = tok->link();
@@ -4124,6 +4333,7 @@ void Tokenizer::removeRedundantAssignment()
 
 void Tokenizer::simplifyRealloc()
 {
+    Timer timer("Tokenizer::simplifyRealloc", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (Token::Match(tok, "(|[") ||
             (tok->str() == "{" && tok->previous() && tok->previous()->str() == "="))
@@ -4169,6 +4379,7 @@ void Tokenizer::simplifyRealloc()
 
 void Tokenizer::simplifyEmptyNamespaces()
 {
+    Timer timer("Tokenizer::simplifyEmptyNamespaces", _settings->showtime);
     if (isC())
         return;
 
@@ -4202,6 +4413,7 @@ void Tokenizer::simplifyEmptyNamespaces()
 
 void Tokenizer::simplifyFlowControl()
 {
+    Timer timer("Tokenizer::simplifyFlowControl", _settings->showtime);
     for (Token *begin = list.front(); begin; begin = begin->next()) {
 
         if (Token::Match(begin, "(|[") ||
@@ -4278,6 +4490,7 @@ void Tokenizer::simplifyFlowControl()
 
 bool Tokenizer::removeRedundantConditions()
 {
+    Timer timer("Tokenizer::removeRedundantConditions", _settings->showtime);
     // Return value for function. Set to true if there are any simplifications
     bool ret = false;
 
@@ -4344,6 +4557,7 @@ bool Tokenizer::removeRedundantConditions()
 
 void Tokenizer::removeRedundantFor()
 {
+    Timer timer("Tokenizer::removeRedundantFor", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (Token::Match(tok, "[;{}] for ( %name% = %num% ; %name% < %num% ; ++| %name% ++| ) {") ||
             Token::Match(tok, "[;{}] for ( %type% %name% = %num% ; %name% < %num% ; ++| %name% ++| ) {")) {
@@ -4429,6 +4643,7 @@ void Tokenizer::removeRedundantFor()
 
 void Tokenizer::removeRedundantSemicolons()
 {
+    Timer timer("Tokenizer::removeRedundantSemicolons", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (tok->link() && tok->str() == "(") {
             tok = tok->link();
@@ -4449,6 +4664,7 @@ void Tokenizer::removeRedundantSemicolons()
 
 bool Tokenizer::simplifyAddBraces()
 {
+    Timer timer("Tokenizer::simplifyAddBraces", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         Token const * tokRet=simplifyAddBracesToCommand(tok);
         if (!tokRet)
@@ -4583,6 +4799,7 @@ Token *Tokenizer::simplifyAddBracesPair(Token *tok, bool commandWithCondition)
 
 void Tokenizer::simplifyCompoundAssignment()
 {
+    Timer timer("Tokenizer::simplifyCompoundAssignment", _settings->showtime);
     // Simplify compound assignments:
     // "a+=b" => "a = a + b"
     for (Token *tok = list.front(); tok; tok = tok->next()) {
@@ -4692,6 +4909,7 @@ void Tokenizer::simplifyCompoundAssignment()
 
 bool Tokenizer::simplifyConditions()
 {
+    Timer timer("Tokenizer::simplifyConditions", _settings->showtime);
     bool ret = false;
 
     for (Token *tok = list.front(); tok; tok = tok->next()) {
@@ -4851,6 +5069,7 @@ bool Tokenizer::simplifyConditions()
 
 bool Tokenizer::simplifyConstTernaryOp()
 {
+    Timer timer("Tokenizer::simplifyConstTernaryOp", _settings->showtime);
     bool ret = false;
     const Token *templateParameterEnd = nullptr; // The end of the current template parameter list, if any
     for (Token *tok = list.front(); tok; tok = tok->next()) {
@@ -4932,6 +5151,7 @@ bool Tokenizer::simplifyConstTernaryOp()
 
 void Tokenizer::simplifyUndefinedSizeArray()
 {
+    Timer timer("Tokenizer::simplifyUndefinedSizeArray", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (Token::Match(tok, "%type%")) {
             Token *tok2 = tok->next();
@@ -4961,6 +5181,7 @@ void Tokenizer::simplifyUndefinedSizeArray()
 
 void Tokenizer::simplifyCasts()
 {
+    Timer timer("Tokenizer::simplifyCasts", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         // Don't remove cast in such cases:
         // *((char *)a + 1) = 0;
@@ -5052,6 +5273,7 @@ void Tokenizer::simplifyCasts()
 
 void Tokenizer::simplifyFunctionParameters()
 {
+    Timer timer("Tokenizer::simplifyFunctionParameters", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (tok->link() && Token::Match(tok, "{|[|(")) {
             tok = tok->link();
@@ -5221,6 +5443,7 @@ void Tokenizer::simplifyFunctionParameters()
 
 void Tokenizer::simplifyPointerToStandardType()
 {
+    Timer timer("Tokenizer::simplifyPointerToStandardType", _settings->showtime);
     if (!isC())
         return;
 
@@ -5240,6 +5463,7 @@ void Tokenizer::simplifyPointerToStandardType()
 
 void Tokenizer::simplifyFunctionPointers()
 {
+    Timer timer("Tokenizer::simplifyFunctionPointers", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         // #2873 - do not simplify function pointer usage here:
         // (void)(xy(*p)(0));
@@ -5333,6 +5557,7 @@ void Tokenizer::simplifyFunctionPointers()
 
 bool Tokenizer::simplifyFunctionReturn()
 {
+    Timer timer("Tokenizer::simplifyFunctionReturn", _settings->showtime);
     bool ret = false;
     for (const Token *tok = tokens(); tok; tok = tok->next()) {
         if (tok->str() == "{")
@@ -5362,6 +5587,7 @@ bool Tokenizer::simplifyFunctionReturn()
 
 void Tokenizer::simplifyVarDecl(const bool only_k_r_fpar)
 {
+    Timer timer("Tokenizer::simplifyVarDecl", _settings->showtime);
     simplifyVarDecl(list.front(), nullptr, only_k_r_fpar);
 }
 
@@ -5655,6 +5881,7 @@ void Tokenizer::simplifyVarDecl(Token * tokBegin, const Token * const tokEnd, co
 
 void Tokenizer::simplifyPlatformTypes()
 {
+    Timer timer("Tokenizer::simplifyPlatformTypes", _settings->showtime);
     enum { isLongLong, isLong, isInt } type;
 
     /** @todo This assumes a flat address space. Not true for segmented address space (FAR *). */
@@ -5762,6 +5989,7 @@ void Tokenizer::simplifyPlatformTypes()
 
 void Tokenizer::simplifyStdType()
 {
+    Timer timer("Tokenizer::simplifyStdType", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (Token::Match(tok, "char|short|int|long|unsigned|signed|double|float") || (_settings->standards.c >= Standards::C99 && Token::Match(tok, "complex|_Complex"))) {
             bool isFloat= false;
@@ -5823,6 +6051,7 @@ void Tokenizer::simplifyStdType()
 
 void Tokenizer::simplifyStaticConst()
 {
+    Timer timer("Tokenizer::simplifyStaticConst", _settings->showtime);
     // This function will simplify the token list so that the qualifiers "extern", "static"
     // and "const" appear in the reverse order to what is in the array below.
     const std::string qualifiers[] = {"const", "static", "extern"};
@@ -5865,6 +6094,7 @@ void Tokenizer::simplifyStaticConst()
 
 void Tokenizer::simplifyIfAndWhileAssign()
 {
+    Timer timer("Tokenizer::simplifyIfAndWhileAssign", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (!Token::Match(tok->next(), "if|while ("))
             continue;
@@ -5982,6 +6212,7 @@ void Tokenizer::simplifyIfAndWhileAssign()
 
 void Tokenizer::simplifyVariableMultipleAssign()
 {
+    Timer timer("Tokenizer::simplifyVariableMultipleAssign", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (Token::Match(tok, "%name% = %name% = %num%|%name% ;")) {
             // skip intermediate assignments
@@ -6036,6 +6267,7 @@ static const std::map<std::string, std::string> cAlternativeTokens = make_contai
 //  xor_eq   =>     ^=
 bool Tokenizer::simplifyCAlternativeTokens()
 {
+    Timer timer("Tokenizer::simplifyCAlternativeTokens", _settings->showtime);
     /* executable scope level */
     unsigned int executableScopeLevel = 0;
 
@@ -6079,6 +6311,7 @@ bool Tokenizer::simplifyCAlternativeTokens()
 // int i(0), j; => int i; i = 0; int j;
 void Tokenizer::simplifyInitVar()
 {
+    Timer timer("Tokenizer::simplifyInitVar", _settings->showtime);
     if (isC())
         return;
 
@@ -6158,6 +6391,7 @@ Token * Tokenizer::initVar(Token * tok)
 
 bool Tokenizer::simplifyKnownVariables()
 {
+    Timer timer("Tokenizer::simplifyKnownVariables", _settings->showtime);
     // return value for function. Set to true if any simplifications are made
     bool ret = false;
 
@@ -6900,6 +7134,7 @@ bool Tokenizer::simplifyKnownVariablesSimplify(Token **tok2, Token *tok3, unsign
 
 void Tokenizer::elseif()
 {
+    Timer timer("Tokenizer::elseif", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (!Token::simpleMatch(tok, "else if"))
             continue;
@@ -6923,6 +7158,7 @@ void Tokenizer::elseif()
 
 bool Tokenizer::simplifyRedundantParentheses()
 {
+    Timer timer("Tokenizer::simplifyRedundantParentheses", _settings->showtime);
     bool ret = false;
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (tok->str() != "(")
@@ -7084,6 +7320,7 @@ bool Tokenizer::simplifyRedundantParentheses()
 
 void Tokenizer::simplifyCharAt()
 {
+    Timer timer("Tokenizer::simplifyCharAt", _settings->showtime);
     // Replace "string"[0] with 's'
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (Token::Match(tok, "%str% [ %num% ]")) {
@@ -7099,6 +7336,7 @@ void Tokenizer::simplifyCharAt()
 
 void Tokenizer::simplifyReference()
 {
+    Timer timer("Tokenizer::simplifyReference", _settings->showtime);
     if (isC())
         return;
 
@@ -7134,11 +7372,13 @@ void Tokenizer::simplifyReference()
 
 bool Tokenizer::simplifyCalculations()
 {
+    Timer timer("Tokenizer::simplifyCalculations", _settings->showtime);
     return TemplateSimplifier::simplifyCalculations(list.front());
 }
 
 void Tokenizer::simplifyOffsetPointerDereference()
 {
+    Timer timer("Tokenizer::simplifyOffsetPointerDereference", _settings->showtime);
     // Replace "*(str + num)" => "str[num]" and
     // Replace "*(str - num)" => "str[-num]"
     for (Token *tok = list.front(); tok; tok = tok->next()) {
@@ -7173,6 +7413,7 @@ void Tokenizer::simplifyOffsetPointerDereference()
 
 void Tokenizer::simplifyOffsetPointerReference()
 {
+    Timer timer("Tokenizer::simplifyOffsetPointerReference", _settings->showtime);
     std::set<unsigned int> pod;
     for (const Token *tok = list.front(); tok; tok = tok->next()) {
         if (tok->isStandardType()) {
@@ -7221,6 +7462,7 @@ void Tokenizer::simplifyOffsetPointerReference()
 
 void Tokenizer::simplifyNestedStrcat()
 {
+    Timer timer("Tokenizer::simplifyNestedStrcat", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (! Token::Match(tok, "[;{}] strcat ( strcat (")) {
             continue;
@@ -7343,6 +7585,7 @@ static const std::set<std::string> stdFunctionsPresentInC = make_container< std:
 
 void Tokenizer::simplifyStd()
 {
+    Timer timer("Tokenizer::simplifyStd", _settings->showtime);
     if (isC())
         return;
 
@@ -7782,6 +8025,7 @@ bool Tokenizer::isTwoNumber(const std::string &s)
 // ------------------------------------------------------
 void Tokenizer::simplifyMathFunctions()
 {
+    Timer timer("Tokenizer::simplifyMathFunctions", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (tok->isName() && !tok->varId() && tok->strAt(1) == "(") { // precondition for function
             bool simplifcationMade = false;
@@ -7941,6 +8185,7 @@ void Tokenizer::simplifyMathFunctions()
 
 void Tokenizer::simplifyComma()
 {
+    Timer timer("Tokenizer::simplifyComma", _settings->showtime);
     bool inReturn = false;
 
     for (Token *tok = list.front(); tok; tok = tok->next()) {
@@ -8067,6 +8312,7 @@ void Tokenizer::simplifyComma()
 
 void Tokenizer::checkConfiguration() const
 {
+    Timer timer("Tokenizer::checkConfiguration", _settings->showtime);
     if (!_settings->checkConfiguration)
         return;
     for (const Token *tok = tokens(); tok; tok = tok->next()) {
@@ -8087,6 +8333,7 @@ void Tokenizer::checkConfiguration() const
 
 void Tokenizer::validateC() const
 {
+    Timer timer("Tokenizer::validateC", _settings->showtime);
     if (isCPP())
         return;
     for (const Token *tok = tokens(); tok; tok = tok->next()) {
@@ -8278,6 +8525,7 @@ std::string Tokenizer::simplifyString(const std::string &source)
 
 void Tokenizer::simplifyWhile0()
 {
+    Timer timer("Tokenizer::simplifyWhile0", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         // while (0)
         const bool while0(Token::Match(tok->previous(), "[{};] while ( 0|false )"));
@@ -8331,6 +8579,7 @@ void Tokenizer::simplifyWhile0()
 
 void Tokenizer::simplifyErrNoInWhile()
 {
+    Timer timer("Tokenizer::simplifyErrNoInWhile", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (tok->str() != "errno")
             continue;
@@ -8361,6 +8610,7 @@ void Tokenizer::simplifyErrNoInWhile()
 
 void Tokenizer::simplifyFuncInWhile()
 {
+    Timer timer("Tokenizer::simplifyFuncInWhile", _settings->showtime);
     unsigned int count = 0;
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (!Token::Match(tok, "while ( %name% ( %name% ) ) {"))
@@ -8398,6 +8648,7 @@ void Tokenizer::simplifyFuncInWhile()
 
 void Tokenizer::simplifyStructDecl()
 {
+    Timer timer("Tokenizer::simplifyStructDecl", _settings->showtime);
     // A counter that is used when giving unique names for anonymous structs.
     unsigned int count = 0;
 
@@ -8554,6 +8805,7 @@ void Tokenizer::simplifyStructDecl()
 
 void Tokenizer::simplifyCallingConvention()
 {
+    Timer timer("Tokenizer::simplifyCallingConvention", _settings->showtime);
     bool windows = _settings->isWindowsPlatform();
 
     for (Token *tok = list.front(); tok; tok = tok->next()) {
@@ -8565,6 +8817,7 @@ void Tokenizer::simplifyCallingConvention()
 
 void Tokenizer::simplifyDeclspec()
 {
+    Timer timer("Tokenizer::simplifyDeclspec", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         while (Token::Match(tok, "__declspec|_declspec (") && tok->next()->link() && tok->next()->link()->next()) {
             if (Token::Match(tok->tokAt(2), "noreturn|nothrow")) {
@@ -8589,6 +8842,7 @@ void Tokenizer::simplifyDeclspec()
 
 void Tokenizer::simplifyAttribute()
 {
+    Timer timer("Tokenizer::simplifyAttribute", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (Token::Match(tok, "%type% (") && !_settings->library.isNotLibraryFunction(tok)) {
             if (_settings->library.isFunctionConst(tok->str(), true))
@@ -8702,6 +8956,7 @@ static const std::set<std::string> keywords = make_container< std::set<std::stri
 //   - Not in C++ standard yet
 void Tokenizer::simplifyKeyword()
 {
+    Timer timer("Tokenizer::simplifyKeyword", _settings->showtime);
 
     // FIXME: There is a risk that "keywords" are removed by mistake. This
     // code should be fixed so it doesn't remove variables etc. Nonstandard
@@ -8784,6 +9039,7 @@ void Tokenizer::simplifyKeyword()
 
 void Tokenizer::simplifyAssignmentInFunctionCall()
 {
+    Timer timer("Tokenizer::simplifyAssignmentInFunctionCall", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (tok->str() == "(")
             tok = tok->link();
@@ -8823,6 +9079,7 @@ void Tokenizer::simplifyAssignmentInFunctionCall()
 
 void Tokenizer::simplifyAssignmentBlock()
 {
+    Timer timer("Tokenizer::simplifyAssignmentBlock", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (Token::Match(tok, "[;{}] %name% = ( {")) {
             const std::string &varname = tok->next()->str();
@@ -8858,6 +9115,7 @@ void Tokenizer::simplifyAssignmentBlock()
 // Remove __asm..
 void Tokenizer::simplifyAsm()
 {
+    Timer timer("Tokenizer::simplifyAsm", _settings->showtime);
     std::string instruction;
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (Token::Match(tok, "__asm|_asm|asm {") &&
@@ -8935,6 +9193,7 @@ void Tokenizer::simplifyAsm()
 
 void Tokenizer::simplifyAsm2()
 {
+    Timer timer("Tokenizer::simplifyAsm2", _settings->showtime);
     // Block declarations: ^{}
     // A C extension used to create lambda like closures.
 
@@ -8995,6 +9254,7 @@ void Tokenizer::simplifyAsm2()
 // Simplify bitfields
 void Tokenizer::simplifyBitfields()
 {
+    Timer timer("Tokenizer::simplifyBitfields", _settings->showtime);
     bool goback = false;
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (goback) {
@@ -9113,6 +9373,7 @@ static const std::set<std::string> stdFunctions = make_container<std::set<std::s
 // Add std:: in front of std classes, when using namespace std; was given
 void Tokenizer::simplifyNamespaceStd()
 {
+    Timer timer("Tokenizer::simplifyNamespaceStd", _settings->showtime);
     if (!isCPP())
         return;
 
@@ -9155,6 +9416,7 @@ void Tokenizer::simplifyNamespaceStd()
 
 void Tokenizer::simplifyMicrosoftMemoryFunctions()
 {
+    Timer timer("Tokenizer::simplifyMicrosoftMemoryFunctions", _settings->showtime);
     // skip if not Windows
     if (!_settings->isWindowsPlatform())
         return;
@@ -9249,6 +9511,7 @@ namespace {
 
 void Tokenizer::simplifyMicrosoftStringFunctions()
 {
+    Timer timer("Tokenizer::simplifyMicrosoftStringFunctions", _settings->showtime);
     // skip if not Windows
     if (!_settings->isWindowsPlatform())
         return;
@@ -9268,12 +9531,17 @@ void Tokenizer::simplifyMicrosoftStringFunctions()
             tok->deleteNext();
             if (!ansi)
                 tok->isLong(true);
-            while (Token::Match(tok->next(), "_T ( %char%|%str% )")) {
-                tok->next()->deleteNext();
-                tok->next()->deleteThis();
-                tok->next()->deleteNext();
-                tok->concatStr(tok->next()->str());
-                tok->deleteNext();
+            if (Token::Match(tok->next(), "_T ( %char%|%str% )")) {
+                std::string str(tok->str());
+                while (Token::Match(tok->next(), "_T ( %char%|%str% )")) {
+                    tok->next()->deleteNext();
+                    tok->next()->deleteThis();
+                    tok->next()->deleteNext();
+                    str.erase(str.size() - 1);
+                    str.append(tok->next()->str(), 1, std::string::npos);
+                    tok->deleteNext();
+                }
+                tok->str(str);
             }
         }
     }
@@ -9282,6 +9550,7 @@ void Tokenizer::simplifyMicrosoftStringFunctions()
 // Remove Borland code
 void Tokenizer::simplifyBorland()
 {
+    Timer timer("Tokenizer::simplifyBorland", _settings->showtime);
     // skip if not Windows
     if (!_settings->isWindowsPlatform())
         return;
@@ -9334,6 +9603,7 @@ void Tokenizer::simplifyBorland()
 // Remove Qt signals and slots
 void Tokenizer::simplifyQtSignalsSlots()
 {
+    Timer timer("Tokenizer::simplifyQtSignalsSlots", _settings->showtime);
     if (isC())
         return;
     for (Token *tok = list.front(); tok; tok = tok->next()) {
@@ -9386,6 +9656,7 @@ void Tokenizer::simplifyQtSignalsSlots()
 
 void Tokenizer::createSymbolDatabase()
 {
+    Timer timer("SymbolDatabase::SymbolDatabase", _settings->showtime);
     if (!_symbolDatabase)
         _symbolDatabase = new SymbolDatabase(this, _settings, _errorLogger);
     _symbolDatabase->validate();
@@ -9430,6 +9701,7 @@ static bool operatorEnd(const Token * tok)
 
 void Tokenizer::simplifyOperatorName()
 {
+    Timer timer("Tokenizer::simplifyOperatorName", _settings->showtime);
     if (isC())
         return;
 
@@ -9500,6 +9772,7 @@ void Tokenizer::simplifyOperatorName()
 // remove unnecessary member qualification..
 void Tokenizer::removeUnnecessaryQualification()
 {
+    Timer timer("Tokenizer::removeUnnecessaryQualification", _settings->showtime);
     if (isC())
         return;
 
@@ -9570,6 +9843,7 @@ void Tokenizer::removeUnnecessaryQualification()
 
 void Tokenizer::simplifyDeprecated()
 {
+    Timer timer("Tokenizer::simplifyDeprecated", _settings->showtime);
     if (_settings->standards.cpp != Standards::CPP11 || isC())
         return; // It is actually a C++14 feature, however, there seems to be nothing dangerous about removing it for C++11 as well
 
@@ -9583,6 +9857,7 @@ void Tokenizer::simplifyDeprecated()
 
 void Tokenizer::simplifyReturnStrncat()
 {
+    Timer timer("Tokenizer::simplifyReturnStrncat", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
         if (Token::simpleMatch(tok, "return strncat (") &&
             Token::simpleMatch(tok->linkAt(2), ") ;") &&
@@ -9707,6 +9982,7 @@ void Tokenizer::printUnknownTypes() const
 
 void Tokenizer::simplifyMathExpressions()
 {
+    Timer timer("Tokenizer::simplifyMathExpressions", _settings->showtime);
     for (Token *tok = list.front(); tok; tok = tok->next()) {
 
         //simplify Pythagorean trigonometric identity: pow(sin(x),2)+pow(cos(x),2) = 1
@@ -9797,6 +10073,7 @@ void Tokenizer::simplifyMathExpressions()
 
 bool Tokenizer::simplifyStrlen()
 {
+    Timer timer("Tokenizer::simplifyStrlen", _settings->showtime);
     // replace strlen(str)
     bool modified=false;
     for (Token *tok = list.front(); tok; tok = tok->next()) {
@@ -9811,6 +10088,7 @@ bool Tokenizer::simplifyStrlen()
 
 void Tokenizer::prepareTernaryOpForAST()
 {
+    Timer timer("Tokenizer::prepareTernaryOpForAST", _settings->showtime);
     // http://en.cppreference.com/w/cpp/language/operator_precedence says about ternary operator:
     //       "The expression in the middle of the conditional operator (between ? and :) is parsed as if parenthesized: its precedence relative to ?: is ignored."
     // The AST parser relies on this function to add such parentheses where necessary.
@@ -9882,6 +10160,7 @@ void Tokenizer::setPodTypes()
 
 void Tokenizer::SimplifyNamelessRValueReferences()
 {
+    Timer timer("Tokenizer::SimplifyNamelessRValueReferences", _settings->showtime);
     // Simplify nameless rValue references - named ones are simplified later
     for (Token* tok = list.front(); tok; tok = tok->next()) {
         if (Token::Match(tok, "&& [,)]")) {
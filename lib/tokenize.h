@@ -25,10 +25,15 @@
 #include "errorlogger.h"
 #include "tokenlist.h"
 
+#include <cstddef>
 #include <ctime>
 #include <list>
 #include <map>
+#include <set>
 #include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 class Settings;
 class SymbolDatabase;
@@ -42,6 +47,55 @@ namespace simplecpp {
 /// @addtogroup Core
 /// @{
 
+/**
+ * @brief Variable ids by name, used by Tokenizer::setVarId().
+ *
+ * Changes are recorded in an undo log so leaving a scope restores the
+ * variables of the outer scope without copying the map.
+ */
+class CPPCHECKLIB VariableMap {
+public:
+    /** Remember the current variables, see leaveScope() */
+    void enterScope() {
+        _scopeStart.push_back(_undo.size());
+    }
+
+    /**
+     * Restore the variables of the last enterScope()
+     * @return false if there is no scope to leave
+     */
+    bool leaveScope();
+
+    /** Add a variable, it hides a variable with the same name */
+    void addVariable(const std::string &varname, unsigned int varid);
+
+    /** @return variable id for the name, 0 if there is no such variable */
+    unsigned int varId(const std::string &varname) const {
+        const std::unordered_map<std::string, unsigned int>::const_iterator it = _varIds.find(varname);
+        return it != _varIds.end() ? it->second : 0;
+    }
+
+    bool hasVariable(const std::string &varname) const {
+        return _varIds.find(varname) != _varIds.end();
+    }
+
+    /** Remove all variables and scopes */
+    void clear() {
+        _varIds.clear();
+        _undo.clear();
+        _scopeStart.clear();
+    }
+
+private:
+    std::unordered_map<std::string, unsigned int> _varIds;
+
+    /** overwritten variables, 0 => the variable did not exist */
+    std::vector<std::pair<std::string, unsigned int> > _undo;
+
+    /** size of _undo at each enterScope() */
+    std::vector<std::size_t> _scopeStart;
+};
+
 /** @brief The main purpose is to tokenize the source code. It also has functions that simplify the token list */
 class CPPCHECKLIB Tokenizer {
 
@@ -708,9 +762,9 @@ private:
     void unsupportedTypedef(const Token *tok) const;
 
     void setVarIdClassDeclaration(const Token * const startToken,
-                                  const std::map<std::string, unsigned int> &variableId,
+                                  const VariableMap &variableId,
                                   const unsigned int scopeStartVarId,
-                                  std::map<unsigned int, std::map<std::string,unsigned int> >& structMembers);
+                                  std::unordered_map<unsigned int, std::unordered_map<std::string, unsigned int> >& structMembers);
 
 
     /**
@@ -828,6 +882,59 @@ private:
 
     Token *processFunc(Token *tok2, bool inOperator) const;
 
+    /**
+     * Positions of the names in the token list. simplifyTypedef uses it to
+     * visit only the uses of a typedef name instead of every token after
+     * the typedef. The position of a token is its Token::index(). Tokens
+     * are numbered with gaps so tokens that are added later can be
+     * numbered in between, see update(). The numbers are only used by
+     * simplifyTypedef, ValueFlow numbers the tokens again.
+     */
+    class NameIndex {
+    public:
+        explicit NameIndex(TokenList &list);
+
+        /** Number all tokens and record all names */
+        void rebuild();
+
+        /**
+         * Record the names between start and end after tokens were added,
+         * renamed or removed there. Added tokens are numbered, including
+         * those right after end. If there is no room between the numbers
+         * of their neighbours, all tokens are numbered again.
+         * @param removed names of the tokens that may have been removed
+         */
+        void update(Token *start, const Token *end, const std::set<std::string> &removed);
+
+        /** @return first token after tok and before end (nullptr for the list end) with the given name */
+        Token *next(const std::string &name, Token *tok, Token *end);
+
+        /**
+         * Continue the search for the uses of a typedef name after tok
+         * @param changedUse the use where tokens were changed, it is reset
+         * @param removed names of the tokens that may have been removed there
+         * @param jump go to the next use of name before end instead of the next token
+         */
+        Token *advance(const std::string &name, Token *tok, Token *&changedUse, const std::set<std::string> &removed, bool jump, Token *end);
+
+    private:
+        /** Position and token of a name, ordered by position */
+        typedef std::pair<unsigned int, Token *> Position;
+        typedef std::vector<Position> Positions;
+
+        static bool before(const Position &a, const Position &b) {
+            return a.first < b.first;
+        }
+
+        void add(Token *tok);
+
+        /** Number tok and the following tokens without a number, @return false if there is no room */
+        static bool number(Token *tok);
+
+        TokenList &_list;
+        std::unordered_map<std::string, Positions> _names;
+    };
+
     /**
     * Get new variable id.
     * @return new variable id
@@ -858,6 +965,9 @@ private:
     /** variable count */
     unsigned int _varId;
 
+    /** unnamed count "Unnamed0", "Unnamed1" etc */
+    unsigned int _unnamedCount;
+
     /**
      * was there any templates? templates that are "unused" are
      * removed from the token list
@@ -24,6 +24,7 @@
 #include "path.h"
 #include "settings.h"
 #include "token.h"
+#include "utils.h"
 
 #include <simplecpp.h>
 #include <cctype>
@@ -39,7 +40,7 @@ static const unsigned int AST_MAX_DEPTH = 50U;
 
 TokenList::TokenList(const Settings* settings) :
     _front(nullptr),
-    _back(nullptr),
+    _state(nullptr, &_arena),
     _settings(settings),
     _isC(false),
     _isCPP(false)
@@ -68,7 +69,7 @@ void TokenList::deallocateTokens()
 {
     deleteTokens(_front);
     _front = nullptr;
-    _back = nullptr;
+    _state.back = nullptr;
     _files.clear();
 }
 
@@ -142,18 +143,18 @@ void TokenList::addtoken(std::string str, const unsigned int lineno, const unsig
         str = MathLib::value(str).str() + suffix;
     }
 
-    if (_back) {
-        _back->insertToken(str);
+    if (_state.back) {
+        _state.back->insertToken(str);
     } else {
-        _front = new Token(&_back);
-        _back = _front;
-        _back->str(str);
+        _front = new (&_arena) Token(&_state);
+        _state.back = _front;
+        _state.back->str(str);
     }
 
     if (isCPP() && str == "delete")
-        _back->isKeyword(true);
-    _back->linenr(lineno);
-    _back->fileIndex(fileno);
+        _state.back->isKeyword(true);
+    _state.back->linenr(lineno);
+    _state.back->fileIndex(fileno);
 }
 
 void TokenList::addtoken(const Token * tok, const unsigned int lineno, const unsigned int fileno)
@@ -161,19 +162,19 @@ void TokenList::addtoken(const Token * tok, const unsigned int lineno, const uns
     if (tok == nullptr)
         return;
 
-    if (_back) {
-        _back->insertToken(tok->str(), tok->originalName());
+    if (_state.back) {
+        _state.back->insertToken(tok->str(), tok->originalName());
     } else {
-        _front = new Token(&_back);
-        _back = _front;
-        _back->str(tok->str());
+        _front = new (&_arena) Token(&_state);
+        _state.back = _front;
+        _state.back->str(tok->str());
         if (!tok->originalName().empty())
-            _back->originalName(tok->originalName());
+            _state.back->originalName(tok->originalName());
     }
 
-    _back->linenr(lineno);
-    _back->fileIndex(fileno);
-    _back->flags(tok->flags());
+    _state.back->linenr(lineno);
+    _state.back->fileIndex(fileno);
+    _state.back->flags(tok->flags());
 }
 //---------------------------------------------------------------------------
 // InsertTokens - Copy and insert tokens
@@ -264,20 +265,20 @@ void TokenList::createTokens(const simplecpp::TokenList *tokenList)
         if (str.size() > 1 && str[0] == '.' && std::isdigit(str[1]))
             str = '0' + str;
 
-        if (_back) {
-            _back->insertToken(str);
+        if (_state.back) {
+            _state.back->insertToken(str);
         } else {
-            _front = new Token(&_back);
-            _back = _front;
-            _back->str(str);
+            _front = new (&_arena) Token(&_state);
+            _state.back = _front;
+            _state.back->str(str);
         }
 
-        if (isCPP() && _back->str() == "delete")
-            _back->isKeyword(true);
-        _back->fileIndex(tok->location.fileIndex);
-        _back->linenr(tok->location.line);
-        _back->col(tok->location.col);
-        _back->isExpandedMacro(!tok->macro.empty());
+        if (isCPP() && _state.back->str() == "delete")
+            _state.back->isKeyword(true);
+        _state.back->fileIndex(tok->location.fileIndex);
+        _state.back->linenr(tok->location.line);
+        _state.back->col(tok->location.col);
+        _state.back->isExpandedMacro(!tok->macro.empty());
     }
 
     if (_settings && _settings->relativePaths) {
@@ -290,27 +291,24 @@ void TokenList::createTokens(const simplecpp::TokenList *tokenList)
 
 //---------------------------------------------------------------------------
 
+/** Add a string, terminated so "ab" "c" and "a" "bc" give different hashes */
+static void addString(FnvHash &hash, const std::string &str)
+{
+    hash.add(str);
+    hash.add("\xff", 1U);
+}
+
 unsigned long long TokenList::calculateChecksum() const
 {
-    unsigned long long checksum = 0;
+    FnvHash checksum;
     for (const Token* tok = front(); tok; tok = tok->next()) {
-        const unsigned int subchecksum1 = tok->flags() + tok->varId() + tok->tokType();
-        unsigned int subchecksum2 = 0;
-        for (std::size_t i = 0; i < tok->str().size(); i++)
-            subchecksum2 += (unsigned int)tok->str()[i];
-        if (!tok->originalName().empty()) {
-            for (std::size_t i = 0; i < tok->originalName().size(); i++)
-                subchecksum2 += (unsigned int) tok->originalName()[i];
-        }
-
-        checksum ^= ((static_cast<unsigned long long>(subchecksum1) << 32) | subchecksum2);
-
-        const bool bit1 = (checksum & 1) != 0;
-        checksum >>= 1;
-        if (bit1)
-            checksum |= (1ULL << 63);
+        addString(checksum, tok->str());
+        addString(checksum, tok->originalName());
+        checksum.addInt(tok->flags());
+        checksum.addInt(tok->varId());
+        checksum.addInt(static_cast<unsigned int>(tok->tokType()));
     }
-    return checksum;
+    return checksum.get();
 }
 
 
@@ -22,6 +22,7 @@
 //---------------------------------------------------------------------------
 
 #include "config.h"
+#include "tokenarena.h"
 
 #include <string>
 #include <vector>
@@ -36,6 +37,19 @@ namespace simplecpp {
 /// @addtogroup Core
 /// @{
 
+/**
+ * @brief The parts of a TokenList that are shared by all its tokens.
+ */
+struct TokenListState {
+    TokenListState(Token *back_, TokenArena *arena_) : back(back_), arena(arena_) {}
+
+    /** Last token of the list, updated when tokens are added or removed at the end */
+    Token *back;
+
+    /** Arena that the tokens and their data are allocated from, nullptr => heap */
+    TokenArena *arena;
+};
+
 class CPPCHECKLIB TokenList {
 public:
     explicit TokenList(const Settings* settings);
@@ -102,10 +116,10 @@ public:
 
     /** get last token of list */
     const Token *back() const {
-        return _back;
+        return _state.back;
     }
     Token *back() {
-        return _back;
+        return _state.back;
     }
 
     /**
@@ -164,8 +178,12 @@ private:
     /** Disable assignment operator, no implementation */
     TokenList &operator=(const TokenList &);
 
+    /** Tokens and the data they own, released together with the list */
+    TokenArena _arena;
+
     /** Token list */
-    Token *_front, *_back;
+    Token *_front;
+    TokenListState _state;
 
     /** filenames for the tokenized source code (source + included) */
     std::vector<std::string> _files;
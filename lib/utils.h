@@ -78,6 +78,42 @@ inline static const char *getOrdinalText(int i)
     return "th";
 }
 
+/** 64 bit FNV-1a hash that is computed incrementally */
+class FnvHash {
+public:
+    FnvHash() : _hash(14695981039346656037ULL) {}
+    void add(const char *data, std::size_t len) {
+        for (std::size_t i = 0; i < len; ++i) {
+            _hash ^= static_cast<unsigned char>(data[i]);
+            _hash *= 1099511628211ULL;
+        }
+    }
+    void add(const std::string &str) {
+        add(str.data(), str.size());
+    }
+    /** Add the bytes of an integer, least significant byte first */
+    template<class T>
+    void addInt(T value) {
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+            _hash ^= static_cast<unsigned char>(static_cast<unsigned long long>(value) >> (8U * i));
+            _hash *= 1099511628211ULL;
+        }
+    }
+    unsigned long long get() const {
+        return _hash;
+    }
+private:
+    unsigned long long _hash;
+};
+
+/** 64 bit FNV-1a hash of a string */
+inline unsigned long long fnv1a(const std::string &data)
+{
+    FnvHash hash;
+    hash.add(data);
+    return hash.get();
+}
+
 #define UNUSED(x) (void)(x)
 
 #endif
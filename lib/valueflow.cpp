@@ -26,6 +26,7 @@
 #include "settings.h"
 #include "standards.h"
 #include "symboldatabase.h"
+#include "timer.h"
 #include "token.h"
 #include "tokenlist.h"
 #include "utils.h"
@@ -265,7 +266,7 @@ static ValueFlow::Value castValue(ValueFlow::Value value, const ValueType::Sign
 /** set ValueFlow value and perform calculations if possible */
 static void setTokenValue(Token* tok, const ValueFlow::Value &value, const Settings *settings)
 {
-    if (!tok->addValue(value))
+    if (!tok->addValue(value, settings->valueFlowMaxValues))
         return;
 
     // Don't set parent for uninitialized values
@@ -310,7 +311,7 @@ static void setTokenValue(Token* tok, const ValueFlow::Value &value, const Setti
                 const Token *op = cond ? tok->astOperand1() : tok->astOperand2();
                 if (!op) // #7769 segmentation fault at setTokenValue()
                     return;
-                const std::list<ValueFlow::Value> &values = op->values();
+                const ValueFlow::TokenValues &values = op->values();
                 if (std::find(values.begin(), values.end(), value) != values.end())
                     setTokenValue(parent, value, settings);
             }
@@ -360,12 +361,12 @@ static void setTokenValue(Token* tok, const ValueFlow::Value &value, const Setti
             return;
         }
 
-        for (std::list<ValueFlow::Value>::const_iterator value1 = parent->astOperand1()->values().begin(); value1 != parent->astOperand1()->values().end(); ++value1) {
+        for (ValueFlow::TokenValues::const_iterator value1 = parent->astOperand1()->values().begin(); value1 != parent->astOperand1()->values().end(); ++value1) {
             if (!value1->isIntValue() && !value1->isFloatValue() && !value1->isTokValue())
                 continue;
             if (value1->isTokValue() && (!parent->isComparisonOp() || value1->tokvalue->tokType() != Token::eString))
                 continue;
-            for (std::list<ValueFlow::Value>::const_iterator value2 = parent->astOperand2()->values().begin(); value2 != parent->astOperand2()->values().end(); ++value2) {
+            for (ValueFlow::TokenValues::const_iterator value2 = parent->astOperand2()->values().begin(); value2 != parent->astOperand2()->values().end(); ++value2) {
                 if (!value2->isIntValue() && !value2->isFloatValue() && !value2->isTokValue())
                     continue;
                 if (value2->isTokValue() && (!parent->isComparisonOp() || value2->tokvalue->tokType() != Token::eString || value1->isTokValue()))
@@ -524,7 +525,7 @@ static void setTokenValue(Token* tok, const ValueFlow::Value &value, const Setti
 
     // !
     else if (parent->str() == "!") {
-        std::list<ValueFlow::Value>::const_iterator it;
+        ValueFlow::TokenValues::const_iterator it;
         for (it = tok->values().begin(); it != tok->values().end(); ++it) {
             if (!it->isIntValue())
                 continue;
@@ -536,7 +537,7 @@ static void setTokenValue(Token* tok, const ValueFlow::Value &value, const Setti
 
     // ~
     else if (parent->str() == "~") {
-        std::list<ValueFlow::Value>::const_iterator it;
+        ValueFlow::TokenValues::const_iterator it;
         for (it = tok->values().begin(); it != tok->values().end(); ++it) {
             if (!it->isIntValue())
                 continue;
@@ -560,7 +561,7 @@ static void setTokenValue(Token* tok, const ValueFlow::Value &value, const Setti
 
     // unary minus
     else if (parent->str() == "-" && !parent->astOperand2()) {
-        std::list<ValueFlow::Value>::const_iterator it;
+        ValueFlow::TokenValues::const_iterator it;
         for (it = tok->values().begin(); it != tok->values().end(); ++it) {
             if (!it->isIntValue() && !it->isFloatValue())
                 continue;
@@ -575,10 +576,10 @@ static void setTokenValue(Token* tok, const ValueFlow::Value &value, const Setti
 
     // Array element
     else if (parent->str() == "[" && parent->astOperand1() && parent->astOperand2()) {
-        for (std::list<ValueFlow::Value>::const_iterator value1 = parent->astOperand1()->values().begin(); value1 != parent->astOperand1()->values().end(); ++value1) {
+        for (ValueFlow::TokenValues::const_iterator value1 = parent->astOperand1()->values().begin(); value1 != parent->astOperand1()->values().end(); ++value1) {
             if (!value1->isTokValue())
                 continue;
-            for (std::list<ValueFlow::Value>::const_iterator value2 = parent->astOperand2()->values().begin(); value2 != parent->astOperand2()->values().end(); ++value2) {
+            for (ValueFlow::TokenValues::const_iterator value2 = parent->astOperand2()->values().begin(); value2 != parent->astOperand2()->values().end(); ++value2) {
                 if (!value2->isIntValue())
                     continue;
                 if (value1->varId == 0U || value2->varId == 0U ||
@@ -894,7 +895,7 @@ static void valueFlowBitAnd(TokenList *tokenlist)
 
 static void valueFlowOppositeCondition(SymbolDatabase *symboldatabase, const Settings *settings)
 {
-    for (std::list<Scope>::iterator scope = symboldatabase->scopeList.begin(); scope != symboldatabase->scopeList.end(); ++scope) {
+    for (BlockList<Scope>::iterator scope = symboldatabase->scopeList.begin(); scope != symboldatabase->scopeList.end(); ++scope) {
         if (scope->type != Scope::eIf)
             continue;
         Token *tok = const_cast<Token *>(scope->classDef);
@@ -1230,7 +1231,7 @@ static void valueFlowAST(Token *tok, unsigned int varid, const ValueFlow::Value
             return;
     } else if (tok->str() == "||" && tok->astOperand1()) {
         bool nonzero = false;
-        for (std::list<ValueFlow::Value>::const_iterator it = tok->astOperand1()->values().begin(); it != tok->astOperand1()->values().end(); ++it) {
+        for (ValueFlow::TokenValues::const_iterator it = tok->astOperand1()->values().begin(); it != tok->astOperand1()->values().end(); ++it) {
             nonzero |= (it->intvalue != 0);
         }
         if (!nonzero)
@@ -1265,6 +1266,55 @@ static void handleKnownValuesInLoop(const Token                 *startToken,
     }
 }
 
+namespace {
+    class VariableUsages;
+}
+
+/** Usages in the token list that ValueFlow::setValues() is processing in this thread */
+static thread_local const VariableUsages *variableUsages = nullptr;
+
+namespace {
+    /** Sorted token indexes of the usages of each variable. Used by valueFlowForward() while the object exists. */
+    class VariableUsages {
+    public:
+        /** Collect the usages in the token list. Token indexes must be assigned. */
+        explicit VariableUsages(const Token *front) {
+            variableUsages = this;
+            for (const Token *tok = front; tok; tok = tok->next()) {
+                const unsigned int varid = tok->varId();
+                if (varid == 0)
+                    continue;
+                if (varid >= _indexes.size())
+                    _indexes.resize(varid + 1U);
+                _indexes[varid].push_back(tok->index());
+            }
+        }
+
+        ~VariableUsages() {
+            variableUsages = nullptr;
+        }
+
+        /** index of the last usage of varid in [startIndex,endIndex), or 0 */
+        unsigned int last(unsigned int varid, unsigned int startIndex, unsigned int endIndex) const {
+            if (varid >= _indexes.size())
+                return 0;
+            const std::vector<unsigned int> &indexes = _indexes[varid];
+            std::vector<unsigned int>::const_iterator it = std::lower_bound(indexes.begin(), indexes.end(), endIndex);
+            if (it == indexes.begin() || *(--it) < startIndex)
+                return 0;
+            return *it;
+        }
+
+    private:
+        std::vector<std::vector<unsigned int> > _indexes;
+    };
+}
+
+/**
+ * Set values for variable usages from startToken until endToken
+ * @return false if the analysis bailed out. If stopAfterLastUsage is true the analysis is not
+ * continued after the last usage of the variable, true is returned then.
+ */
 static bool valueFlowForward(Token * const               startToken,
                              const Token * const         endToken,
                              const Variable * const      var,
@@ -1274,7 +1324,8 @@ static bool valueFlowForward(Token * const               startToken,
                              const bool                  subFunction,
                              TokenList * const           tokenlist,
                              ErrorLogger * const         errorLogger,
-                             const Settings * const      settings)
+                             const Settings * const      settings,
+                             const bool                  stopAfterLastUsage = true)
 {
     int indentlevel = 0;
     unsigned int number_of_if = 0;
@@ -1282,7 +1333,19 @@ static bool valueFlowForward(Token * const               startToken,
     bool returnStatement = false;  // current statement is a return, stop analysis at the ";"
     bool read = false;  // is variable value read?
 
+    // Values are only set for usages of the variable. Don't scan the rest of a long scope.
+    // Bailouts after the last usage are not reported, they could not change any value.
+    unsigned int lastUsage = 0;
+    if (stopAfterLastUsage && variableUsages && startToken && endToken && startToken->index() <= endToken->index()) {
+        lastUsage = variableUsages->last(varid, startToken->index(), endToken->index());
+        if (lastUsage == 0)
+            return true;
+    }
+
     for (Token *tok2 = startToken; tok2 && tok2 != endToken; tok2 = tok2->next()) {
+        if (lastUsage && tok2->index() > lastUsage)
+            return true;
+
         if (indentlevel >= 0 && tok2->str() == "{")
             ++indentlevel;
         else if (indentlevel >= 0 && tok2->str() == "}") {
@@ -1990,11 +2053,9 @@ static void valueFlowAfterAssign(TokenList *tokenlist, SymbolDatabase* symboldat
             if (!tok->astOperand2() || tok->astOperand2()->values().empty())
                 continue;
 
-            std::list<ValueFlow::Value> values = tok->astOperand2()->values();
-            for (std::list<ValueFlow::Value>::iterator it = values.begin(); it != values.end(); ++it) {
-                const std::string info = "Assignment '" + tok->expressionString() + "', assigned value is " + it->infoString();
-                it->errorPath.push_back(ErrorPathItem(tok->astOperand2(), info));
-            }
+            std::list<ValueFlow::Value> values(tok->astOperand2()->values().begin(), tok->astOperand2()->values().end());
+            for (std::list<ValueFlow::Value>::iterator it = values.begin(); it != values.end(); ++it)
+                it->errorPath.push_back(ValueFlow::Value::ErrorPathItem::assignment(tok->astOperand2(), *it));
             const bool constValue = tok->astOperand2()->isNumber();
 
             if (tokenlist->isCPP() && Token::Match(var->typeStartToken(), "bool|_Bool")) {
@@ -2148,7 +2209,7 @@ static void valueFlowAfterCondition(TokenList *tokenlist, SymbolDatabase* symbol
                         if (parent && parent->str() == "(")
                             values.front().setKnown();
                     }
-                    if (!valueFlowForward(startToken->next(), startToken->link(), var, varid, values, true, false, tokenlist, errorLogger, settings))
+                    if (!valueFlowForward(startToken->next(), startToken->link(), var, varid, values, true, false, tokenlist, errorLogger, settings, false))
                         continue;
                     values.front().setPossible();
                     if (isVariableChanged(startToken, startToken->link(), varid, var->isGlobal(), settings)) {
@@ -2489,7 +2550,7 @@ static void valueFlowForLoopSimplify(Token * const bodyStart, const unsigned int
                 (tok2->str() == "||" && !conditionIsFalse(tok2->astOperand1(), programMemory))) {
                 // Skip second expression..
                 const Token *parent = tok2;
-                while (parent && parent->str() == tok2->str())
+                while (parent && parent->strEquals(tok2))
                     parent = parent->astParent();
                 // Jump to end of condition
                 if (parent && parent->str() == "(") {
@@ -2556,7 +2617,7 @@ static void valueFlowForLoopSimplifyAfter(Token *fortok, unsigned int varid, con
 
     std::list<ValueFlow::Value> values;
     values.push_back(ValueFlow::Value(num));
-    values.back().errorPath.push_back(ErrorPathItem(fortok,"After for loop, " + var->name() + " has value " + values.back().infoString()));
+    values.back().errorPath.push_back(ValueFlow::Value::ErrorPathItem::loopEnd(fortok, var, values.back()));
 
     valueFlowForward(fortok->linkAt(1)->linkAt(1)->next(),
                      endToken,
@@ -2572,7 +2633,7 @@ static void valueFlowForLoopSimplifyAfter(Token *fortok, unsigned int varid, con
 
 static void valueFlowForLoop(TokenList *tokenlist, SymbolDatabase* symboldatabase, ErrorLogger *errorLogger, const Settings *settings)
 {
-    for (std::list<Scope>::const_iterator scope = symboldatabase->scopeList.begin(); scope != symboldatabase->scopeList.end(); ++scope) {
+    for (BlockList<Scope>::const_iterator scope = symboldatabase->scopeList.begin(); scope != symboldatabase->scopeList.end(); ++scope) {
         if (scope->type != Scope::eFor)
             continue;
 
@@ -2633,7 +2694,7 @@ static void valueFlowInjectParameter(TokenList* tokenlist, ErrorLogger* errorLog
 
 static void valueFlowSwitchVariable(TokenList *tokenlist, SymbolDatabase* symboldatabase, ErrorLogger *errorLogger, const Settings *settings)
 {
-    for (std::list<Scope>::iterator scope = symboldatabase->scopeList.begin(); scope != symboldatabase->scopeList.end(); ++scope) {
+    for (BlockList<Scope>::iterator scope = symboldatabase->scopeList.begin(); scope != symboldatabase->scopeList.end(); ++scope) {
         if (scope->type != Scope::ScopeType::eSwitch)
             continue;
         if (!Token::Match(scope->classDef, "switch ( %var% ) {"))
@@ -2682,9 +2743,9 @@ static void valueFlowSwitchVariable(TokenList *tokenlist, SymbolDatabase* symbol
     }
 }
 
-static void setTokenValues(Token *tok, const std::list<ValueFlow::Value> &values, const Settings *settings)
+static void setTokenValues(Token *tok, const ValueFlow::TokenValues &values, const Settings *settings)
 {
-    for (std::list<ValueFlow::Value>::const_iterator it = values.begin(); it != values.end(); ++it) {
+    for (ValueFlow::TokenValues::const_iterator it = values.begin(); it != values.end(); ++it) {
         const ValueFlow::Value &value = *it;
         if (value.isIntValue())
             setTokenValue(tok, value, settings);
@@ -2705,7 +2766,7 @@ static void valueFlowLibraryFunction(Token *tok, const std::string &returnValue,
         return;
 
     if (Token::simpleMatch(tokenList.front(), "strlen ( arg1 )") && arg1) {
-        for (std::list<ValueFlow::Value>::const_iterator it = arg1->values().begin(); it != arg1->values().end(); ++it) {
+        for (ValueFlow::TokenValues::const_iterator it = arg1->values().begin(); it != arg1->values().end(); ++it) {
             const ValueFlow::Value &value = *it;
             if (value.isTokValue() && value.tokvalue->tokType() == Token::eString) {
                 ValueFlow::Value retval(value); // copy all "inconclusive", "condition", etc attributes
@@ -2778,26 +2839,15 @@ static void valueFlowSubFunction(TokenList *tokenlist, ErrorLogger *errorLogger,
                 argvalues.push_back(ValueFlow::Value(0));
                 argvalues.push_back(ValueFlow::Value(1));
             } else {
-                argvalues = argtok->values();
+                argvalues.assign(argtok->values().begin(), argtok->values().end());
             }
 
             if (argvalues.empty())
                 continue;
 
             // Error path..
-            for (std::list<ValueFlow::Value>::iterator it = argvalues.begin(); it != argvalues.end(); ++it) {
-                std::string nr = MathLib::toString(argnr + 1) + getOrdinalText(argnr + 1);
-
-                it->errorPath.push_back(ErrorPathItem(argtok,
-                                                      "Calling function '" +
-                                                      calledFunction->name() +
-                                                      "', " +
-                                                      nr +
-                                                      " argument '" +
-                                                      argvar->name() +
-                                                      "' value is " +
-                                                      it->infoString()));
-            }
+            for (std::list<ValueFlow::Value>::iterator it = argvalues.begin(); it != argvalues.end(); ++it)
+                it->errorPath.push_back(ValueFlow::Value::ErrorPathItem::functionArgument(argtok, calledFunction, argnr, *it));
 
             // passed values are not "known"..
             for (std::list<ValueFlow::Value>::iterator it = argvalues.begin(); it != argvalues.end(); ++it) {
@@ -2823,9 +2873,9 @@ static void valueFlowFunctionDefaultParameter(TokenList *tokenlist, SymbolDataba
         for (std::size_t arg = function->minArgCount(); arg < function->argCount(); arg++) {
             const Variable* var = function->getArgumentVar(arg);
             if (var && var->hasDefault() && Token::Match(var->nameToken(), "%var% = %num%|%str% [,)]")) {
-                const std::list<ValueFlow::Value> &values = var->nameToken()->tokAt(2)->values();
+                const ValueFlow::TokenValues &values = var->nameToken()->tokAt(2)->values();
                 std::list<ValueFlow::Value> argvalues;
-                for (std::list<ValueFlow::Value>::const_iterator it = values.begin(); it != values.end(); ++it) {
+                for (ValueFlow::TokenValues::const_iterator it = values.begin(); it != values.end(); ++it) {
                     ValueFlow::Value v(*it);
                     v.defaultArg = true;
                     v.changeKnownToPossible();
@@ -2964,26 +3014,90 @@ ValueFlow::Value::Value(const Token *c, long long val)
       defaultArg(false),
       valueKind(ValueKind::Possible)
 {
-    errorPath.push_back(ErrorPathItem(c, "Assuming that condition '" + c->expressionString() + "' is not redundant"));
+    errorPath.push_back(ErrorPathItem::condition(c));
 }
 
-std::string ValueFlow::Value::infoString() const
+static std::string infoString(ValueFlow::Value::ValueType valueType, long long intvalue, double floatValue, const Token *tokvalue)
 {
     switch (valueType) {
-    case INT:
+    case ValueFlow::Value::INT:
         return MathLib::toString(intvalue);
-    case TOK:
+    case ValueFlow::Value::TOK:
         return tokvalue->str();
-    case FLOAT:
+    case ValueFlow::Value::FLOAT:
         return MathLib::toString(floatValue);
-    case MOVED:
+    case ValueFlow::Value::MOVED:
         return "<Moved>";
-    case UNINIT:
+    case ValueFlow::Value::UNINIT:
         return "<Uninit>";
     };
     throw InternalError(nullptr, "Invalid ValueFlow Value type");
 }
 
+std::string ValueFlow::Value::infoString() const
+{
+    return ::infoString(valueType, intvalue, floatValue, tokvalue);
+}
+
+ValueFlow::Value::ErrorPathItem::ErrorPathItem(const Token *tok_, Kind kind_, const Value *value)
+    : tok(tok_), kind(kind_), argnr(0U), function(nullptr), valueType(value ? value->valueType : UNINIT), intvalue(0)
+{
+    if (!value)
+        return;
+    if (valueType == FLOAT)
+        floatValue = value->floatValue;
+    else if (valueType == TOK)
+        tokvalue = value->tokvalue;
+    else
+        intvalue = value->intvalue;
+}
+
+ValueFlow::Value::ErrorPathItem ValueFlow::Value::ErrorPathItem::assignment(const Token *tok, const Value &value)
+{
+    return ErrorPathItem(tok, ASSIGNMENT, &value);
+}
+
+ValueFlow::Value::ErrorPathItem ValueFlow::Value::ErrorPathItem::condition(const Token *tok)
+{
+    return ErrorPathItem(tok, CONDITION, nullptr);
+}
+
+ValueFlow::Value::ErrorPathItem ValueFlow::Value::ErrorPathItem::functionArgument(const Token *tok, const Function *function, unsigned int argnr, const Value &value)
+{
+    ErrorPathItem item(tok, FUNCTION_ARGUMENT, &value);
+    item.function = function;
+    item.argnr = argnr;
+    return item;
+}
+
+ValueFlow::Value::ErrorPathItem ValueFlow::Value::ErrorPathItem::loopEnd(const Token *tok, const Variable *var, const Value &value)
+{
+    ErrorPathItem item(tok, LOOP_END, &value);
+    item.var = var;
+    return item;
+}
+
+std::string ValueFlow::Value::ErrorPathItem::str() const
+{
+    const std::string value = ::infoString(valueType,
+                                           valueType == FLOAT ? 0 : intvalue,
+                                           valueType == FLOAT ? floatValue : 0.0,
+                                           valueType == TOK ? tokvalue : nullptr);
+    switch (kind) {
+    case ASSIGNMENT:
+        return "Assignment '" + tok->astParent()->expressionString() + "', assigned value is " + value;
+    case CONDITION:
+        return "Assuming that condition '" + tok->expressionString() + "' is not redundant";
+    case FUNCTION_ARGUMENT:
+        return "Calling function '" + function->name() + "', " +
+               MathLib::toString(argnr + 1) + getOrdinalText(argnr + 1) +
+               " argument '" + function->getArgumentVar(argnr)->name() + "' value is " + value;
+    case LOOP_END:
+        return "After for loop, " + var->name() + " has value " + value;
+    };
+    throw InternalError(tok, "Invalid ValueFlow error path item");
+}
+
 const ValueFlow::Value *ValueFlow::valueFlowConstantFoldAST(const Token *expr, const Settings *settings)
 {
     if (expr && expr->values().empty()) {
@@ -2997,25 +3111,78 @@ const ValueFlow::Value *ValueFlow::valueFlowConstantFoldAST(const Token *expr, c
 
 void ValueFlow::setValues(TokenList *tokenlist, SymbolDatabase* symboldatabase, ErrorLogger *errorLogger, const Settings *settings)
 {
+    Timer timerSetValues("ValueFlow::setValues", settings->showtime);
+
+    Token::assignIndexes(tokenlist->front());
     for (Token *tok = tokenlist->front(); tok; tok = tok->next())
         tok->clearValueFlow();
 
-    valueFlowNumber(tokenlist);
-    valueFlowString(tokenlist);
-    valueFlowArray(tokenlist);
-    valueFlowPointerAlias(tokenlist);
-    valueFlowFunctionReturn(tokenlist, errorLogger);
-    valueFlowBitAnd(tokenlist);
-    valueFlowOppositeCondition(symboldatabase, settings);
-    valueFlowBeforeCondition(tokenlist, symboldatabase, errorLogger, settings);
-    valueFlowAfterMove(tokenlist, symboldatabase, errorLogger, settings);
-    valueFlowAfterAssign(tokenlist, symboldatabase, errorLogger, settings);
-    valueFlowAfterCondition(tokenlist, symboldatabase, errorLogger, settings);
-    valueFlowSwitchVariable(tokenlist, symboldatabase, errorLogger, settings);
-    valueFlowForLoop(tokenlist, symboldatabase, errorLogger, settings);
-    valueFlowSubFunction(tokenlist, errorLogger, settings);
-    valueFlowFunctionDefaultParameter(tokenlist, symboldatabase, errorLogger, settings);
-    valueFlowUninit(tokenlist, symboldatabase, errorLogger, settings);
+    const VariableUsages usages(tokenlist->front());
+
+    {
+        Timer timer("ValueFlow::valueFlowNumber", settings->showtime);
+        valueFlowNumber(tokenlist);
+    }
+    {
+        Timer timer("ValueFlow::valueFlowString", settings->showtime);
+        valueFlowString(tokenlist);
+    }
+    {
+        Timer timer("ValueFlow::valueFlowArray", settings->showtime);
+        valueFlowArray(tokenlist);
+    }
+    {
+        Timer timer("ValueFlow::valueFlowPointerAlias", settings->showtime);
+        valueFlowPointerAlias(tokenlist);
+    }
+    {
+        Timer timer("ValueFlow::valueFlowFunctionReturn", settings->showtime);
+        valueFlowFunctionReturn(tokenlist, errorLogger);
+    }
+    {
+        Timer timer("ValueFlow::valueFlowBitAnd", settings->showtime);
+        valueFlowBitAnd(tokenlist);
+    }
+    {
+        Timer timer("ValueFlow::valueFlowOppositeCondition", settings->showtime);
+        valueFlowOppositeCondition(symboldatabase, settings);
+    }
+    {
+        Timer timer("ValueFlow::valueFlowBeforeCondition", settings->showtime);
+        valueFlowBeforeCondition(tokenlist, symboldatabase, errorLogger, settings);
+    }
+    {
+        Timer timer("ValueFlow::valueFlowAfterMove", settings->showtime);
+        valueFlowAfterMove(tokenlist, symboldatabase, errorLogger, settings);
+    }
+    {
+        Timer timer("ValueFlow::valueFlowAfterAssign", settings->showtime);
+        valueFlowAfterAssign(tokenlist, symboldatabase, errorLogger, settings);
+    }
+    {
+        Timer timer("ValueFlow::valueFlowAfterCondition", settings->showtime);
+        valueFlowAfterCondition(tokenlist, symboldatabase, errorLogger, settings);
+    }
+    {
+        Timer timer("ValueFlow::valueFlowSwitchVariable", settings->showtime);
+        valueFlowSwitchVariable(tokenlist, symboldatabase, errorLogger, settings);
+    }
+    {
+        Timer timer("ValueFlow::valueFlowForLoop", settings->showtime);
+        valueFlowForLoop(tokenlist, symboldatabase, errorLogger, settings);
+    }
+    {
+        Timer timer("ValueFlow::valueFlowSubFunction", settings->showtime);
+        valueFlowSubFunction(tokenlist, errorLogger, settings);
+    }
+    {
+        Timer timer("ValueFlow::valueFlowFunctionDefaultParameter", settings->showtime);
+        valueFlowFunctionDefaultParameter(tokenlist, symboldatabase, errorLogger, settings);
+    }
+    {
+        Timer timer("ValueFlow::valueFlowUninit", settings->showtime);
+        valueFlowUninit(tokenlist, symboldatabase, errorLogger, settings);
+    }
 }
 
 
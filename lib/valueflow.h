@@ -22,23 +22,23 @@
 //---------------------------------------------------------------------------
 
 #include "config.h"
+#include "smallvector.h"
 
 #include <list>
 #include <string>
-#include <utility>
+#include <vector>
 
 class ErrorLogger;
+class Function;
 class Settings;
 class SymbolDatabase;
 class Token;
 class TokenList;
+class Variable;
 
 namespace ValueFlow {
     class CPPCHECKLIB Value {
     public:
-        typedef std::pair<const Token *, std::string> ErrorPathItem;
-        typedef std::list<ErrorPathItem> ErrorPath;
-
         explicit Value(long long val = 0) : valueType(INT), intvalue(val), tokvalue(nullptr), floatValue(0.0), moveKind(NonMovedVariable), varvalue(val), condition(nullptr), varId(0U), conditional(false), inconclusive(false), defaultArg(false), valueKind(ValueKind::Possible) {}
         Value(const Token *c, long long val);
 
@@ -95,6 +95,57 @@ namespace ValueFlow {
             return valueType == UNINIT;
         }
 
+        /**
+         * Step in the error path of a value. Only the tokens, symbols and
+         * value that are needed are stored. The text is created by str()
+         * when an error is reported.
+         */
+        class CPPCHECKLIB ErrorPathItem {
+        public:
+            enum Kind {
+                /** the value is assigned, tok is the assigned expression */
+                ASSIGNMENT,
+                /** tok is a condition that is assumed not to be redundant */
+                CONDITION,
+                /** the value is passed to a function, tok is the argument */
+                FUNCTION_ARGUMENT,
+                /** the loop variable has the value after a for loop, tok is the 'for' */
+                LOOP_END
+            };
+
+            static ErrorPathItem assignment(const Token *tok, const Value &value);
+            static ErrorPathItem condition(const Token *tok);
+            static ErrorPathItem functionArgument(const Token *tok, const Function *function, unsigned int argnr, const Value &value);
+            static ErrorPathItem loopEnd(const Token *tok, const Variable *var, const Value &value);
+
+            /** Create the text for this step */
+            std::string str() const;
+
+            const Token *tok;
+            Kind kind;
+
+        private:
+            ErrorPathItem(const Token *tok_, Kind kind_, const Value *value);
+
+            /** FUNCTION_ARGUMENT: argument number, starting at 0 */
+            unsigned int argnr;
+            union {
+                /** FUNCTION_ARGUMENT: called function */
+                const Function *function;
+                /** LOOP_END: loop variable */
+                const Variable *var;
+            };
+
+            /** The value when this step was added */
+            ValueType valueType;
+            union {
+                long long intvalue;
+                double floatValue;
+                const Token *tokvalue;
+            };
+        };
+        typedef std::vector<ErrorPathItem> ErrorPath;
+
         /** int value */
         long long intvalue;
 
@@ -113,6 +164,7 @@ namespace ValueFlow {
         /** Condition that this value depends on */
         const Token *condition;
 
+        /** How the value got here, see ErrorPathItem */
         ErrorPath errorPath;
 
         /** For calculated values - varId that calculated value depends on */
@@ -173,6 +225,9 @@ namespace ValueFlow {
         }
     };
 
+    /** Values of a token. Nearly all tokens that have values have exactly one. */
+    typedef SmallVector<Value, 1> TokenValues;
+
     /// Constant folding of expression. This can be used before the full ValueFlow has been executed (ValueFlow::setValues).
     const ValueFlow::Value * valueFlowConstantFoldAST(const Token *expr, const Settings *settings);
 
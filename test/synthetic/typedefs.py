@@ -0,0 +1,63 @@
+#!/usr/bin/env python
+#
+# Benchmark for Tokenizer::simplifyTypedef
+#
+# Generates headers with many typedefs, like system or generated protocol
+# headers, where most typedefs are not used. The time for simplifyTypedef
+# should grow linearly with the number of typedefs.
+#
+# Usage: typedefs.py path/to/cppcheck [count ...]
+
+import os
+import re
+import subprocess
+import sys
+import tempfile
+
+
+def generate(filename, count):
+    f = open(filename, 'wt')
+    for i in range(count):
+        f.write('typedef unsigned int u%d_t;\n' % i)
+        f.write('typedef struct s%d { u%d_t a; int b; } s%d_t;\n' % (i, i, i))
+        f.write('typedef void (*callback%d_t)(s%d_t *, int);\n' % (i, i))
+    f.write('void f(void) {\n')
+    for i in range(0, count, 100):
+        f.write('    s%d_t s%d;\n' % (i, i))
+        f.write('    s%d.a = 0;\n' % i)
+    f.write('}\n')
+    f.close()
+
+
+def simplifyTypedefTime(cppcheck, filename):
+    p = subprocess.Popen([cppcheck, '--showtime=summary', '-q', filename],
+                         stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    stdout, stderr = p.communicate()
+    for line in stdout.decode('utf-8', 'replace').split('\n'):
+        res = re.match(r'Tokenizer::tokenize::simplifyTypedef: ([0-9.e-]+)s', line)
+        if res:
+            return float(res.group(1))
+    return None
+
+
+if len(sys.argv) < 2:
+    print('Usage: typedefs.py path/to/cppcheck [count ...]')
+    sys.exit(1)
+
+counts = [int(arg) for arg in sys.argv[2:]]
+if not counts:
+    counts = [1000, 2000, 4000, 8000]
+
+fd, filename = tempfile.mkstemp(suffix='.c')
+os.close(fd)
+try:
+    print('typedefs  simplifyTypedef')
+    for count in counts:
+        generate(filename, count)
+        t = simplifyTypedefTime(sys.argv[1], filename)
+        if t is None:
+            print('%8d  no timing' % (3 * count))
+        else:
+            print('%8d  %.3fs' % (3 * count, t))
+finally:
+    os.remove(filename)
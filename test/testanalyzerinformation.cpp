@@ -0,0 +1,364 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2016 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "analyzerinfo.h"
+#include "testsuite.h"
+
+#include <tinyxml2.h>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <list>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#include <sys/utime.h>
+#else
+#include <sys/stat.h>
+#include <utime.h>
+#endif
+
+class TestAnalyzerInformation : public TestFixture {
+public:
+    TestAnalyzerInformation() : TestFixture("TestAnalyzerInformation") {
+    }
+
+private:
+
+    void run() {
+        TEST_CASE(databaseRoundTrip);
+        TEST_CASE(periodicSave);
+        TEST_CASE(convertXml);
+        TEST_CASE(getDependency);
+        TEST_CASE(isUnchanged);
+        TEST_CASE(isUnchangedIncludeDirs);
+    }
+
+    static void createDir(const std::string &dir) {
+#ifdef _WIN32
+        _mkdir(dir.c_str());
+#else
+        mkdir(dir.c_str(), 0777);
+#endif
+    }
+
+    static void writeFile(const std::string &filename, const std::string &content, std::time_t mtime) {
+        {
+            std::ofstream fout(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+            fout << content;
+        }
+        setModificationTime(filename, mtime);
+    }
+
+    static void setModificationTime(const std::string &filename, std::time_t mtime) {
+#ifdef _WIN32
+        struct _utimbuf times;
+        times.actime = times.modtime = mtime;
+        _utime(filename.c_str(), &times);
+#else
+        struct utimbuf times;
+        times.actime = times.modtime = mtime;
+        utime(filename.c_str(), &times);
+#endif
+    }
+
+    static ErrorLogger::ErrorMessage errorMessage() {
+        std::list<ErrorLogger::ErrorMessage::FileLocation> callStack;
+        callStack.push_back(ErrorLogger::ErrorMessage::FileLocation("test.cpp", 3));
+        return ErrorLogger::ErrorMessage(callStack, "test.cpp", Severity::error, "Programming error.", "errorId", false);
+    }
+
+    void databaseRoundTrip() const {
+        const std::string buildDir("testanalyzerinformation1");
+        createDir(buildDir);
+
+        AnalyzerDatabase::FileData fileData;
+        fileData.sourcefile = "test.cpp";
+        fileData.cfg = "A=1";
+        fileData.checksum = 0x123456789abcdefULL;
+        fileData.errors.push_back(errorMessage().serialize());
+        fileData.fileInfo.push_back(std::make_pair(std::string("CheckX"), std::string("<x/>\n")));
+        fileData.settingsChecksum = 42;
+        AnalyzerDatabase::Dependency dependency;
+        dependency.filename = "test.h";
+        dependency.size = 100;
+        dependency.mtime = 1234567890;
+        dependency.hash = 0xfedcba987654321ULL;
+        fileData.dependencies.push_back(dependency);
+        {
+            AnalyzerDatabase db(buildDir);
+            db.insert(fileData);
+            ASSERT(db.save());
+        }
+
+        AnalyzerDatabase db(buildDir);
+        ASSERT(db.load());
+        ASSERT_EQUALS(1U, db.size());
+        AnalyzerDatabase::FileData data;
+        ASSERT(!db.find("test.cpp", "", &data));
+        ASSERT(db.find("test.cpp", "A=1", &data));
+        ASSERT_EQUALS("test.cpp", data.sourcefile);
+        ASSERT_EQUALS("A=1", data.cfg);
+        ASSERT(data.checksum == fileData.checksum);
+        ASSERT_EQUALS(1U, data.errors.size());
+        ASSERT_EQUALS(fileData.errors.front(), data.errors.front());
+        ASSERT_EQUALS(1U, data.fileInfo.size());
+        ASSERT_EQUALS("CheckX", data.fileInfo.front().first);
+        ASSERT_EQUALS("<x/>\n", data.fileInfo.front().second);
+        ASSERT(data.settingsChecksum == 42U);
+        ASSERT_EQUALS(1U, data.dependencies.size());
+        ASSERT_EQUALS("test.h", data.dependencies[0].filename);
+        ASSERT(data.dependencies[0].size == 100);
+        ASSERT(data.dependencies[0].mtime == 1234567890);
+        ASSERT(data.dependencies[0].hash == dependency.hash);
+
+        std::remove((buildDir + "/analyzerinfo.bin").c_str());
+        std::remove(buildDir.c_str());
+    }
+
+    void periodicSave() const {
+        const std::string buildDir("testanalyzerinformation5");
+        createDir(buildDir);
+
+        AnalyzerDatabase::FileData fileData;
+        fileData.sourcefile = "test.cpp";
+        fileData.checksum = 1;
+
+        // the file is not written until the interval has passed
+        AnalyzerDatabase db(buildDir);
+        db.insert(fileData);
+        {
+            AnalyzerDatabase db2(buildDir);
+            db2.load();
+            ASSERT_EQUALS(0U, db2.size());
+        }
+
+        // the file is written without a call to save()
+        db.setSaveInterval(0);
+        fileData.sourcefile = "test2.cpp";
+        db.insert(fileData);
+        {
+            AnalyzerDatabase db2(buildDir);
+            ASSERT(db2.load());
+            ASSERT_EQUALS(2U, db2.size());
+        }
+
+        std::remove((buildDir + "/analyzerinfo.bin").c_str());
+        std::remove(buildDir.c_str());
+    }
+
+    void convertXml() const {
+        const std::string buildDir("testanalyzerinformation2");
+        createDir(buildDir);
+
+        std::list<std::string> sourcefiles;
+        sourcefiles.push_back("test.cpp");
+        AnalyzerInformation::writeFilesTxt(buildDir, sourcefiles, std::list<ImportProject::FileSettings>());
+        {
+            std::ofstream fout((buildDir + "/test.a1").c_str());
+            fout << "<?xml version=\"1.0\"?>\n"
+                 << "<analyzerinfo checksum=\"123\">\n"
+                 << errorMessage().toXML() << '\n'
+                 << "  <FileInfo check=\"CheckX\">\n<x/>\n  </FileInfo>\n"
+                 << "</analyzerinfo>\n";
+        }
+
+        AnalyzerDatabase db(buildDir);
+        ASSERT(db.load());
+        ASSERT_EQUALS(1U, db.size());
+        AnalyzerDatabase::FileData data;
+        ASSERT(db.find("test.cpp", "", &data));
+        ASSERT(data.checksum == 123U);
+        ASSERT_EQUALS(1U, data.errors.size());
+        ErrorLogger::ErrorMessage msg;
+        ASSERT(msg.deserialize(data.errors.front()));
+        ASSERT_EQUALS(errorMessage().toXML(), msg.toXML());
+        ASSERT_EQUALS(1U, data.fileInfo.size());
+        tinyxml2::XMLDocument doc;
+        ASSERT(AnalyzerDatabase::parseFileInfo(data.fileInfo.front(), &doc));
+        ASSERT_EQUALS("CheckX", doc.FirstChildElement()->Attribute("check"));
+        ASSERT_EQUALS("x", doc.FirstChildElement()->FirstChildElement()->Name());
+        // No dependencies are known, the TU is analyzed the next time
+        ASSERT(data.dependencies.empty());
+
+        // The converted data is written in the binary format
+        ASSERT(db.save());
+        AnalyzerDatabase db2(buildDir);
+        ASSERT(db2.load());
+        ASSERT(db2.find("test.cpp", "", &data));
+        ASSERT(data.checksum == 123U);
+
+        std::remove((buildDir + "/analyzerinfo.bin").c_str());
+        std::remove((buildDir + "/test.a1").c_str());
+        std::remove((buildDir + "/files.txt").c_str());
+        std::remove(buildDir.c_str());
+    }
+
+    void getDependency() const {
+        const std::string filename("testanalyzerinformation3.h");
+        const std::time_t mtime = std::time(nullptr) - 100;
+        writeFile(filename, "int x;", mtime);
+
+        AnalyzerDatabase::Dependency dependency;
+        ASSERT(AnalyzerInformation::getDependency(filename, &dependency));
+        ASSERT_EQUALS(filename, dependency.filename);
+        ASSERT(dependency.size == 6);
+        ASSERT(dependency.mtime == mtime);
+
+        AnalyzerDatabase::Dependency dependency2;
+        writeFile(filename, "int y;", mtime);
+        ASSERT(AnalyzerInformation::getDependency(filename, &dependency2));
+        ASSERT(dependency.hash != dependency2.hash);
+
+        // The stored hash is reused when size and modification time are unchanged
+        AnalyzerDatabase::Dependency previous(dependency);
+        ASSERT(AnalyzerInformation::getDependency(filename, &dependency2, &previous));
+        ASSERT(dependency.hash == dependency2.hash);
+        previous.mtime = mtime - 1;
+        ASSERT(AnalyzerInformation::getDependency(filename, &dependency2, &previous));
+        ASSERT(dependency.hash != dependency2.hash);
+
+        // The modification time of recently modified files is not trusted
+        writeFile(filename, "int y;", std::time(nullptr));
+        ASSERT(AnalyzerInformation::getDependency(filename, &dependency2));
+        ASSERT(dependency2.mtime == 0);
+        previous = dependency2;
+        previous.hash = dependency.hash;
+        ASSERT(AnalyzerInformation::getDependency(filename, &dependency2, &previous));
+        ASSERT(dependency.hash != dependency2.hash);
+
+        std::remove(filename.c_str());
+        ASSERT(!AnalyzerInformation::getDependency(filename, &dependency2));
+    }
+
+    void isUnchanged() const {
+        const std::string buildDir("testanalyzerinformation4");
+        const std::string sourcefile("testanalyzerinformation4.cpp");
+        const std::string header("testanalyzerinformation4.h");
+        createDir(buildDir);
+        const std::time_t mtime = std::time(nullptr) - 100;
+        writeFile(sourcefile, "#include \"testanalyzerinformation4.h\"", mtime);
+        writeFile(header, "int x;", mtime);
+
+        AnalyzerDatabase::FileData fileData;
+        fileData.sourcefile = sourcefile;
+        fileData.settingsChecksum = 1;
+        fileData.errors.push_back(errorMessage().serialize());
+        fileData.dependencies.resize(2);
+        ASSERT(AnalyzerInformation::getDependency(sourcefile, &fileData.dependencies[0]));
+        ASSERT(AnalyzerInformation::getDependency(header, &fileData.dependencies[1]));
+        AnalyzerDatabase::instance(buildDir).insert(fileData);
+
+        std::list<ErrorLogger::ErrorMessage> errors;
+        ASSERT(AnalyzerInformation::isUnchanged(buildDir, sourcefile, "", 1, &errors));
+        ASSERT_EQUALS(1U, errors.size());
+        ASSERT_EQUALS(errorMessage().toXML(), errors.front().toXML());
+        errors.clear();
+
+        // Other settings or cfg
+        ASSERT(!AnalyzerInformation::isUnchanged(buildDir, sourcefile, "", 2, &errors));
+        ASSERT(!AnalyzerInformation::isUnchanged(buildDir, sourcefile, "A=1", 1, &errors));
+        ASSERT(errors.empty());
+
+        // Touched header with same content
+        writeFile(header, "int x;", mtime + 1);
+        ASSERT(AnalyzerInformation::isUnchanged(buildDir, sourcefile, "", 1, &errors));
+        errors.clear();
+
+        // Modified header with same size
+        writeFile(header, "int y;", mtime + 2);
+        ASSERT(!AnalyzerInformation::isUnchanged(buildDir, sourcefile, "", 1, &errors));
+
+        // Modified header with other size
+        writeFile(header, "int x; ", mtime + 1);
+        ASSERT(!AnalyzerInformation::isUnchanged(buildDir, sourcefile, "", 1, &errors));
+
+        // Removed header
+        std::remove(header.c_str());
+        ASSERT(!AnalyzerInformation::isUnchanged(buildDir, sourcefile, "", 1, &errors));
+        ASSERT(errors.empty());
+
+        std::remove(sourcefile.c_str());
+        std::remove(buildDir.c_str());
+    }
+
+    void isUnchangedIncludeDirs() const {
+        const std::string buildDir("testanalyzerinformation6");
+        const std::string srcDir("testanalyzerinformation6src/");
+        const std::string incDir1("testanalyzerinformation6inc1/");
+        const std::string incDir2("testanalyzerinformation6inc2/");
+        const std::string incDir3("testanalyzerinformation6inc3/"); // does not exist
+        const std::string sourcefile(srcDir + "a.cpp");
+        const std::string header(incDir2 + "a.h");
+        createDir(buildDir);
+        createDir(srcDir);
+        createDir(incDir1);
+        createDir(incDir2);
+        const std::time_t mtime = std::time(nullptr) - 100;
+        writeFile(sourcefile, "#include \"a.h\"\n#include \"missing.h\"", mtime);
+        writeFile(header, "int x;", mtime);
+        setModificationTime(srcDir, mtime);
+        setModificationTime(incDir1, mtime);
+        setModificationTime(incDir2, mtime);
+
+        std::vector<std::string> files;
+        files.push_back(sourcefile);
+        files.push_back(header);
+        std::list<std::string> includePaths;
+        includePaths.push_back(incDir1);
+        includePaths.push_back(incDir2);
+        includePaths.push_back(incDir3);
+        std::list<ErrorLogger::ErrorMessage> errors;
+        {
+            AnalyzerInformation analyzerInformation;
+            ASSERT(analyzerInformation.analyzeFile(buildDir, sourcefile, "", 1, 1, files, includePaths, &errors));
+        }
+        ASSERT(AnalyzerInformation::isUnchanged(buildDir, sourcefile, "", 1, &errors));
+
+        // A header that shadows the included header
+        writeFile(incDir1 + "a.h", "int y;", mtime);
+        ASSERT(!AnalyzerInformation::isUnchanged(buildDir, sourcefile, "", 1, &errors));
+        std::remove((incDir1 + "a.h").c_str());
+        setModificationTime(incDir1, mtime);
+        ASSERT(AnalyzerInformation::isUnchanged(buildDir, sourcefile, "", 1, &errors));
+
+        // The missing header is added next to the source file
+        writeFile(srcDir + "missing.h", "int z;", mtime);
+        ASSERT(!AnalyzerInformation::isUnchanged(buildDir, sourcefile, "", 1, &errors));
+        std::remove((srcDir + "missing.h").c_str());
+        setModificationTime(srcDir, mtime);
+        ASSERT(AnalyzerInformation::isUnchanged(buildDir, sourcefile, "", 1, &errors));
+
+        // An include path that did not exist is created
+        createDir(incDir3);
+        ASSERT(!AnalyzerInformation::isUnchanged(buildDir, sourcefile, "", 1, &errors));
+
+        std::remove(incDir3.c_str());
+        std::remove(header.c_str());
+        std::remove(sourcefile.c_str());
+        std::remove(srcDir.c_str());
+        std::remove(incDir1.c_str());
+        std::remove(incDir2.c_str());
+        std::remove((buildDir + "/analyzerinfo.bin").c_str());
+        std::remove(buildDir.c_str());
+    }
+};
+
+REGISTER_TEST(TestAnalyzerInformation)
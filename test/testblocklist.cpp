@@ -0,0 +1,286 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2016 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "blocklist.h"
+#include "mathlib.h"
+#include "testsuite.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+class TestBlockList : public TestFixture {
+public:
+    TestBlockList() : TestFixture("TestBlockList") {
+    }
+
+private:
+
+    /** Counts the live instances, to check that all elements are destroyed */
+    class Counted {
+    public:
+        explicit Counted(int v) : value(v) {
+            ++instances;
+        }
+        Counted(const Counted &other) : value(other.value) {
+            ++instances;
+        }
+        ~Counted() {
+            --instances;
+        }
+        int value;
+        static int instances;
+    };
+
+    void run() {
+        TEST_CASE(pushPop);
+        TEST_CASE(iterate);
+        TEST_CASE(iterateReverse);
+        TEST_CASE(copy);
+        TEST_CASE(move);
+        TEST_CASE(assign);
+        TEST_CASE(pointerStability);
+        TEST_CASE(destroy);
+    }
+
+    /** The elements from begin to end, separated by commas */
+    template<class It>
+    static std::string join(It begin, It end) {
+        std::string ret;
+        for (It it = begin; it != end; ++it)
+            ret += (ret.empty() ? "" : ",") + MathLib::toString(*it);
+        return ret;
+    }
+
+    /** The numbers from first to last, separated by commas */
+    static std::string numbers(int first, int last) {
+        std::string ret;
+        for (int i = first; first <= last ? i <= last : i >= last; i += (first <= last ? 1 : -1))
+            ret += (ret.empty() ? "" : ",") + MathLib::toString(i);
+        return ret;
+    }
+
+    void pushPop() const {
+        BlockList<int> list;
+        ASSERT(list.empty());
+
+        // blocks of 4, 8 and 16 elements; fill exactly three blocks
+        for (int i = 0; i < 28; ++i) {
+            list.push_back(i);
+            ASSERT_EQUALS(i + 1, list.size());
+            ASSERT_EQUALS(0, list.front());
+            ASSERT_EQUALS(i, list.back());
+        }
+        ASSERT_EQUALS(numbers(0, 27), join(list.begin(), list.end()));
+
+        // one more element starts the fourth block
+        list.push_back(28);
+        ASSERT_EQUALS(28, list.back());
+        ASSERT_EQUALS(numbers(0, 28), join(list.begin(), list.end()));
+
+        // pop back over the block boundaries 28, 12 and 4
+        for (int i = 28; i > 0; --i) {
+            ASSERT_EQUALS(i, list.back());
+            list.pop_back();
+            ASSERT_EQUALS(i, list.size());
+            ASSERT_EQUALS(i - 1, list.back());
+        }
+        ASSERT_EQUALS("0", join(list.begin(), list.end()));
+        list.pop_back();
+        ASSERT(list.empty());
+        ASSERT(list.begin() == list.end());
+
+        // the kept blocks are reused
+        for (int i = 0; i < 13; ++i)
+            list.push_back(100 + i);
+        ASSERT_EQUALS(numbers(100, 112), join(list.begin(), list.end()));
+        list.clear();
+        ASSERT(list.empty());
+        ASSERT(list.begin() == list.end());
+    }
+
+    void iterate() const {
+        BlockList<int> list;
+        ASSERT(list.begin() == list.end());
+        ASSERT(list.cbegin() == list.cend());
+
+        for (int i = 0; i < 12; ++i) {
+            list.push_back(i);
+            ASSERT_EQUALS(numbers(0, i), join(list.begin(), list.end()));
+        }
+
+        const BlockList<int> &constList = list;
+        ASSERT_EQUALS(numbers(0, 11), join(constList.begin(), constList.end()));
+        ASSERT_EQUALS(numbers(0, 11), join(list.cbegin(), list.cend()));
+
+        // iterator to const_iterator
+        BlockList<int>::const_iterator it = list.begin();
+        ASSERT(it == list.cbegin());
+
+        // post increment/decrement and backwards over block boundaries
+        BlockList<int>::iterator it2 = list.end();
+        ASSERT_EQUALS(11, *--it2);
+        ASSERT_EQUALS(11, *it2--);
+        ASSERT_EQUALS(10, *it2);
+        for (int i = 10; i > 0; --i)
+            --it2;
+        ASSERT(it2 == list.begin());
+        ASSERT_EQUALS(0, *it2++);
+        ASSERT_EQUALS(1, *it2);
+
+        // elements can be changed through the iterator
+        for (BlockList<int>::iterator it3 = list.begin(); it3 != list.end(); ++it3)
+            *it3 *= 2;
+        ASSERT_EQUALS("0,2,4,6,8,10,12,14,16,18,20,22", join(list.begin(), list.end()));
+
+        // iterators stay valid when elements are added
+        BlockList<int>::iterator last = --list.end();
+        for (int i = 0; i < 100; ++i)
+            list.push_back(0);
+        ASSERT_EQUALS(22, *last);
+    }
+
+    void iterateReverse() const {
+        BlockList<int> list;
+        ASSERT(list.rbegin() == list.rend());
+
+        for (int i = 0; i < 60; ++i) {
+            list.push_back(i);
+            ASSERT_EQUALS(numbers(i, 0), join(list.rbegin(), list.rend()));
+        }
+
+        const BlockList<int> &constList = list;
+        ASSERT_EQUALS(numbers(59, 0), join(constList.rbegin(), constList.rend()));
+    }
+
+    void copy() const {
+        BlockList<std::string> list;
+        for (int i = 0; i < 20; ++i)
+            list.push_back(MathLib::toString(i));
+
+        BlockList<std::string> copy(list);
+        ASSERT_EQUALS(20, copy.size());
+        ASSERT_EQUALS(join(list.begin(), list.end()), join(copy.begin(), copy.end()));
+        ASSERT(&copy.front() != &list.front());
+
+        // the copies are independent
+        copy.front() = "x";
+        copy.push_back("y");
+        ASSERT_EQUALS("0", list.front());
+        ASSERT_EQUALS(20, list.size());
+        ASSERT_EQUALS("19", list.back());
+        ASSERT_EQUALS("y", copy.back());
+
+        const BlockList<std::string> empty;
+        const BlockList<std::string> emptyCopy(empty);
+        ASSERT(emptyCopy.empty());
+    }
+
+    void move() const {
+        BlockList<int> list;
+        for (int i = 0; i < 20; ++i)
+            list.push_back(i);
+        const int * const first = &list.front();
+        const int * const last = &list.back();
+
+        // the elements are not moved, only the blocks change owner
+        BlockList<int> moved(std::move(list));
+        ASSERT_EQUALS(20, moved.size());
+        ASSERT_EQUALS(numbers(0, 19), join(moved.begin(), moved.end()));
+        ASSERT_EQUALS(true, first == &moved.front());
+        ASSERT_EQUALS(true, last == &moved.back());
+        ASSERT(list.empty());
+        ASSERT(list.begin() == list.end());
+
+        // a moved from list can be used again
+        list.push_back(5);
+        ASSERT_EQUALS("5", join(list.begin(), list.end()));
+    }
+
+    void assign() const {
+        BlockList<int> a;
+        BlockList<int> b;
+        for (int i = 0; i < 10; ++i)
+            a.push_back(i);
+        for (int i = 0; i < 30; ++i)
+            b.push_back(100 + i);
+
+        b = a;
+        ASSERT_EQUALS(numbers(0, 9), join(b.begin(), b.end()));
+        ASSERT_EQUALS(numbers(0, 9), join(a.begin(), a.end()));
+
+        BlockList<int> c;
+        c.push_back(42);
+        const int * const p = &c.front();
+        a = std::move(c);
+        ASSERT_EQUALS("42", join(a.begin(), a.end()));
+        ASSERT_EQUALS(true, p == &a.front());
+
+        a.swap(b);
+        ASSERT_EQUALS(numbers(0, 9), join(a.begin(), a.end()));
+        ASSERT_EQUALS("42", join(b.begin(), b.end()));
+    }
+
+    void pointerStability() const {
+        BlockList<int> list;
+        std::vector<const int *> pointers;
+        for (int i = 0; i < 1000; ++i) {
+            list.push_back(i);
+            pointers.push_back(&list.back());
+        }
+        for (int i = 0; i < 1000; ++i)
+            ASSERT_EQUALS(i, *pointers[i]);
+
+        // the remaining elements keep their addresses when elements are removed
+        for (int i = 0; i < 500; ++i)
+            list.pop_back();
+        list.push_back(-1);
+        for (int i = 0; i < 500; ++i)
+            ASSERT_EQUALS(i, *pointers[i]);
+        ASSERT_EQUALS(true, pointers[500] == &list.back());
+
+        int i = 0;
+        for (BlockList<int>::const_iterator it = list.begin(); i < 500; ++it, ++i)
+            ASSERT_EQUALS(true, pointers[i] == &*it);
+    }
+
+    void destroy() const {
+        Counted::instances = 0;
+        {
+            BlockList<Counted> list;
+            for (int i = 0; i < 50; ++i)
+                list.push_back(Counted(i));
+            ASSERT_EQUALS(50, Counted::instances);
+            list.pop_back();
+            ASSERT_EQUALS(49, Counted::instances);
+
+            BlockList<Counted> copy(list);
+            ASSERT_EQUALS(98, Counted::instances);
+            copy.clear();
+            ASSERT_EQUALS(49, Counted::instances);
+
+            copy = list;
+            ASSERT_EQUALS(98, Counted::instances);
+        }
+        ASSERT_EQUALS(0, Counted::instances);
+    }
+};
+
+int TestBlockList::Counted::instances = 0;
+
+REGISTER_TEST(TestBlockList)
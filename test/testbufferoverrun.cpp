@@ -26,6 +26,7 @@
 
 #include <tinyxml2.h>
 #include <climits>
+#include <cstring>
 #include <list>
 #include <ostream>
 #include <string>
@@ -241,6 +242,8 @@ private:
 
         TEST_CASE(negativeMemoryAllocationSizeError) // #389
         TEST_CASE(negativeArraySize);
+
+        TEST_CASE(functionJobs);
     }
 
 
@@ -3987,6 +3990,68 @@ private:
               "int c[x?y:-1];\n");
         ASSERT_EQUALS("", errout.str());
     }
+
+    class ProgressLogger : public ErrorLogger {
+    public:
+        ProgressLogger() : progress(0) {
+        }
+        void reportOut(const std::string & /*outmsg*/) {
+        }
+        void reportErr(const ErrorLogger::ErrorMessage &msg) {
+            errors += msg.toString(false) + '\n';
+        }
+        void reportProgress(const std::string & /*filename*/, const char stage[], const std::size_t /*value*/) {
+            if (std::strcmp(stage, "Check (BufferOverrun::checkGlobalAndLocalVariable 1)") == 0)
+                ++progress;
+        }
+        std::string errors;
+        unsigned int progress;
+    };
+
+    std::string checkFunctionJobs(const char code[], unsigned int functionJobs, unsigned int *progress) {
+        Settings settings;
+        settings.addEnabled("warning");
+        settings.functionJobs = functionJobs;
+        ProgressLogger logger;
+        Tokenizer tokenizer(&settings, &logger);
+        std::istringstream istr(code);
+        tokenizer.tokenize(istr, "test.cpp");
+        CheckBufferOverrun checkBufferOverrun(&tokenizer, &settings, &logger);
+        checkBufferOverrun.checkGlobalAndLocalVariable();
+        *progress = logger.progress;
+        return logger.errors;
+    }
+
+    void functionJobs() {
+        // errors are reported in the same order when scopes are checked by several threads
+        const char code[] = "int a[10];\n"
+                            "void f1() {\n"
+                            "    a[10] = 0;\n"
+                            "}\n"
+                            "struct S {\n"
+                            "    void f2() { char b[5]; b[5] = 0; }\n"
+                            "};\n"
+                            "void f3() {\n"
+                            "    int c[2];\n"
+                            "    for (int i = 0; i < 3; i++)\n"
+                            "        c[i] = 0;\n"
+                            "}\n"
+                            "void f4() {\n"
+                            "    int d[3];\n"
+                            "    d[3] = 0;\n"
+                            "}\n";
+        unsigned int progress1 = 0, progress4 = 0;
+        const std::string expected = checkFunctionJobs(code, 1U, &progress1);
+        ASSERT_EQUALS("[test.cpp:3]: (error) Array 'a[10]' accessed at index 10, which is out of bounds.\n"
+                      "[test.cpp:6]: (error) Array 'b[5]' accessed at index 5, which is out of bounds.\n"
+                      "[test.cpp:11]: (error) Array 'c[2]' accessed at index 2, which is out of bounds.\n"
+                      "[test.cpp:15]: (error) Array 'd[3]' accessed at index 3, which is out of bounds.\n", expected);
+        ASSERT_EQUALS(checkFunctionJobs(code, 4U, &progress4), expected);
+
+        // progress is reported by the threads too
+        ASSERT_EQUALS(4U, progress1);
+        ASSERT_EQUALS(progress1, progress4);
+    }
 };
 
 REGISTER_TEST(TestBufferOverrun)
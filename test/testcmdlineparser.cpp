@@ -97,10 +97,18 @@ private:
         TEST_CASE(jobs);
         TEST_CASE(jobsMissingCount);
         TEST_CASE(jobsInvalid);
+        TEST_CASE(fileOrder);
+        TEST_CASE(fileOrderInvalid);
+        TEST_CASE(functionJobs);
+        TEST_CASE(functionJobsInvalid);
         TEST_CASE(maxConfigs);
         TEST_CASE(maxConfigsMissingCount);
         TEST_CASE(maxConfigsInvalid);
         TEST_CASE(maxConfigsTooSmall);
+        TEST_CASE(maxValueFlowValues);
+        TEST_CASE(maxValueFlowValuesInvalid);
+        TEST_CASE(maxValueFlowValuesTooSmall);
+        TEST_CASE(maxValueFlowValuesNegative);
         TEST_CASE(reportProgressTest); // "Test" suffix to avoid hiding the parent's reportProgress
         TEST_CASE(stdposix);
         TEST_CASE(stdc99);
@@ -125,6 +133,8 @@ private:
         TEST_CASE(xmlverinvalid);
         TEST_CASE(doc);
         TEST_CASE(showtime);
+        TEST_CASE(showtimeJson);
+        TEST_CASE(showtimeJsonNoFile);
         TEST_CASE(errorlist1);
         TEST_CASE(errorlistverbose1);
         TEST_CASE(errorlistverbose2);
@@ -140,6 +150,7 @@ private:
         //TEST_CASE(ignorefilepaths2);
 
         TEST_CASE(checkconfig);
+        TEST_CASE(noSimplifiedChecks);
         TEST_CASE(unknownParam);
 
         TEST_CASE(undefs_noarg);
@@ -648,6 +659,39 @@ private:
         ASSERT_EQUALS(false, defParser.ParseFromArgs(4, argv));
     }
 
+    void fileOrder() {
+        REDIRECT;
+        const char *argv[] = {"cppcheck", "--file-order=name", "file.cpp"};
+        settings.orderFilesByCost = true;
+        ASSERT(defParser.ParseFromArgs(3, argv));
+        ASSERT_EQUALS(false, settings.orderFilesByCost);
+        const char *argv2[] = {"cppcheck", "--file-order=cost", "file.cpp"};
+        ASSERT(defParser.ParseFromArgs(3, argv2));
+        ASSERT_EQUALS(true, settings.orderFilesByCost);
+    }
+
+    void fileOrderInvalid() {
+        REDIRECT;
+        const char *argv[] = {"cppcheck", "--file-order=size", "file.cpp"};
+        // Fails since there is no such order
+        ASSERT_EQUALS(false, defParser.ParseFromArgs(3, argv));
+    }
+
+    void functionJobs() {
+        REDIRECT;
+        const char *argv[] = {"cppcheck", "--function-jobs=4", "file.cpp"};
+        settings.functionJobs = 1;
+        ASSERT(defParser.ParseFromArgs(3, argv));
+        ASSERT_EQUALS(4, settings.functionJobs);
+    }
+
+    void functionJobsInvalid() {
+        REDIRECT;
+        const char *argv[] = {"cppcheck", "--function-jobs=0", "file.cpp"};
+        // Fails since at least one thread is needed
+        ASSERT_EQUALS(false, defParser.ParseFromArgs(3, argv));
+    }
+
     void maxConfigs() {
         REDIRECT;
         const char *argv[] = {"cppcheck", "-f", "--max-configs=12", "file.cpp"};
@@ -679,6 +723,37 @@ private:
         ASSERT_EQUALS(false, defParser.ParseFromArgs(3, argv));
     }
 
+    void maxValueFlowValues() {
+        REDIRECT;
+        const char *argv[] = {"cppcheck", "--max-valueflow-values=25", "file.cpp"};
+        settings.valueFlowMaxValues = 10;
+        ASSERT(defParser.ParseFromArgs(3, argv));
+        ASSERT_EQUALS(25, settings.valueFlowMaxValues);
+    }
+
+    void maxValueFlowValuesInvalid() {
+        REDIRECT;
+        const char *argv[] = {"cppcheck", "--max-valueflow-values=e", "file.cpp"};
+        // Fails since invalid count given for --max-valueflow-values=
+        ASSERT_EQUALS(false, defParser.ParseFromArgs(3, argv));
+    }
+
+    void maxValueFlowValuesTooSmall() {
+        REDIRECT;
+        const char *argv[] = {"cppcheck", "--max-valueflow-values=0", "file.cpp"};
+        // Fails since limit must be greater than 0
+        ASSERT_EQUALS(false, defParser.ParseFromArgs(3, argv));
+    }
+
+    void maxValueFlowValuesNegative() {
+        REDIRECT;
+        const char *argv[] = {"cppcheck", "--max-valueflow-values=-1", "file.cpp"};
+        settings.valueFlowMaxValues = 10;
+        // Fails since limit must be greater than 0
+        ASSERT_EQUALS(false, defParser.ParseFromArgs(3, argv));
+        ASSERT_EQUALS(10, settings.valueFlowMaxValues);
+    }
+
     void reportProgressTest() {
         REDIRECT;
         const char *argv[] = {"cppcheck", "--report-progress", "file.cpp"};
@@ -892,6 +967,25 @@ private:
         ASSERT(settings.showtime == SHOWTIME_SUMMARY);
     }
 
+    void showtimeJson() {
+        REDIRECT;
+        const char *argv[] = {"cppcheck", "--showtime=json:times.json"};
+        settings.showtime = SHOWTIME_NONE;
+        settings.showtimeFile.clear();
+        ASSERT(defParser.ParseFromArgs(2, argv));
+        ASSERT(settings.showtime == SHOWTIME_JSON);
+        ASSERT_EQUALS("times.json", settings.showtimeFile);
+    }
+
+    void showtimeJsonNoFile() {
+        REDIRECT;
+        const char *argv[] = {"cppcheck", "--showtime=json"};
+        // Fails since the JSON output is only written to a file
+        ASSERT_EQUALS(false, defParser.ParseFromArgs(2, argv));
+        const char *argv2[] = {"cppcheck", "--showtime=json:"};
+        ASSERT_EQUALS(false, defParser.ParseFromArgs(2, argv2));
+    }
+
     void errorlist1() {
         REDIRECT;
         const char *argv[] = {"cppcheck", "--errorlist"};
@@ -989,6 +1083,15 @@ private:
         ASSERT_EQUALS(true, settings.checkConfiguration);
     }
 
+    void noSimplifiedChecks() {
+        REDIRECT;
+        const char *argv[] = {"cppcheck", "--no-simplified-checks", "file.cpp"};
+        settings.simplifiedChecks = true;
+        ASSERT(defParser.ParseFromArgs(3, argv));
+        ASSERT_EQUALS(false, settings.simplifiedChecks);
+        settings.simplifiedChecks = true;
+    }
+
     void unknownParam() {
         REDIRECT;
         const char *argv[] = {"cppcheck", "--foo", "file.cpp"};
@@ -19,6 +19,8 @@
 #include "check.h"
 #include "cppcheck.h"
 #include "errorlogger.h"
+#include "mathlib.h"
+#include "settings.h"
 #include "testsuite.h"
 
 #include <algorithm>
@@ -36,12 +38,14 @@ private:
     class ErrorLogger2 : public ErrorLogger {
     public:
         std::list<std::string> id;
+        std::list<ErrorLogger::ErrorMessage> errmsgs;
 
         void reportOut(const std::string & /*outmsg*/) {
         }
 
         void reportErr(const ErrorLogger::ErrorMessage &msg) {
             id.push_back(msg._id);
+            errmsgs.push_back(msg);
         }
     };
 
@@ -49,6 +53,12 @@ private:
         TEST_CASE(instancesSorted);
         TEST_CASE(classInfoFormat);
         TEST_CASE(getErrorMessages);
+#ifdef HAVE_RULES
+        TEST_CASE(ruleLocation);
+        TEST_CASE(ruleMultipleMatches);
+        TEST_CASE(ruleEmptyMatch);
+        TEST_CASE(ruleInvalidPattern);
+#endif
     }
 
     void instancesSorted() const {
@@ -91,6 +101,56 @@ private:
         }
         ASSERT_EQUALS("", duplicate);
     }
+
+#ifdef HAVE_RULES
+    /** Check code with a rule on the normal token list, return "line:summary" of each match */
+    std::string checkRule(const char code[], const char pattern[]) const {
+        ErrorLogger2 errorLogger;
+        CppCheck cppCheck(errorLogger, true);
+        Settings::Rule rule;
+        rule.tokenlist = "normal";
+        rule.pattern = pattern;
+        rule.id = "testRule";
+        cppCheck.settings().rules.push_back(rule);
+        cppCheck.check("test.cpp", code);
+
+        std::string ret;
+        for (std::list<ErrorLogger::ErrorMessage>::const_iterator it = errorLogger.errmsgs.begin(); it != errorLogger.errmsgs.end(); ++it) {
+            if (it->_id != "testRule" && it->_id != "pcre_compile")
+                continue;
+            if (!ret.empty())
+                ret += '\n';
+            ret += (it->_callStack.empty() ? std::string("-") : MathLib::toString(it->_callStack.front().line)) + ':' + it->shortMessage();
+        }
+        return ret;
+    }
+
+    void ruleLocation() const {
+        // The match is reported at the token that contains the first matched character
+        ASSERT_EQUALS("3:found '+ z'", checkRule("void f() {\n  int x = y\n    + z;\n}", "\\+ z"));
+        ASSERT_EQUALS("3:found ' + z'", checkRule("void f() {\n  int x = y\n    + z;\n}", " \\+ z"));
+        ASSERT_EQUALS("1:found ' void f'", checkRule("void f() {\n  int x = y\n    + z;\n}", " void f"));
+        ASSERT_EQUALS("4:found '}'", checkRule("void f() {\n  int x = y\n    + z;\n}", "}$"));
+    }
+
+    void ruleMultipleMatches() const {
+        ASSERT_EQUALS("2:found 'int'\n3:found 'int'\n5:found 'int'",
+                      checkRule("void f() {\n  int x;\n  int y;\n  x = y;\n  int z;\n}", "int"));
+        // Overlapping matches are not reported
+        ASSERT_EQUALS("2:found ' a a'", checkRule("void f() {\n  x = a\n  a\n  a;\n}", " a a"));
+    }
+
+    void ruleEmptyMatch() const {
+        // An empty match is reported once
+        ASSERT_EQUALS("2:found ''", checkRule("void f() {\n  return;\n}", "(?= return)"));
+        ASSERT_EQUALS("", checkRule("void f() {\n  return;\n}", "(?= throw)"));
+    }
+
+    void ruleInvalidPattern() const {
+        const std::string result = checkRule("void f() {}", "(");
+        ASSERT_EQUALS(true, result.compare(0, 2, "-:") == 0);
+    }
+#endif
 };
 
 REGISTER_TEST(TestCppcheck)
@@ -43,6 +43,8 @@ private:
         TEST_CASE(ErrorMessageConstructLocations);
         TEST_CASE(ErrorMessageVerbose);
         TEST_CASE(ErrorMessageVerboseLocations);
+        TEST_CASE(ErrorMessageHash);
+        TEST_CASE(ErrorMessageSetUnique);
         TEST_CASE(CustomFormat);
         TEST_CASE(CustomFormat2);
         TEST_CASE(CustomFormatLocations);
@@ -153,6 +155,51 @@ private:
         ASSERT_EQUALS("[foo.cpp:5] -> [bar.cpp:8]: (error) Verbose error", msg.toString(true));
     }
 
+    void ErrorMessageHash() const {
+        std::list<ErrorLogger::ErrorMessage::FileLocation> locs;
+        locs.push_back(fooCpp5);
+        locs.push_back(barCpp8);
+        const ErrorMessage msg1(locs, emptyString, Severity::error, "Programming error.\nVerbose error", "errorId", false);
+        const ErrorMessage msg2(locs, emptyString, Severity::error, "Programming error.\nOther verbose error", "errorId", false);
+        ASSERT(msg1.hash(false) == msg2.hash(false));
+        ASSERT(msg1.hash(true) != msg2.hash(true));
+
+        const ErrorMessage msg3(locs, emptyString, Severity::error, "Programming error.\nVerbose error", "otherId", false);
+        ASSERT(msg1.hash(false) != msg3.hash(false));
+
+        const ErrorMessage msg4(locs, emptyString, Severity::error, "Programming error.\nVerbose error", "errorId", true);
+        ASSERT(msg1.hash(false) != msg4.hash(false));
+
+        locs.pop_back();
+        const ErrorMessage msg5(locs, emptyString, Severity::error, "Programming error.\nVerbose error", "errorId", false);
+        ASSERT(msg1.hash(false) != msg5.hash(false));
+    }
+
+    void ErrorMessageSetUnique() const {
+        std::list<ErrorLogger::ErrorMessage::FileLocation> locs(1, fooCpp5);
+        const ErrorMessage msg1(locs, emptyString, Severity::error, "Programming error.\nVerbose error", "errorId", false);
+        const ErrorMessage msg2(locs, emptyString, Severity::error, "Programming error.\nOther verbose error", "errorId", false);
+        const ErrorMessage msg3(locs, emptyString, Severity::error, "Programming error.\nVerbose error", "otherId", false);
+
+        ErrorMessageSet errors;
+        ASSERT_EQUALS(false, errors.contains(msg1, false));
+        ASSERT_EQUALS(true, errors.insert(msg1, false));
+        ASSERT_EQUALS(true, errors.contains(msg1, false));
+        ASSERT_EQUALS(false, errors.insert(msg1, false));
+
+        // the short messages are the same, the verbose messages differ
+        ASSERT_EQUALS(true, errors.contains(msg2, false));
+        ASSERT_EQUALS(false, errors.contains(msg2, true));
+
+        // same text, other id
+        ASSERT_EQUALS(false, errors.contains(msg3, false));
+        ASSERT_EQUALS(true, errors.insert(msg3, false));
+
+        errors.clear();
+        ASSERT_EQUALS(false, errors.contains(msg1, false));
+        ASSERT_EQUALS(false, errors.contains(msg3, false));
+    }
+
     void CustomFormat() const {
         std::list<ErrorLogger::ErrorMessage::FileLocation> locs(1, fooCpp5);
         ErrorMessage msg(locs, emptyString, Severity::error, "Programming error.\nVerbose error", "errorId", false);
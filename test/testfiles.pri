@@ -4,9 +4,11 @@ INCLUDEPATH += ../externals/tinyxml
 
 
 SOURCES += $${BASEPATH}/test64bit.cpp \
+           $${BASEPATH}/testanalyzerinformation.cpp \
            $${BASEPATH}/testassert.cpp \
            $${BASEPATH}/testastutils.cpp \
            $${BASEPATH}/testautovariables.cpp \
+           $${BASEPATH}/testblocklist.cpp \
            $${BASEPATH}/testbool.cpp \
            $${BASEPATH}/testboost.cpp \
            $${BASEPATH}/testbufferoverrun.cpp \
@@ -48,6 +50,7 @@ SOURCES += $${BASEPATH}/test64bit.cpp \
            $${BASEPATH}/testsuppressions.cpp \
            $${BASEPATH}/testsymboldatabase.cpp \
            $${BASEPATH}/testthreadexecutor.cpp \
+           $${BASEPATH}/testthreadpool.cpp \
            $${BASEPATH}/testtimer.cpp \
            $${BASEPATH}/testtoken.cpp \
            $${BASEPATH}/testtokenize.cpp \
@@ -95,12 +95,6 @@ private:
 
         CheckFunctions checkFunctions(&tokenizer, settings_, this);
         checkFunctions.runChecks(&tokenizer, settings_, this);
-
-        // Simplify...
-        tokenizer.simplifyTokenList2();
-
-        // Check...
-        checkFunctions.runSimplifiedChecks(&tokenizer, settings_, this);
     }
 
     void prohibitedFunctions_posix() {
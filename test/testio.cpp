@@ -90,12 +90,12 @@ private:
         // Check..
         CheckIO checkIO(&tokenizer, &settings, this);
         checkIO.checkWrongPrintfScanfArguments();
+        checkIO.checkCoutCerrMisusage();
+        checkIO.invalidScanf();
 
         // Simplify token list..
         tokenizer.simplifyTokenList2();
-        checkIO.checkCoutCerrMisusage();
         checkIO.checkFileUsage();
-        checkIO.invalidScanf();
     }
 
     void coutCerrMisusage() {
@@ -105,6 +105,7 @@ private:
         TEST_CASE(nullpointer_internal_error); // #5080
         TEST_CASE(ticket6505);
         TEST_CASE(subtract);
+        TEST_CASE(functionJobs);
     }
 
     void check(const char code[], bool inconclusive = false, const char filename[] = "test.cpp") {
@@ -2572,6 +2573,33 @@ private:
               "}\n");
         ASSERT_EQUALS("[test.cpp:3] -> [test.cpp:2]: (warning) Either the condition '!s' is redundant or there is overflow in pointer subtraction.\n", errout.str());
     }
+
+    void functionJobs() {
+        // errors are reported in the same order when functions are checked by several threads
+        const char code[] = "int *p = 0;\n"
+                            "int x = *p;\n"
+                            "void f1(int *a) {\n"
+                            "    *a = 0;\n"
+                            "    if (a) {}\n"
+                            "}\n"
+                            "struct S {\n"
+                            "    void f2(int *b) { *b = 0; if (!b) {} }\n"
+                            "};\n"
+                            "void f3() {\n"
+                            "    int *c = 0;\n"
+                            "    *c = 0;\n"
+                            "}\n";
+        const char expected[] = "[test.cpp:5] -> [test.cpp:4]: (warning) Either the condition 'if(a)' is redundant or there is possible null pointer dereference: a.\n"
+                                "[test.cpp:8] -> [test.cpp:8]: (warning) Either the condition '!b' is redundant or there is possible null pointer dereference: b.\n"
+                                "[test.cpp:12]: (error) Null pointer dereference: c\n";
+        check(code);
+        ASSERT_EQUALS(expected, errout.str());
+
+        settings.functionJobs = 4;
+        check(code);
+        settings.functionJobs = 1;
+        ASSERT_EQUALS(expected, errout.str());
+    }
 };
 
 REGISTER_TEST(TestNullPointer)
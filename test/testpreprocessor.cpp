@@ -26,7 +26,9 @@
 #include "testsuite.h"
 
 #include <simplecpp.h>
+#include <cstdio>
 #include <cstring>
+#include <fstream>
 #include <list>
 #include <map>
 #include <set>
@@ -246,6 +248,10 @@ private:
         TEST_CASE(testDirectiveIncludeComments);
 
         TEST_CASE(testSameLine);  // #7912
+
+        TEST_CASE(fileCache);
+        TEST_CASE(macroSnapshots);
+        TEST_CASE(hash);
     }
 
     void preprocess(const char* code, std::map<std::string, std::string>& actual, const char filename[] = "file.c") {
@@ -2370,6 +2376,100 @@ private:
         ASSERT_EQUALS(exp, preprocessor.getcode(code, "", "test.cpp"));
     }
 
+    void fileCache() {
+        const char header[] = "testpreprocessor_filecache.h";
+        {
+            std::ofstream fout(header);
+            fout << "#define A 1\nint a;\n";
+        }
+
+        simplecpp::FileCache cache;
+        std::string code1, code2;
+        for (int i = 0; i < 2; ++i) {
+            std::vector<std::string> files;
+            std::istringstream istr(std::string("#include \"") + header + "\"\nint b = A;\n");
+            const simplecpp::TokenList tokens1(istr, files, "file1.c");
+            const simplecpp::DUI dui;
+            std::map<std::string, simplecpp::TokenList*> filedata = simplecpp::load(tokens1, files, dui, nullptr, &cache);
+            ASSERT_EQUALS(1U, cache.size());
+            ASSERT_EQUALS(1U, filedata.size());
+            ASSERT_EQUALS(header, filedata.begin()->second->cfront()->location.file());
+            simplecpp::TokenList out(files);
+            simplecpp::preprocess(out, tokens1, files, filedata, dui);
+            (i == 0 ? code1 : code2) = out.stringify();
+            simplecpp::cleanup(filedata);
+        }
+        std::remove(header);
+
+        ASSERT_EQUALS(code1, code2);
+        ASSERT(code1.find("int b = 1 ;") != std::string::npos);
+    }
+
+    void macroSnapshots() {
+        const char header1[] = "testpreprocessor_snapshots1.h";
+        const char header2[] = "testpreprocessor_snapshots2.h";
+        {
+            std::ofstream fout1(header1);
+            fout1 << "#define A 1\nint a = X;\n";
+            std::ofstream fout2(header2);
+            fout2 << "#ifdef B\nint b;\n#endif\n";
+        }
+
+        std::vector<std::string> files;
+        std::istringstream istr(std::string("#include \"") + header1 + "\"\n"
+                                "int x = A + C;\n"
+                                "#include \"" + header2 + "\"\n"
+                                "int y = C;\n");
+        const simplecpp::TokenList tokens1(istr, files, "file1.c");
+        std::map<std::string, simplecpp::TokenList*> filedata = simplecpp::load(tokens1, files, simplecpp::DUI(), nullptr);
+
+        simplecpp::MacroSnapshots snapshots;
+        const char * const cfgs[] = { "", "C=2", "B", "B;C=3", "X=4", "" };
+        for (unsigned int i = 0; i < sizeof(cfgs) / sizeof(*cfgs); ++i) {
+            simplecpp::DUI dui;
+            std::istringstream cfg(cfgs[i]);
+            std::string define;
+            while (std::getline(cfg, define, ';'))
+                dui.defines.push_back(define);
+
+            simplecpp::OutputList outputList1, outputList2;
+            simplecpp::TokenList out1(files), out2(files);
+            simplecpp::preprocess(out1, tokens1, files, filedata, dui, &outputList1);
+            simplecpp::preprocess(out2, tokens1, files, filedata, dui, &outputList2, nullptr, &snapshots);
+            ASSERT_EQUALS(out1.stringify(), out2.stringify());
+            ASSERT_EQUALS(2U, snapshots.size());
+        }
+        simplecpp::cleanup(filedata);
+        std::remove(header1);
+        std::remove(header2);
+    }
+
+    unsigned long long hash(const char code[], const char cfg[]) {
+        std::vector<std::string> files;
+        std::istringstream istr(code);
+        const simplecpp::TokenList tokens1(istr, files, "test.c");
+        Preprocessor preprocessor(settings0, this);
+        return Preprocessor::calculateHash(preprocessor.preprocess(tokens1, cfg, files));
+    }
+
+    void hash() {
+        const char code[] = "#ifdef A\n"
+                            "#endif\n"
+                            "#ifdef B\n"
+                            "int b;\n"
+                            "#endif\n"
+                            "#ifdef C\n"
+                            "int c;\n"
+                            "#else\n"
+                            "\n"
+                            "int c;\n"
+                            "#endif\n"
+                            "int x = M;\n";
+        ASSERT_EQUALS(hash(code, ""), hash(code, "A"));
+        ASSERT(hash(code, "") != hash(code, "B"));
+        ASSERT(hash(code, "") != hash(code, "C")); // same tokens, different lines
+        ASSERT(hash(code, "") != hash(code, "M=1"));
+    }
 };
 
 REGISTER_TEST(TestPreprocessor)
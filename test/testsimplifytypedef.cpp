@@ -24,6 +24,10 @@
 #include "tokenize.h"
 #include "tokenlist.h"
 
+#include <set>
+#include <sstream>
+#include <string>
+
 struct InternalError;
 
 
@@ -170,6 +174,17 @@ private:
         TEST_CASE(simplifyTypedefFunction10); // #5191
 
         TEST_CASE(simplifyTypedefShadow);  // #4445 - shadow variable
+
+        TEST_CASE(simplifyTypedefBlockUses);
+        TEST_CASE(simplifyTypedefNamespaceInBlock);
+        TEST_CASE(simplifyTypedefChangedUses);
+        TEST_CASE(simplifyTypedefSkippedBlockEnd);
+
+        TEST_CASE(nameIndexNext);
+        TEST_CASE(nameIndexAddedTokens);
+        TEST_CASE(nameIndexRebuild);
+        TEST_CASE(nameIndexRenamedRemoved);
+        TEST_CASE(nameIndexAdvance);
     }
 
     std::string tok(const char code[], bool simplify = true, Settings::PlatformType type = Settings::Native, bool debugwarnings = true) {
@@ -429,13 +444,13 @@ private:
         const char expected[] =
             "union t { int a ; float b ; } ; "
             "union U { int a ; float b ; } ; "
-            "union Unnamed1 { int a ; float b ; } ; "
+            "union Unnamed0 { int a ; float b ; } ; "
             "union s s ; "
             "union s * ps ; "
             "union t t ; "
             "union t * tp ; "
             "union U u ; "
-            "union Unnamed1 * v ;";
+            "union Unnamed0 * v ;";
 
         ASSERT_EQUALS(expected, tok(code, false));
     }
@@ -591,10 +606,10 @@ private:
                                 "C c;";
 
             const char expected[] =
-                "struct Unnamed2 { } ; "
-                "struct Unnamed2 * * * * * * * * * * a ; "
-                "struct Unnamed2 * b ; "
-                "struct Unnamed2 c ;";
+                "struct Unnamed0 { } ; "
+                "struct Unnamed0 * * * * * * * * * * a ; "
+                "struct Unnamed0 * b ; "
+                "struct Unnamed0 c ;";
 
             ASSERT_EQUALS(expected, tok(code, false));
         }
@@ -3034,6 +3049,167 @@ private:
         ASSERT_EQUALS("struct xyz { int x ; } ; void f ( ) { int abc ; int xyz ; }",
                       tok(code,false));
     }
+
+    void simplifyTypedefBlockUses() {
+        // outside of classes and namespaces the search jumps from use to use
+        const char code1[] = "typedef int T;\n"
+                             "void f() { T a; { T b; } }\n"
+                             "T c;";
+        ASSERT_EQUALS("void f ( ) { int a ; { int b ; } } int c ;", simplifyTypedef(code1));
+
+        // the search ends at the end of the block
+        const char code2[] = "void f() { typedef int T; T a; { T b; } }\n"
+                             "void g() { T c; }";
+        ASSERT_EQUALS("void f ( ) { int a ; { int b ; } } void g ( ) { T c ; }", simplifyTypedef(code2));
+    }
+
+    void simplifyTypedefNamespaceInBlock() {
+        // a block that contains a namespace is searched token by token
+        const char code[] = "extern \"C++\" {\n"
+                            "typedef int T;\n"
+                            "namespace N { T x; }\n"
+                            "T y;\n"
+                            "}";
+        ASSERT_EQUALS("extern \"C++\" { namespace N { int x ; } int y ; }", simplifyTypedef(code));
+    }
+
+    void simplifyTypedefChangedUses() {
+        // tokens are added at the uses, the later uses are still found
+        const char code1[] = "typedef int *P;\n"
+                             "typedef int A[2];\n"
+                             "void f() { P p, q; A a; P r; A b = { 1, 2 }; P s; }";
+        ASSERT_EQUALS("void f ( ) { int * p , q ; int a [ 2 ] ; int * r ; int b [ 2 ] = { 1 , 2 } ; int * s ; }", simplifyTypedef(code1));
+
+        // qualifications are removed at the uses
+        const char code2[] = "struct S { typedef int T; T a; };\n"
+                             "S::T b;\n"
+                             "S::T c;";
+        ASSERT_EQUALS("struct S { int a ; } ; int b ; int c ;", simplifyTypedef(code2));
+    }
+
+    void simplifyTypedefSkippedBlockEnd() {
+        // invalid code: when a substitution skips the '}' of the block the
+        // search still ends there, later blocks are not changed
+        const char code1[] = "void f() { typedef int (*T)[2]; T } void g() { T z; }";
+        ASSERT_EQUALS("void f ( ) { int ( * } ) [ 2 ] void g ( ) { T z ; }", simplifyTypedef(code1));
+
+        const char code2[] = "void f() { typedef int T[2]; T } void g() { T z; }";
+        ASSERT_EQUALS("void f ( ) { int } [ 2 ] void g ( ) { T z ; }", simplifyTypedef(code2));
+    }
+
+    /** @return true if the tokens from tok on are numbered in increasing order */
+    static bool numberedInOrder(const Token *tok) {
+        for (; tok; tok = tok->next()) {
+            if (tok->index() == 0 || (tok->next() && tok->next()->index() <= tok->index()))
+                return false;
+        }
+        return true;
+    }
+
+    void nameIndexNext() {
+        Tokenizer tokenizer(&settings1, this);
+        std::istringstream istr("a b ; { a } a");
+        tokenizer.list.createTokens(istr);
+        tokenizer.createLinks();
+        Tokenizer::NameIndex nameIndex(tokenizer.list);
+
+        Token * const first = tokenizer.list.front();
+        Token * const start = Token::findsimplematch(first, "{");
+        ASSERT(numberedInOrder(first));
+        ASSERT(nameIndex.next("a", first, nullptr) == start->next());
+        ASSERT(nameIndex.next("a", start->next(), nullptr) == start->link()->next());
+        ASSERT(nameIndex.next("a", first, start) == nullptr);
+        ASSERT(nameIndex.next("a", first, start->link()) == start->next());
+        ASSERT(nameIndex.next("c", first, nullptr) == nullptr);
+    }
+
+    void nameIndexAddedTokens() {
+        Tokenizer tokenizer(&settings1, this);
+        std::istringstream istr("a ; b ;");
+        tokenizer.list.createTokens(istr);
+        Tokenizer::NameIndex nameIndex(tokenizer.list);
+
+        // added tokens are numbered between their neighbours
+        Token * const first = tokenizer.list.front();
+        first->insertToken("x");
+        first->next()->insertToken("b");
+        const std::set<std::string> removed;
+        nameIndex.update(first, first->tokAt(2), removed);
+        ASSERT(numberedInOrder(first));
+        ASSERT(nameIndex.next("x", first, nullptr) == first->next());
+        ASSERT(nameIndex.next("b", first, nullptr) == first->tokAt(2));
+        ASSERT(nameIndex.next("b", first->tokAt(2), nullptr) == first->tokAt(4));
+
+        // tokens right after the end are numbered too
+        first->tokAt(2)->insertToken("y");
+        first->tokAt(3)->insertToken("z");
+        nameIndex.update(first->tokAt(2), first->tokAt(2), removed);
+        ASSERT(numberedInOrder(first));
+        ASSERT(nameIndex.next("z", first, nullptr) == first->tokAt(4));
+
+        // next() numbers a start token that is not numbered
+        first->tokAt(4)->insertToken("w");
+        ASSERT(nameIndex.next("b", first->tokAt(5), nullptr) == first->tokAt(7));
+        ASSERT(numberedInOrder(first));
+    }
+
+    void nameIndexRebuild() {
+        Tokenizer tokenizer(&settings1, this);
+        std::istringstream istr("a b c");
+        tokenizer.list.createTokens(istr);
+        Tokenizer::NameIndex nameIndex(tokenizer.list);
+
+        // no room for a token between a and b, all tokens are numbered again
+        Token * const first = tokenizer.list.front();
+        unsigned int pos = 0;
+        for (Token *tok = first; tok; tok = tok->next())
+            tok->index(++pos);
+        first->insertToken("x");
+        const std::set<std::string> removed;
+        nameIndex.update(first, first->next(), removed);
+        ASSERT(numberedInOrder(first));
+        ASSERT(first->next()->index() - first->index() > 1U);
+        ASSERT(nameIndex.next("x", first, nullptr) == first->next());
+        ASSERT(nameIndex.next("c", first, nullptr) == first->tokAt(3));
+    }
+
+    void nameIndexRenamedRemoved() {
+        Tokenizer tokenizer(&settings1, this);
+        std::istringstream istr("a b a c ;");
+        tokenizer.list.createTokens(istr);
+        Tokenizer::NameIndex nameIndex(tokenizer.list);
+
+        Token * const first = tokenizer.list.front();
+        first->next()->str("d");
+        first->tokAt(2)->deleteNext();
+        std::set<std::string> removed;
+        removed.insert("c");
+        nameIndex.update(first, first->tokAt(3), removed);
+        ASSERT(nameIndex.next("b", first, nullptr) == nullptr);
+        ASSERT(nameIndex.next("d", first, nullptr) == first->next());
+        ASSERT(nameIndex.next("c", first, nullptr) == nullptr);
+        ASSERT(nameIndex.next("a", first, nullptr) == first->tokAt(2));
+    }
+
+    void nameIndexAdvance() {
+        Tokenizer tokenizer(&settings1, this);
+        std::istringstream istr("a b ; a");
+        tokenizer.list.createTokens(istr);
+        Tokenizer::NameIndex nameIndex(tokenizer.list);
+
+        Token * const first = tokenizer.list.front();
+        const std::set<std::string> removed;
+        Token *changedUse = nullptr;
+        ASSERT(nameIndex.advance("a", first, changedUse, removed, true, nullptr) == first->tokAt(3));
+        ASSERT(nameIndex.advance("a", first, changedUse, removed, false, nullptr) == first->next());
+
+        // the changed use is recorded and reset
+        first->insertToken("a");
+        changedUse = first;
+        ASSERT(nameIndex.advance("a", first->next(), changedUse, removed, true, nullptr) == first->tokAt(4));
+        ASSERT(changedUse == nullptr);
+        ASSERT(nameIndex.next("a", first, nullptr) == first->next());
+    }
 };
 
 REGISTER_TEST(TestSimplifyTypedef)
@@ -151,10 +151,12 @@ private:
         Tokenizer tokenizer(&settings, this);
         std::istringstream istr(code);
         tokenizer.tokenize(istr, "test.cpp");
-        tokenizer.simplifyTokenList2();
 
         // Check..
         CheckStl checkStl(&tokenizer, &settings, this);
+        checkStl.runChecks(&tokenizer, &settings, this);
+
+        tokenizer.simplifyTokenList2();
         checkStl.runSimplifiedChecks(&tokenizer, &settings, this);
     }
     void check(const std::string &code, const bool inconclusive=false) {
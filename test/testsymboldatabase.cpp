@@ -22,6 +22,7 @@
 #include "symboldatabase.h"
 #include "testsuite.h"
 #include "testutils.h"
+#include "timer.h"
 #include "token.h"
 #include "tokenize.h"
 #include "tokenlist.h"
@@ -81,7 +82,7 @@ private:
     }
 
     static const Scope *findFunctionScopeByToken(const SymbolDatabase * db, const Token *tok) {
-        std::list<Scope>::const_iterator scope;
+        BlockList<Scope>::const_iterator scope;
 
         for (scope = db->scopeList.begin(); scope != db->scopeList.end(); ++scope) {
             if (scope->type == Scope::eFunction) {
@@ -101,7 +102,7 @@ private:
                 currScope = currScope->nestedIn;
         }
         while (currScope) {
-            for (std::list<Function>::const_iterator i = currScope->functionList.begin(); i != currScope->functionList.end(); ++i) {
+            for (BlockList<Function>::const_iterator i = currScope->functionList.begin(); i != currScope->functionList.end(); ++i) {
                 if (i->tokenDef->str() == str)
                     return &*i;
             }
@@ -279,6 +280,7 @@ private:
         TEST_CASE(enum5);
         TEST_CASE(enum6);
         TEST_CASE(enum7);
+        TEST_CASE(enum8);
 
         TEST_CASE(sizeOfType);
 
@@ -305,6 +307,8 @@ private:
         TEST_CASE(findFunction16);
         TEST_CASE(findFunction17);
         TEST_CASE(findFunction18);
+        TEST_CASE(findFunction19);
+        TEST_CASE(findFunction20);
 
         TEST_CASE(noexceptFunction1);
         TEST_CASE(noexceptFunction2);
@@ -1256,8 +1260,8 @@ private:
 
         if (db) {
             bool seen_something = false;
-            for (std::list<Scope>::const_iterator scope = db->scopeList.begin(); scope != db->scopeList.end(); ++scope) {
-                for (std::list<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
+            for (BlockList<Scope>::const_iterator scope = db->scopeList.begin(); scope != db->scopeList.end(); ++scope) {
+                for (BlockList<Function>::const_iterator func = scope->functionList.begin(); func != scope->functionList.end(); ++func) {
                     ASSERT_EQUALS("Sub", func->token->str());
                     ASSERT_EQUALS(true, func->hasBody());
                     ASSERT_EQUALS(Function::eConstructor, func->type);
@@ -1488,10 +1492,10 @@ private:
 
         ASSERT(db && db->scopeList.size() == 1);
         if (db && db->scopeList.size() == 1) {
-            std::list<Scope>::const_iterator it = db->scopeList.begin();
+            BlockList<Scope>::const_iterator it = db->scopeList.begin();
             ASSERT(it->varlist.size() == 1);
             if (it->varlist.size() == 1) {
-                std::list<Variable>::const_iterator var = it->varlist.begin();
+                BlockList<Variable>::const_iterator var = it->varlist.begin();
                 ASSERT(var->name() == "i");
                 ASSERT(var->typeStartToken()->str() == "int");
             }
@@ -1503,10 +1507,10 @@ private:
 
         ASSERT(db && db->scopeList.size() == 1);
         if (db && db->scopeList.size() == 1) {
-            std::list<Scope>::const_iterator it = db->scopeList.begin();
+            BlockList<Scope>::const_iterator it = db->scopeList.begin();
             ASSERT(it->varlist.size() == 1);
             if (it->varlist.size() == 1) {
-                std::list<Variable>::const_iterator var = it->varlist.begin();
+                BlockList<Variable>::const_iterator var = it->varlist.begin();
                 ASSERT(var->name() == "array");
                 ASSERT(var->typeStartToken()->str() == "int");
             }
@@ -1518,10 +1522,10 @@ private:
 
         ASSERT(db && db->scopeList.size() == 1);
         if (db && db->scopeList.size() == 1) {
-            std::list<Scope>::const_iterator it = db->scopeList.begin();
+            BlockList<Scope>::const_iterator it = db->scopeList.begin();
             ASSERT(it->varlist.size() == 1);
             if (it->varlist.size() == 1) {
-                std::list<Variable>::const_iterator var = it->varlist.begin();
+                BlockList<Variable>::const_iterator var = it->varlist.begin();
                 ASSERT(var->name() == "array");
                 ASSERT(var->typeStartToken()->str() == "int");
             }
@@ -1865,7 +1869,7 @@ private:
         if (db) {
             ASSERT_EQUALS(3, db->scopeList.size());
             if (db->scopeList.size() == 3) {
-                std::list<Scope>::const_iterator scope = db->scopeList.begin();
+                BlockList<Scope>::const_iterator scope = db->scopeList.begin();
                 ++scope;
                 ASSERT_EQUALS((unsigned int)Scope::eClass, (unsigned int)scope->type);
                 ASSERT_EQUALS(1, scope->functionList.size());
@@ -1889,7 +1893,7 @@ private:
         if (db) {
             ASSERT_EQUALS(3, db->scopeList.size());
             if (db->scopeList.size() == 3) {
-                std::list<Scope>::const_iterator scope = db->scopeList.begin();
+                BlockList<Scope>::const_iterator scope = db->scopeList.begin();
                 ++scope;
                 ASSERT_EQUALS((unsigned int)Scope::eClass, (unsigned int)scope->type);
                 ASSERT_EQUALS(1, scope->functionList.size());
@@ -1974,7 +1978,7 @@ private:
 
         // Locate the scope for the class..
         const Scope *scope = nullptr;
-        for (std::list<Scope>::const_iterator it = db->scopeList.begin(); it != db->scopeList.end(); ++it) {
+        for (BlockList<Scope>::const_iterator it = db->scopeList.begin(); it != db->scopeList.end(); ++it) {
             if (it->isClassOrStruct()) {
                 scope = &(*it);
                 break;
@@ -2008,7 +2012,7 @@ private:
 
         // Locate the scope for the class..
         const Scope *scope = nullptr;
-        for (std::list<Scope>::const_iterator it = db->scopeList.begin(); it != db->scopeList.end(); ++it) {
+        for (BlockList<Scope>::const_iterator it = db->scopeList.begin(); it != db->scopeList.end(); ++it) {
             if (it->isClassOrStruct()) {
                 scope = &(*it);
                 break;
@@ -2297,7 +2301,7 @@ private:
 
         // Find the scope for the Fred struct..
         const Scope *fredScope = nullptr;
-        for (std::list<Scope>::const_iterator scope = db->scopeList.begin(); scope != db->scopeList.end(); ++scope) {
+        for (BlockList<Scope>::const_iterator scope = db->scopeList.begin(); scope != db->scopeList.end(); ++scope) {
             if (scope->isClassOrStruct() && scope->className == "Fred")
                 fredScope = &(*scope);
         }
@@ -2311,7 +2315,7 @@ private:
         // Get linenumbers where the bodies for the constructor and destructor are..
         unsigned int constructor = 0;
         unsigned int destructor = 0;
-        for (std::list<Function>::const_iterator it = fredScope->functionList.begin(); it != fredScope->functionList.end(); ++it) {
+        for (BlockList<Function>::const_iterator it = fredScope->functionList.begin(); it != fredScope->functionList.end(); ++it) {
             if (it->type == Function::eConstructor)
                 constructor = it->token->linenr();  // line number for constructor body
             if (it->type == Function::eDestructor)
@@ -2404,7 +2408,7 @@ private:
         ASSERT(db && db->typeList.size() == 5);
         if (!db || db->typeList.size() < 5)
             return;
-        std::list<Type>::const_iterator i = db->typeList.begin();
+        BlockList<Type>::const_iterator i = db->typeList.begin();
         const Type* Foo = &(*i++);
         const Type* Bar = &(*i++);
         const Type* Sub = &(*i++);
@@ -2473,7 +2477,7 @@ private:
         ASSERT(db && db->typeList.size() == 3);
         if (!db || db->typeList.size() != 3)
             return;
-        std::list<Type>::const_iterator i = db->typeList.begin();
+        BlockList<Type>::const_iterator i = db->typeList.begin();
         const Type* Fred = &(*i++);
         const Type* Wilma = &(*i++);
         const Type* Barney = &(*i++);
@@ -2567,7 +2571,7 @@ private:
             ASSERT(db->getVariableFromVarId(i) != nullptr);
 
         ASSERT_EQUALS(4U, db->scopeList.size());
-        std::list<Scope>::const_iterator scope = db->scopeList.begin();
+        BlockList<Scope>::const_iterator scope = db->scopeList.begin();
         ASSERT_EQUALS(Scope::eGlobal, scope->type);
         ++scope;
         ASSERT_EQUALS(Scope::eStruct, scope->type);
@@ -2585,7 +2589,7 @@ private:
 
         ASSERT(db != nullptr);
         ASSERT_EQUALS(4U, db->scopeList.size());
-        std::list<Scope>::const_iterator scope = db->scopeList.begin();
+        BlockList<Scope>::const_iterator scope = db->scopeList.begin();
         ASSERT_EQUALS(Scope::eGlobal, scope->type);
         ++scope;
         ASSERT_EQUALS(Scope::eStruct, scope->type);
@@ -2792,7 +2796,7 @@ private:
         if (db) {
             ASSERT(db->scopeList.size() == 4U);
             if (db->scopeList.size() == 4U) {
-                std::list<Scope>::const_iterator it = db->scopeList.begin();
+                BlockList<Scope>::const_iterator it = db->scopeList.begin();
                 ASSERT(it->type == Scope::eGlobal);
                 ASSERT((++it)->type == Scope::eFunction);
                 ASSERT((++it)->type == Scope::eIf);
@@ -2816,7 +2820,7 @@ private:
         if (db) {
             ASSERT(db->typeList.size() == 3U);
             if (db->typeList.size() == 3U) {
-                std::list<Type>::const_iterator it = db->typeList.begin();
+                BlockList<Type>::const_iterator it = db->typeList.begin();
                 const Type * classB = &(*it);
                 const Type * classC = &(*(++it));
                 const Type * classA = &(*(++it));
@@ -2881,7 +2885,7 @@ private:
         ASSERT_EQUALS(3U, db->scopeList.size());
 
         // Assert that all enum values are known
-        std::list<Scope>::const_iterator scope = db->scopeList.begin();
+        BlockList<Scope>::const_iterator scope = db->scopeList.begin();
 
         // Offsets
         ++scope;
@@ -2970,7 +2974,7 @@ private:
         ASSERT_EQUALS(2U, db->scopeList.size());
 
         // Assert that all enum values are known
-        std::list<Scope>::const_iterator scope = db->scopeList.begin();
+        BlockList<Scope>::const_iterator scope = db->scopeList.begin();
 
         ++scope;
         ASSERT_EQUALS((unsigned int)Scope::eEnum, (unsigned int)scope->type);
@@ -3089,6 +3093,19 @@ private:
         TEST(settings1.sizeof_long_long);
     }
 
+    void enum8() {
+        GET_SYMBOL_DB("enum class E : int;\n"
+                      "enum class E : int { A, B };\n");
+        ASSERT(db != nullptr);
+        if (!db)
+            return;
+        const Scope &global = db->scopeList.front();
+        ASSERT_EQUALS(1U, global.definedTypes.size());
+        const Type *type = global.findType("E");
+        ASSERT(type && type->classScope && type->classScope == global.findRecordInNestedList("E"));
+        ASSERT(global.findType("class") == nullptr);
+    }
+
     void sizeOfType() {
         // #7615 - crash in Symboldatabase::sizeOfType()
         GET_SYMBOL_DB("enum e;\n"
@@ -3224,7 +3241,7 @@ private:
                       "};");
         ASSERT(db && db->scopeList.back().functionList.size() == 4);
         if (db && db->scopeList.back().functionList.size() == 4) {
-            std::list<Function>::const_iterator it = db->scopeList.back().functionList.begin();
+            BlockList<Function>::const_iterator it = db->scopeList.back().functionList.begin();
             ASSERT((it++)->isPure());
             ASSERT((it++)->isPure());
             ASSERT(!(it++)->isPure());
@@ -3885,6 +3902,53 @@ private:
         ASSERT_EQUALS(true, f && f->function() && f->function()->tokenDef->linenr() == 3);
     }
 
+    void findFunction19() { // several calls of the same base class functions
+        GET_SYMBOL_DB("struct Base {\n"
+                      "    void f(int i);\n"
+                      "    void f(int i, int j);\n"
+                      "};\n"
+                      "struct Derived : public Base {\n"
+                      "    void a() { f(1); f(1, 2); }\n"
+                      "    void b() { f(1, 2); f(1); }\n"
+                      "};");
+
+        ASSERT_EQUALS("", errout.str());
+
+        const Token *f = Token::findsimplematch(tokenizer.tokens(), "f ( 1 ) ;");
+        ASSERT_EQUALS(true, db && f && f->function() && f->function()->tokenDef->linenr() == 2);
+
+        f = Token::findsimplematch(f->next(), "f ( 1 , 2 ) ;");
+        ASSERT_EQUALS(true, f && f->function() && f->function()->tokenDef->linenr() == 3);
+
+        f = Token::findsimplematch(f->next(), "f ( 1 , 2 ) ;");
+        ASSERT_EQUALS(true, f && f->function() && f->function()->tokenDef->linenr() == 3);
+
+        f = Token::findsimplematch(f->next(), "f ( 1 ) ;");
+        ASSERT_EQUALS(true, f && f->function() && f->function()->tokenDef->linenr() == 2);
+    }
+
+    void findFunction20() { // --showtime counts the lookups in the cache of base class functions
+        Settings settings;
+        settings.showtime = SHOWTIME_SUMMARY;
+        TimerResults timerResults;
+        Tokenizer tokenizer(&settings, this);
+        tokenizer.setTimerResults(&timerResults);
+        std::istringstream istr("struct Base {\n"
+                                "    void f(int i);\n"
+                                "    void f(int i, int j);\n"
+                                "};\n"
+                                "struct Derived : public Base {\n"
+                                "    void a() { f(1); f(1, 2); }\n"
+                                "    void b() { f(1, 2); f(1); f(2); }\n"
+                                "};");
+        tokenizer.tokenize(istr, "test.cpp");
+
+        std::ostringstream ostr;
+        timerResults.writeJson(ostr);
+        ASSERT_EQUALS(true, ostr.str().find("\"counters\": {\"Scope::findFunction base class cache hits\": 3, "
+                                            "\"Scope::findFunction base class cache misses\": 2}") != std::string::npos);
+    }
+
 #define FUNC(x) const Function *x = findFunctionByName(#x, &db->scopeList.front()); \
                 ASSERT_EQUALS(true, x != nullptr);                                  \
                 if (x) ASSERT_EQUALS(true, x->isNoExcept());
@@ -4233,7 +4297,7 @@ private:
 
         ASSERT(db && db->scopeList.size() == 3);
         if (db && db->scopeList.size() == 3) {
-            std::list<Scope>::const_iterator scope = db->scopeList.begin();
+            BlockList<Scope>::const_iterator scope = db->scopeList.begin();
             ASSERT_EQUALS(Scope::eGlobal, scope->type);
             ++scope;
             ASSERT_EQUALS(Scope::eFunction, scope->type);
@@ -4254,7 +4318,7 @@ private:
 
         ASSERT(db && db->scopeList.size() == 3);
         if (db && db->scopeList.size() == 3) {
-            std::list<Scope>::const_iterator scope = db->scopeList.begin();
+            BlockList<Scope>::const_iterator scope = db->scopeList.begin();
             ASSERT_EQUALS(Scope::eGlobal, scope->type);
             ++scope;
             ASSERT_EQUALS(Scope::eFunction, scope->type);
@@ -4286,7 +4350,7 @@ private:
 
         ASSERT(db && db->scopeList.size() == 3);
         if (db && db->scopeList.size() == 3) {
-            std::list<Scope>::const_iterator scope = db->scopeList.begin();
+            BlockList<Scope>::const_iterator scope = db->scopeList.begin();
             ASSERT_EQUALS(Scope::eGlobal, scope->type);
             ++scope;
             ASSERT_EQUALS(Scope::eClass, scope->type);
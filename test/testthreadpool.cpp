@@ -0,0 +1,135 @@
+/*
+ * Cppcheck - A tool for static C/C++ code analysis
+ * Copyright (C) 2007-2016 Cppcheck team.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "settings.h"
+#include "testsuite.h"
+#include "threadpool.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+
+class TestThreadPool : public TestFixture {
+public:
+    TestThreadPool() : TestFixture("TestThreadPool") {
+    }
+
+private:
+
+    /** Waits until the given number of threads are running it and records their ids */
+    class MeetTask : public ThreadPool::Task {
+    public:
+        explicit MeetTask(std::size_t threads) : _threads(threads), _running(0) {
+        }
+
+        void run() {
+            std::unique_lock<std::mutex> lock(_mutex);
+            ids.insert(std::this_thread::get_id());
+            if (++_running == _threads)
+                _met.notify_all();
+            while (_running < _threads)
+                _met.wait(lock);
+        }
+
+        std::set<std::thread::id> ids;
+
+    private:
+        const std::size_t _threads;
+        std::size_t _running;
+        std::mutex _mutex;
+        std::condition_variable _met;
+    };
+
+    /** Throws in the threads of the pool, after all threads are running */
+    class ThrowTask : public MeetTask {
+    public:
+        explicit ThrowTask(std::size_t threads) : MeetTask(threads), _caller(std::this_thread::get_id()) {
+        }
+
+        void run() {
+            MeetTask::run();
+            if (std::this_thread::get_id() != _caller)
+                throw std::runtime_error("part failed");
+        }
+
+    private:
+        const std::thread::id _caller;
+    };
+
+    void run() {
+        TEST_CASE(runInThreads);
+        TEST_CASE(reuseThreads);
+        TEST_CASE(oneThread);
+        TEST_CASE(rethrow);
+        TEST_CASE(sharedBySettings);
+    }
+
+    void runInThreads() const {
+        ThreadPool pool;
+        MeetTask task(4);
+        pool.run(task, 4);
+        ASSERT_EQUALS(4U, task.ids.size());
+        ASSERT(task.ids.count(std::this_thread::get_id()) == 1U);
+        ASSERT_EQUALS(3U, pool.size());
+    }
+
+    void reuseThreads() const {
+        ThreadPool pool;
+        MeetTask task1(3);
+        pool.run(task1, 3);
+        MeetTask task2(3);
+        pool.run(task2, 3);
+        ASSERT_EQUALS(2U, pool.size());
+        ASSERT(task1.ids == task2.ids);
+
+        // more threads are started when they are needed
+        MeetTask task3(4);
+        pool.run(task3, 4);
+        ASSERT_EQUALS(3U, pool.size());
+    }
+
+    void oneThread() const {
+        ThreadPool pool;
+        MeetTask task(1);
+        pool.run(task, 1);
+        ASSERT_EQUALS(0U, pool.size());
+        ASSERT(task.ids.count(std::this_thread::get_id()) == 1U);
+    }
+
+    void rethrow() const {
+        ThreadPool pool;
+        ThrowTask task(2);
+        ASSERT_THROW(pool.run(task, 2), std::runtime_error);
+
+        // the pool can still be used
+        MeetTask task2(2);
+        pool.run(task2, 2);
+        ASSERT_EQUALS(2U, task2.ids.size());
+    }
+
+    void sharedBySettings() const {
+        Settings settings1;
+        const Settings settings2(settings1);
+        ASSERT(settings1.functionJobThreads.get() != nullptr);
+        ASSERT(settings1.functionJobThreads == settings2.functionJobThreads);
+    }
+};
+
+REGISTER_TEST(TestThreadPool)
@@ -20,7 +20,7 @@
 #include "timer.h"
 
 #include <cmath>
-#include <ctime>
+#include <sstream>
 
 class TestTimer : public TestFixture {
 public:
@@ -31,16 +31,54 @@ private:
 
     void run() {
         TEST_CASE(result);
+        TEST_CASE(nested);
+        TEST_CASE(json);
     }
 
     void result() const {
         TimerResultsData t1;
-        t1._clocks = ~(std::clock_t)0;
-        ASSERT(t1.seconds() > 100.0);
-
-        t1._clocks = CLOCKS_PER_SEC * 5 / 2;
+        t1._cpuSeconds = 2.5;
+        t1._wallSeconds = 3.0;
         ASSERT(std::fabs(t1.seconds()-2.5) < 0.01);
     }
+
+    void nested() const {
+        TimerResults results;
+        {
+            Timer t1("outer", SHOWTIME_SUMMARY, &results);
+            {
+                // Uses the results of the enclosing timer
+                Timer t2("inner", SHOWTIME_SUMMARY);
+            }
+            Timer t3("inner", SHOWTIME_SUMMARY);
+        }
+        Timer t4("inner", SHOWTIME_SUMMARY, &results);
+        t4.Stop();
+
+        std::ostringstream ostr;
+        results.writeJson(ostr);
+        const std::string json = ostr.str();
+        ASSERT(json.find("{\"name\": \"outer\", \"calls\": 1,") != std::string::npos);
+        ASSERT(json.find("{\"name\": \"inner\", \"calls\": 2,") != std::string::npos);
+        ASSERT(json.find("{\"name\": \"inner\", \"calls\": 1,") != std::string::npos);
+    }
+
+    void json() const {
+        TimerResults results;
+        results.AddResults("a", 2.0, 1.0);
+        results.AddResults("a/b", 1.0, 0.5);
+        results.AddResults("a/b", 1.0, 0.5);
+        results.AddCount("c");
+        results.AddCount("c", 2);
+        std::ostringstream ostr;
+        results.writeJson(ostr);
+        ASSERT_EQUALS("{\"timers\": [\n"
+                      "  {\"name\": \"a\", \"calls\": 1, \"wall\": 2, \"cpu\": 1, \"children\": [\n"
+                      "    {\"name\": \"b\", \"calls\": 2, \"wall\": 2, \"cpu\": 1}\n"
+                      "  ]}\n"
+                      "],\n"
+                      " \"counters\": {\"c\": 3}}\n", ostr.str());
+    }
 };
 
 REGISTER_TEST(TestTimer)
@@ -23,6 +23,7 @@
 #include "tokenize.h"
 #include "tokenlist.h"
 
+#include <cstring>
 #include <string>
 #include <vector>
 
@@ -72,6 +73,7 @@ private:
         TEST_CASE(matchOr);
         TEST_CASE(matchOp);
         TEST_CASE(matchConstOp);
+        TEST_CASE(matchCompiled);
 
         TEST_CASE(isArithmeticalOp);
         TEST_CASE(isOp);
@@ -98,6 +100,8 @@ private:
         TEST_CASE(canFindMatchingBracketsWithTooManyOpening);
 
         TEST_CASE(expressionString);
+
+        TEST_CASE(addValue);
     }
 
     void nextprevious() const {
@@ -313,12 +317,12 @@ private:
 
 
     void deleteLast() const {
-        Token *tokensBack = 0;
-        Token tok(&tokensBack);
+        TokenListState state(nullptr, nullptr);
+        Token tok(&state);
         tok.insertToken("aba");
-        ASSERT_EQUALS(true, tokensBack == tok.next());
+        ASSERT_EQUALS(true, state.back == tok.next());
         tok.deleteNext();
-        ASSERT_EQUALS(true, tokensBack == &tok);
+        ASSERT_EQUALS(true, state.back == &tok);
     }
 
     void nextArgument() const {
@@ -636,6 +640,60 @@ private:
     }
 
 
+    void matchCompiled() {
+        const char code[] = "int x = 1 | 2 || y; void g() { if (x == 'a' && !b) { f(\"abc\", x++, true); } else { x %= 3 % 4; } int a[2]; a[1] = 0; }";
+        static const char * const patterns[] = {
+            "int", "int|char", "int|char|", "|int", "int||char", "%name%", "%name%|", "%var%|%num%|)",
+            "%type% %var% =", "%varid%", "%num%|%varid%", "%any% %any%", "%assign%", "%bool%", "%char%",
+            "%comp%", "%cop%", "%op%", "%or%", "%oror%", "%str%", "%", "%|x", "[;{}]", "[]]", "[]|(]",
+            "[(]", "!!else", "!!else ;", "!! ;", "!!", "if|while ( %var%", "} else {", "( !!)", "x =|+=",
+            "; ;", "%name% (|[", "a%b"
+        };
+
+        static const Settings settings;
+        Tokenizer tokenizer(&settings, this);
+        std::istringstream istr(code);
+        tokenizer.tokenize(istr, "test.cpp");
+
+        for (std::size_t i = 0; i < sizeof(patterns) / sizeof(patterns[0]); ++i) {
+            const MatchPattern compiled(patterns[i]);
+            const unsigned int varid = std::strstr(patterns[i], "%varid%") ? 1U : 0U;
+            for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next())
+                ASSERT_EQUALS_MSG(Token::interpretedMatch(tok, patterns[i], varid), compiled.match(tok, varid), patterns[i] + (" at " + tok->str()));
+            ASSERT_EQUALS_MSG(Token::interpretedMatch(nullptr, patterns[i], varid), compiled.match(nullptr, varid), patterns[i]);
+        }
+
+        // Literal patterns are compiled
+        const Token *tok = tokenizer.tokens();
+        ASSERT_EQUALS(true, Token::Match(tok, "%type% %var% ; %var% = %num% %oror%"));
+        ASSERT_EQUALS(true, Token::Match(tok, "int|char|"));
+        ASSERT_EQUALS(false, Token::Match(tok, "[;{}]"));
+        ASSERT_EQUALS(true, Token::Match(tok, "int %varid%", 1U));
+        ASSERT_THROW(Token::Match(tok->next(), "%varid%"), InternalError);
+
+        // Static const arrays are compiled
+        static const char staticPattern[] = "int %name% ;";
+        ASSERT_EQUALS(true, Token::Match(tok, staticPattern));
+        ASSERT_EQUALS(false, Token::Match(tok->next(), staticPattern));
+
+        // Arrays and pointers that are reused for other patterns are interpreted
+        char buf[16];
+        const char *constPattern = buf;
+        std::strcpy(buf, "int %name%");
+        ASSERT_EQUALS(true, Token::Match(tok, buf));
+        ASSERT_EQUALS(true, Token::Match(tok, constPattern));
+        std::strcpy(buf, "char %name%");
+        ASSERT_EQUALS(false, Token::Match(tok, buf));
+        ASSERT_EQUALS(false, Token::Match(tok, constPattern));
+        std::strcpy(buf, "int|char");
+        ASSERT_EQUALS(true, Token::Match(tok, constPattern));
+
+        // Empty token
+        Token empty(0);
+        ASSERT_EQUALS(Token::interpretedMatch(&empty, "int|"), MatchPattern("int|").match(&empty));
+        ASSERT_EQUALS(Token::interpretedMatch(&empty, "int|%name%"), MatchPattern("int|%name%").match(&empty));
+    }
+
     void isArithmeticalOp() const {
         std::vector<std::string>::const_iterator test_op, test_ops_end = arithmeticalOps.end();
         for (test_op = arithmeticalOps.begin(); test_op != test_ops_end; ++test_op) {
@@ -957,6 +1015,35 @@ private:
         const Token *tok2 = Token::findsimplematch(var2.tokens(), "*");
         ASSERT_EQUALS("*((unsigned long long*)x)", tok2->expressionString());
     }
+
+    void addValue() const {
+        Token tok(0);
+        ASSERT_EQUALS(true, tok.values().empty());
+
+        // more values than are stored in the token value list itself
+        for (int i = 0; i < 5; ++i)
+            ASSERT_EQUALS(true, tok.addValue(ValueFlow::Value(i), 5U));
+        ASSERT_EQUALS(5U, tok.values().size());
+        int i = 0;
+        for (ValueFlow::TokenValues::const_iterator it = tok.values().begin(); it != tok.values().end(); ++it)
+            ASSERT_EQUALS(i++, it->intvalue);
+
+        // same value is not added again
+        ASSERT_EQUALS(false, tok.addValue(ValueFlow::Value(3), 10U));
+
+        // cap
+        ASSERT_EQUALS(false, tok.addValue(ValueFlow::Value(5), 5U));
+        ASSERT_EQUALS(true, tok.addValue(ValueFlow::Value(5), 6U));
+        ASSERT_EQUALS(6U, tok.values().size());
+
+        // known value replaces all other values
+        ValueFlow::Value known(7);
+        known.setKnown();
+        ASSERT_EQUALS(true, tok.addValue(known, 6U));
+        ASSERT_EQUALS(1U, tok.values().size());
+        ASSERT_EQUALS(7, tok.values().front().intvalue);
+        ASSERT_EQUALS(true, tok.hasKnownIntValue());
+    }
 };
 
 REGISTER_TEST(TestToken)
@@ -19,6 +19,7 @@
 #include "settings.h"
 #include "testsuite.h"
 #include "token.h"
+#include "tokenarena.h"
 #include "tokenlist.h"
 
 #include <sstream>
@@ -36,6 +37,9 @@ private:
         TEST_CASE(testaddtoken1);
         TEST_CASE(testaddtoken2);
         TEST_CASE(inc);
+        TEST_CASE(arena);
+        TEST_CASE(internedStrings);
+        TEST_CASE(checksum);
     }
 
     // inspired by #5895
@@ -73,6 +77,87 @@ private:
 
         ASSERT(Token::simpleMatch(tokenlist.front(), "a + + 1 ; 1 + + b ;"));
     }
+
+    void arena() const {
+        TokenArena arena;
+        void *p1 = TokenArena::allocate(&arena, 40);
+        void *p2 = TokenArena::allocate(&arena, 40);
+        ASSERT(p1 != p2);
+        ASSERT_EQUALS(2U, arena.usedBlocks());
+
+        // released blocks are reused
+        TokenArena::deallocate(p1, 40);
+        ASSERT_EQUALS(1U, arena.usedBlocks());
+        ASSERT(p1 == TokenArena::allocate(&arena, 40));
+
+        // large blocks and blocks without arena are taken from the heap
+        void *p3 = TokenArena::allocate(&arena, 4096);
+        void *p4 = TokenArena::allocate(nullptr, 40);
+        ASSERT_EQUALS(2U, arena.usedBlocks());
+        TokenArena::deallocate(p3, 4096);
+        TokenArena::deallocate(p4, 40);
+
+        // tokens and their data are released to the arena
+        TokenListState state(nullptr, &arena);
+        Token *tok = new (&arena) Token(&state);
+        tok->originalName("x");
+        ASSERT_EQUALS(4U, arena.usedBlocks());
+        delete tok;
+        ASSERT_EQUALS(2U, arena.usedBlocks());
+
+        TokenArena::deallocate(p1, 40);
+        TokenArena::deallocate(p2, 40);
+        ASSERT_EQUALS(0U, arena.usedBlocks());
+    }
+
+    void internedStrings() const {
+        TokenList tokenlist(&settings);
+        std::istringstream istr("a = b + a ; b = c ;");
+        tokenlist.createTokens(istr, "a.cpp");
+        const Token *a1 = tokenlist.front();
+        const Token *a2 = a1->tokAt(4);
+        const Token *b1 = a1->tokAt(2);
+        const Token *b2 = a1->tokAt(6);
+
+        // equal texts are stored once
+        ASSERT(&a1->str() == &a2->str());
+        ASSERT(&b1->str() == &b2->str());
+        ASSERT_EQUALS(true, a1->strEquals(a2));
+        ASSERT_EQUALS(false, a1->strEquals(b1));
+
+        // changing the text of a token does not change other tokens
+        Token *c = const_cast<Token *>(a1->tokAt(8));
+        c->str("a");
+        ASSERT(&c->str() == &a1->str());
+        const_cast<Token *>(a2)->str("d");
+        ASSERT_EQUALS("a", a1->str());
+        ASSERT_EQUALS(false, a1->strEquals(a2));
+
+        // tokens of other lists are compared by text
+        TokenList tokenlist2(&settings);
+        std::istringstream istr2("a");
+        tokenlist2.createTokens(istr2, "a.cpp");
+        ASSERT(&tokenlist2.front()->str() != &a1->str());
+        ASSERT_EQUALS(true, tokenlist2.front()->strEquals(a1));
+        Token tok(nullptr);
+        tok.str("a");
+        ASSERT_EQUALS(true, tok.strEquals(a1));
+        ASSERT_EQUALS(true, a1->strEquals(&tok));
+    }
+
+    unsigned long long checksum(const char code[]) const {
+        TokenList tokenlist(&settings);
+        std::istringstream istr(code);
+        tokenlist.createTokens(istr, "a.cpp");
+        return tokenlist.calculateChecksum();
+    }
+
+    void checksum() const {
+        ASSERT_EQUALS(checksum("int ab ;"), checksum("int ab ;"));
+        ASSERT(checksum("int ab ;") != checksum("int ba ;"));
+        ASSERT(checksum("int a b ;") != checksum("int ab ;"));
+        ASSERT(checksum("a = b ;") != checksum("b = a ;"));
+    }
 };
 
 REGISTER_TEST(TestTokenList)
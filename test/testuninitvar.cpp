@@ -84,6 +84,8 @@ private:
 
         // dead pointer
         TEST_CASE(deadPointer);
+
+        TEST_CASE(functionJobs);
     }
 
     void checkUninitVar(const char code[], const char fname[] = "test.cpp", bool debugwarnings = false) {
@@ -3927,6 +3929,37 @@ private:
                          "}");
         ASSERT_EQUALS("", errout.str());
     }
+
+    void functionJobs() {
+        // errors are reported in the same order when functions are checked by several threads
+        const char code[] = "int g;\n"
+                            "void f1() {\n"
+                            "    int a;\n"
+                            "    g = a;\n"
+                            "}\n"
+                            "struct S {\n"
+                            "    void f2() { int b; g = b; }\n"
+                            "};\n"
+                            "void f3() {\n"
+                            "    int c[10];\n"
+                            "    g = c[0];\n"
+                            "}\n"
+                            "void f4(int x) {\n"
+                            "    int d;\n"
+                            "    if (x) d = 1;\n"
+                            "    g = d;\n"
+                            "}\n";
+        checkUninitVar(code);
+        const std::string expected = errout.str();
+        ASSERT_EQUALS("[test.cpp:4]: (error) Uninitialized variable: a\n"
+                      "[test.cpp:7]: (error) Uninitialized variable: b\n"
+                      "[test.cpp:16]: (error) Uninitialized variable: d\n", expected);
+
+        settings.functionJobs = 4;
+        checkUninitVar(code);
+        settings.functionJobs = 1;
+        ASSERT_EQUALS(expected, errout.str());
+    }
 };
 
 REGISTER_TEST(TestUninitVar)
@@ -75,6 +75,7 @@ private:
         TEST_CASE(valueFlowBeforeConditionTernaryOp);
 
         TEST_CASE(valueFlowAfterAssign);
+        TEST_CASE(valueFlowAfterAssignLastUsage);
 
         TEST_CASE(valueFlowAfterCondition);
 
@@ -105,7 +106,7 @@ private:
 
         for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
             if (tok->str() == "x" && tok->linenr() == linenr) {
-                std::list<ValueFlow::Value>::const_iterator it;
+                ValueFlow::TokenValues::const_iterator it;
                 for (it = tok->values().begin(); it != tok->values().end(); ++it) {
                     if (it->isIntValue() && it->intvalue == value)
                         return true;
@@ -127,12 +128,11 @@ private:
                 continue;
 
             std::ostringstream ostr;
-            std::list<ValueFlow::Value>::const_iterator it;
+            ValueFlow::TokenValues::const_iterator it;
             for (it = tok->values().begin(); it != tok->values().end(); ++it) {
                 for (ValueFlow::Value::ErrorPath::const_iterator ep = it->errorPath.begin(); ep != it->errorPath.end(); ++ep) {
-                    const Token *eptok = ep->first;
-                    const std::string &msg = ep->second;
-                    ostr << eptok->linenr() << ',' << msg << '\n';
+                    const Token *eptok = ep->tok;
+                    ostr << eptok->linenr() << ',' << ep->str() << '\n';
                 }
             }
             return ostr.str();
@@ -149,7 +149,7 @@ private:
 
         for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
             if (tok->str() == "x" && tok->linenr() == linenr) {
-                std::list<ValueFlow::Value>::const_iterator it;
+                ValueFlow::TokenValues::const_iterator it;
                 for (it = tok->values().begin(); it != tok->values().end(); ++it) {
                     if (it->isTokValue() && Token::simpleMatch(it->tokvalue, value))
                         return true;
@@ -168,7 +168,7 @@ private:
 
         for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
             if (tok->str() == "x" && tok->linenr() == linenr) {
-                std::list<ValueFlow::Value>::const_iterator it;
+                ValueFlow::TokenValues::const_iterator it;
                 for (it = tok->values().begin(); it != tok->values().end(); ++it) {
                     if (it->isMovedValue() && it->moveKind == moveKind)
                         return true;
@@ -187,7 +187,7 @@ private:
 
         for (const Token *tok = tokenizer.tokens(); tok; tok = tok->next()) {
             if (tok->str() == "x" && tok->linenr() == linenr) {
-                std::list<ValueFlow::Value>::const_iterator it;
+                ValueFlow::TokenValues::const_iterator it;
                 for (it = tok->values().begin(); it != tok->values().end(); ++it) {
                     if (it->isIntValue() && it->intvalue == value && it->condition)
                         return true;
@@ -225,7 +225,7 @@ private:
         errout.str("");
         tokenizer.tokenize(istr, "test.cpp");
         const Token *tok = Token::findmatch(tokenizer.tokens(), tokstr);
-        return tok ? tok->values() : std::list<ValueFlow::Value>();
+        return tok ? std::list<ValueFlow::Value>(tok->values().begin(), tok->values().end()) : std::list<ValueFlow::Value>();
     }
 
     ValueFlow::Value valueOfTok(const char code[], const char tokstr[]) {
@@ -1516,6 +1516,81 @@ private:
         TODO_ASSERT_EQUALS(true, false, testValueOfX(code, 6U, 2));
     }
 
+    void valueFlowAfterAssignLastUsage() {
+        // The forward analysis stops after the last usage of the variable
+        const char *code;
+
+        code = "void f() {\n"
+               "    int x = 3;\n"
+               "    int a = 0;\n"
+               "    for (int i = 0; i < 10; i++) {\n"
+               "        for (int j = 0; j < 10; j++) {\n"
+               "            a += x;\n"
+               "        }\n"
+               "    }\n"
+               "    a++;\n"
+               "    return a;\n"
+               "}";
+        ASSERT_EQUALS(true, testValueOfX(code, 6U, 3));
+
+        code = "void f(int a) {\n"
+               "    int x = 3;\n"
+               "    while (a > 0) {\n"
+               "        for (int j = 0; j < 10; j++) {\n"
+               "            if (j == 5)\n"
+               "                a = x;\n"
+               "        }\n"
+               "        a--;\n"
+               "    }\n"
+               "    return a;\n"
+               "}";
+        ASSERT_EQUALS(true, testValueOfX(code, 6U, 3));
+
+        code = "int f(int a) {\n"
+               "    int x = 3;\n"
+               "    if (a) {\n"
+               "        a = 1;\n"
+               "    } else {\n"
+               "        a = x;\n"
+               "    }\n"
+               "    a++;\n"
+               "    return a;\n"
+               "}";
+        ASSERT_EQUALS(true, testValueOfX(code, 6U, 3));
+
+        code = "int f(int a) {\n"
+               "    int x = 3;\n"
+               "    if (a) {\n"
+               "        x = 1;\n"
+               "    } else {\n"
+               "        a = x;\n"
+               "    }\n"
+               "    a++;\n"
+               "    return a;\n"
+               "}";
+        // bailout: x is assigned in conditional code
+        ASSERT_EQUALS(false, testValueOfX(code, 6U, 3));
+        ASSERT_EQUALS(false, testValueOfX(code, 6U, 1));
+
+        code = "int f() {\n"
+               "    int x = 3;\n"
+               "    int a = 0;\n"
+               "    auto g = [&]() { return x + 1; };\n"
+               "    a = g();\n"
+               "    return a;\n"
+               "}";
+        ASSERT_EQUALS(true, testValueOfX(code, 4U, 3));
+
+        // bailout: return in the lambda body
+        code = "int f() {\n"
+               "    int x = 3;\n"
+               "    auto g = [&](int y) { return y + 1; };\n"
+               "    int a = g(x);\n"
+               "    return a;\n"
+               "}";
+        ASSERT_EQUALS(false, testValueOfX(code, 4U, 3));
+    }
+
     void valueFlowAfterCondition() {
         const char *code;
 
@@ -176,6 +176,8 @@ private:
         TEST_CASE(varid_classnameshaddowsvariablename); // #3990
 
         TEST_CASE(varidnamespace1);
+
+        TEST_CASE(variableMap);
     }
 
     std::string tokenize(const char code[], bool simplify = false, const char filename[] = "test.cpp") {
@@ -2769,6 +2771,30 @@ private:
 
         ASSERT_EQUALS(expected, tokenize(code));
     }
+
+    void variableMap() const {
+        VariableMap variables;
+        variables.addVariable("a", 1);
+        variables.enterScope();
+        variables.addVariable("a", 2);
+        variables.addVariable("b", 3);
+        variables.enterScope();
+        variables.addVariable("b", 4);
+        ASSERT_EQUALS(2U, variables.varId("a"));
+        ASSERT_EQUALS(4U, variables.varId("b"));
+
+        ASSERT_EQUALS(true, variables.leaveScope());
+        ASSERT_EQUALS(3U, variables.varId("b"));
+        ASSERT_EQUALS(true, variables.leaveScope());
+        ASSERT_EQUALS(1U, variables.varId("a"));
+        ASSERT_EQUALS(false, variables.hasVariable("b"));
+        ASSERT_EQUALS(0U, variables.varId("b"));
+
+        ASSERT_EQUALS(false, variables.leaveScope());
+        ASSERT_EQUALS(true, variables.hasVariable("a"));
+        variables.clear();
+        ASSERT_EQUALS(false, variables.hasVariable("a"));
+    }
 };
 
 REGISTER_TEST(TestVarID)
@@ -316,12 +316,12 @@ int main(int argc, char **argv)
     }
 
     fout << "ifeq (g++, $(findstring g++,$(CXX)))\n"
-         << "    override CXXFLAGS += -std=c++0x\n"
+         << "    override CXXFLAGS += -std=c++0x -pthread\n"
          << "else ifeq (clang++, $(findstring clang++,$(CXX)))\n"
-         << "    override CXXFLAGS += -std=c++0x\n"
+         << "    override CXXFLAGS += -std=c++0x -pthread\n"
          << "else ifeq ($(CXX), c++)\n"
          << "    ifeq ($(shell uname -s), Darwin)\n"
-         << "        override CXXFLAGS += -std=c++0x\n"
+         << "        override CXXFLAGS += -std=c++0x -pthread\n"
          << "    endif\n"
          << "endif\n"
          << "\n";